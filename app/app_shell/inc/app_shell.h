@@ -7,8 +7,17 @@ typedef enum
     E_APP_SHELL_RET_STATUS_ERROR,
 } E_APP_SHELL_RET_STATUS_T;
 
+/* Shell sessions, each one has its own transport, parser, history and user but shares the command table */
+typedef enum
+{
+    E_APP_SHELL_SESSION_ID_SERIALPORT,
+    E_APP_SHELL_SESSION_ID_NUM_MAX,
+} E_APP_SHELL_SESSION_ID_T;
+
 extern E_APP_SHELL_RET_STATUS_T app_shell_init(void);
 
+/* Thread argument is the session ID, such as (void*)E_APP_SHELL_SESSION_ID_SERIALPORT */
 extern void app_shell_thread(void* argument);
+extern void app_shell_worker_thread(void* argument);
 
-#endif
\ No newline at end of file
+#endif
@@ -14,5 +14,6 @@
 
 extern short app_shell_port_write(char *data, unsigned short len);
 extern short app_shell_port_read(char *data, unsigned short len);
+extern short app_shell_port_write_space(void);
 
 #endif
\ No newline at end of file
@@ -5,12 +5,27 @@
 #include "osal.h"
 
 
+/* Shell output is flushed in large chunks, wait for TX ringbuffer space instead of dropping them */
+#define D_APP_SHELL_PORT_TX_RETRY_MAX       (50)
+#define D_APP_SHELL_PORT_TX_RETRY_DELAY_MS  (1)
+
+
 extern short app_shell_port_write(char *data, unsigned short len)
 {
     E_SERIALPORT_ADAPTER_RET_STATUS_T ret_status_serialport = E_SERIALPORT_ADAPTER_RET_STATUS_OK;
     
     uint16_t write_len = len;
+    uint16_t retry_count = 0;
+
     ret_status_serialport = serialport_adapter_transmit( (uint8_t*)data, write_len);
+    while (E_SERIALPORT_ADAPTER_RET_STATUS_TX_OVERFLOW == ret_status_serialport && D_APP_SHELL_PORT_TX_RETRY_MAX > retry_count)
+    {
+        osal_delay_ms(D_APP_SHELL_PORT_TX_RETRY_DELAY_MS);
+        retry_count++;
+
+        ret_status_serialport = serialport_adapter_transmit( (uint8_t*)data, write_len);
+    }
+
     if (E_SERIALPORT_ADAPTER_RET_STATUS_OK != ret_status_serialport)
     {
         return 0;
@@ -19,6 +34,19 @@ extern short app_shell_port_write(char *data, unsigned short len)
     return write_len;
 }
 
+extern short app_shell_port_write_space(void)
+{
+    uint16_t free_size = 0;
+
+    if (E_SERIALPORT_ADAPTER_RET_STATUS_OK != serialport_adapter_tx_free_size_get(&free_size) )
+    {
+        return 0;
+    }
+
+    /* Clamp to the range of short */
+    return (free_size > 0x7FFF) ? 0x7FFF : (short)free_size;
+}
+
 extern short app_shell_port_read(char *data, unsigned short len)
 {
     E_SERIALPORT_ADAPTER_RET_STATUS_T ret_status_serialport = E_SERIALPORT_ADAPTER_RET_STATUS_OK;
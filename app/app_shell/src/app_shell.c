@@ -5,45 +5,213 @@
 #include "log.h"
 
 #include "osal.h"
+#include "tracer.h"
+#include "bsp_led_adapter.h"
 
 #include "stddef.h"
+#include "string.h"
 
+/* Commands run on the worker thread, Ctrl-C and the pending input replay rely on it */
+#if SHELL_ASYNC_EXEC != 1
+#error "app_shell needs SHELL_ASYNC_EXEC == 1 in shell_cfg_user.h"
+#endif
 
+
+/* Fixed memory budget of each session */
 #define D_APP_SHELL_PARSER_BUFFER_SIZE  (256)
+#define D_APP_SHELL_RX_READ_BUFFER_SIZE (64)
+#define D_APP_SHELL_RX_PENDING_BUFFER_SIZE (256)
+
+#define D_APP_SHELL_KEY_CANCEL          (0x03)  /* Ctrl-C */
+
+/* Command table shared by sessions, the letter shell table followed by the app commands */
+#define D_APP_SHELL_CMD_TABLE_SIZE      (48)
+
+/* Longest line of tracer dump */
+#define D_APP_SHELL_TRACE_LINE_SIZE     (64)
+
+typedef struct
+{
+    short (*pf_write)(char*, unsigned short);
+    short (*pf_read)(char*, unsigned short);
+    short (*pf_write_space)(void);
+    uint8_t is_log_output;  /* Only one session can be the output of shell log */
+} S_APP_SHELL_SESSION_CONFIG_T;
 
 typedef struct 
 {
     Shell       shell_handle;
-    Log         shell_log_handle;
     void*       shell_tx_os_mutex;
-    uint8_t*    p_shell_rx_parser_buf;
-} APP_SHELL_T;
+    void*       shell_rx_os_mutex;
+    void*       shell_exec_os_semaphore;
+    uint16_t    shell_rx_pending_size;
+    uint8_t     shell_rx_parser_buf[D_APP_SHELL_PARSER_BUFFER_SIZE];
+    uint8_t     shell_rx_read_buf[D_APP_SHELL_RX_READ_BUFFER_SIZE];
+    uint8_t     shell_rx_pending_buf[D_APP_SHELL_RX_PENDING_BUFFER_SIZE];
+} S_APP_SHELL_SESSION_T;
 
-static uint8_t gs_app_shell_rx_parser_buf[D_APP_SHELL_PARSER_BUFFER_SIZE];
+static const S_APP_SHELL_SESSION_CONFIG_T gs_app_shell_session_conf[E_APP_SHELL_SESSION_ID_NUM_MAX] =
+{
+    [E_APP_SHELL_SESSION_ID_SERIALPORT] =
+    {
+        .pf_write       = app_shell_port_write,
+        .pf_read        = app_shell_port_read,
+        .pf_write_space = app_shell_port_write_space,
+        .is_log_output  = 1,
+    },
+};
 
-static APP_SHELL_T gs_app_shell_handle = {0};
+static S_APP_SHELL_SESSION_T gs_app_shell_session[E_APP_SHELL_SESSION_ID_NUM_MAX] = {0};
 
+static Log gs_app_shell_log_handle = {0};
 
+
+static E_APP_SHELL_RET_STATUS_T _app_shell_cmd_table_init(void);
+static E_APP_SHELL_RET_STATUS_T _app_shell_session_init(E_APP_SHELL_SESSION_ID_T);
+static S_APP_SHELL_SESSION_T* _app_shell_session_get(Shell*);
 static int _app_shell_lock(Shell*);
 static int _app_shell_unlock(Shell*);
 static void _app_shell_log_write(char*, short);
+static int _app_shell_dispatch(Shell*, const ShellCommand*);
+static void _app_shell_rx_process(S_APP_SHELL_SESSION_T*, const uint8_t*, uint16_t);
+static void _app_shell_rx_pending_push(S_APP_SHELL_SESSION_T*, const uint8_t*, uint16_t);
+static void _app_shell_rx_pending_replay(S_APP_SHELL_SESSION_T*);
+static void _app_shell_trace_output(const char* const, const uint32_t);
+static int _app_shell_trace_dump(void);
+static int _app_shell_led_stats_show(void);
+
+/* Commands of the app, appended to shellCommandList so letter shell does not depend on the app */
+static const ShellCommand gs_app_shell_cmd_list[] =
+{
+    SHELL_CMD_ITEM(SHELL_CMD_PERMISSION(0)|SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC),
+                   trace, _app_shell_trace_dump, dump trace events),
+    SHELL_CMD_ITEM(SHELL_CMD_PERMISSION(0)|SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC),
+                   ledstat, _app_shell_led_stats_show, show LED write statistics),
+};
+
+static ShellCommand gs_app_shell_cmd_table[D_APP_SHELL_CMD_TABLE_SIZE] = {0};
+static unsigned short gs_app_shell_cmd_count = 0;
 
 extern E_APP_SHELL_RET_STATUS_T app_shell_init(void)
 {
-    /* Letter shell initialization*/
-    gs_app_shell_handle.shell_handle.write  = app_shell_port_write;
-    gs_app_shell_handle.shell_handle.read   = app_shell_port_read;
-    gs_app_shell_handle.shell_handle.lock   = _app_shell_lock;
-    gs_app_shell_handle.shell_handle.unlock = _app_shell_unlock;
+    if (E_APP_SHELL_RET_STATUS_OK != _app_shell_cmd_table_init() )
+    {
+        return E_APP_SHELL_RET_STATUS_ERROR;
+    }
 
-    shellInit(&gs_app_shell_handle.shell_handle, (char*)gs_app_shell_rx_parser_buf, D_APP_SHELL_PARSER_BUFFER_SIZE);
+    /* Sessions are initialized one by one before threads start, the first one builds the shared command index */
+    for (uint32_t i = 0; i < E_APP_SHELL_SESSION_ID_NUM_MAX; i++)
+    {
+        if (E_APP_SHELL_RET_STATUS_OK != _app_shell_session_init( (E_APP_SHELL_SESSION_ID_T)i) )
+        {
+            return E_APP_SHELL_RET_STATUS_ERROR;
+        }
+    }
 
-    /* Log of letter shell initialization */
-    gs_app_shell_handle.shell_log_handle.active =   1;
-    gs_app_shell_handle.shell_log_handle.level  =   LOG_DEBUG;
-    gs_app_shell_handle.shell_log_handle.write  =   _app_shell_log_write;
-    
-    logRegister(&gs_app_shell_handle.shell_log_handle, &gs_app_shell_handle.shell_handle);
+    return E_APP_SHELL_RET_STATUS_OK;
+}
+
+extern void app_shell_thread(void* argument)
+{
+    uint32_t session_id = (uint32_t)(uintptr_t)argument;
+    if (E_APP_SHELL_SESSION_ID_NUM_MAX <= session_id)
+    {
+        return;
+    }
+
+    S_APP_SHELL_SESSION_T* p_session = &gs_app_shell_session[session_id];
+
+    /* Read everything available in RX ringbuffer at once and feed it to shell in bulk */
+    short read_size = 0;
+    while (NULL != p_session->shell_handle.read && 
+           0 < (read_size = p_session->shell_handle.read( (char*)p_session->shell_rx_read_buf, D_APP_SHELL_RX_READ_BUFFER_SIZE)) )
+    {
+        osal_mutex_lock(p_session->shell_rx_os_mutex);
+        _app_shell_rx_process(p_session, p_session->shell_rx_read_buf, (uint16_t)read_size);
+        osal_mutex_unlock(p_session->shell_rx_os_mutex);
+    }
+}
+
+extern void app_shell_worker_thread(void* argument)
+{
+    uint32_t session_id = (uint32_t)(uintptr_t)argument;
+    if (E_APP_SHELL_SESSION_ID_NUM_MAX <= session_id)
+    {
+        return;
+    }
+
+    S_APP_SHELL_SESSION_T* p_session = &gs_app_shell_session[session_id];
+
+    /* Run dispatched commands, then replay the input received while they were running */
+    while (E_OSAL_RET_STATUS_OK == osal_semaphore_acquire(p_session->shell_exec_os_semaphore, D_OSAL_CORE_TIMEOUT_FOREVER) )
+    {
+        shellExecAsync(&p_session->shell_handle);
+
+        osal_mutex_lock(p_session->shell_rx_os_mutex);
+        _app_shell_rx_pending_replay(p_session);
+        osal_mutex_unlock(p_session->shell_rx_os_mutex);
+    }
+}
+
+/**
+ * @brief   Shell command trace, dump the tracer ring for tools/tracer_to_chrome.py
+ *          Recording is paused meanwhile, the dump's own output would otherwise overwrite the events being read
+ */
+static int _app_shell_trace_dump(void)
+{
+    bool is_enabled = tracer_enable_get();
+
+    tracer_enable_set(false);
+    E_TRACER_RET_STATUS_T ret = tracer_dump(_app_shell_trace_output);
+    tracer_enable_set(is_enabled);
+
+    return (E_TRACER_RET_STATUS_OK == ret) ? 0 : -1;
+}
+
+/**
+ * @brief   Shell command ledstat, show how many LED states were requested and how many reached GPIO
+ */
+static int _app_shell_led_stats_show(void)
+{
+    Shell* p_shell = shellGetCurrent();
+    S_LED_ADAPTER_DISP_STATS_T disp_stats = {0};
+
+    if (NULL == p_shell || E_LED_ADAPTER_RET_STATUS_OK != led_adapter_disp_stats_get(&disp_stats) )
+    {
+        return -1;
+    }
+
+    shellPrint(p_shell, "requested %lu, written %lu, flushes %lu\r\n", (unsigned long)disp_stats.disp_req_count,
+               (unsigned long)disp_stats.disp_write_count, (unsigned long)disp_stats.disp_flush_count);
+    return 0;
+}
+
+/**
+ * @brief   Build the command table of all sessions, shellCommandList followed by the app commands
+ * @return  E_APP_SHELL_RET_STATUS_T, error if D_APP_SHELL_CMD_TABLE_SIZE is too small
+ */
+static E_APP_SHELL_RET_STATUS_T _app_shell_cmd_table_init(void)
+{
+    extern const ShellCommand shellCommandList[];
+    extern const unsigned short shellCommandCount;
+    const unsigned short app_cmd_count = sizeof(gs_app_shell_cmd_list) / sizeof(ShellCommand);
+
+    if (D_APP_SHELL_CMD_TABLE_SIZE < (shellCommandCount + app_cmd_count) )
+    {
+        return E_APP_SHELL_RET_STATUS_ERROR;
+    }
+
+    memcpy(gs_app_shell_cmd_table, shellCommandList, shellCommandCount * sizeof(ShellCommand) );
+    memcpy(&gs_app_shell_cmd_table[shellCommandCount], gs_app_shell_cmd_list, sizeof(gs_app_shell_cmd_list) );
+    gs_app_shell_cmd_count = shellCommandCount + app_cmd_count;
+
+    return E_APP_SHELL_RET_STATUS_OK;
+}
+
+static E_APP_SHELL_RET_STATUS_T _app_shell_session_init(E_APP_SHELL_SESSION_ID_T session_id)
+{
+    const S_APP_SHELL_SESSION_CONFIG_T* p_conf = &gs_app_shell_session_conf[session_id];
+    S_APP_SHELL_SESSION_T* p_session = &gs_app_shell_session[session_id];
 
     /* Create TX mutex*/
     S_OSAL_MUTEX_CONFIG_T app_shell_tx_mutex_conf = 
@@ -51,31 +219,88 @@ extern E_APP_SHELL_RET_STATUS_T app_shell_init(void)
         .p_name = "App shell TX mutex"
     };
 
-    E_OSAL_RET_STATUS_T ret_status_osal = osal_mutex_create(&gs_app_shell_handle.shell_tx_os_mutex, &app_shell_tx_mutex_conf);
+    E_OSAL_RET_STATUS_T ret_status_osal = osal_mutex_create(&p_session->shell_tx_os_mutex, &app_shell_tx_mutex_conf);
     if (E_OSAL_RET_STATUS_OK != ret_status_osal)
     {
         return E_APP_SHELL_RET_STATUS_ERROR;
     }
 
+    /* Create RX mutex, it orders input between RX thread and pending replay of worker thread */
+    S_OSAL_MUTEX_CONFIG_T app_shell_rx_mutex_conf = 
+    {
+        .p_name = "App shell RX mutex"
+    };
+
+    ret_status_osal = osal_mutex_create(&p_session->shell_rx_os_mutex, &app_shell_rx_mutex_conf);
+    if (E_OSAL_RET_STATUS_OK != ret_status_osal)
+    {
+        return E_APP_SHELL_RET_STATUS_ERROR;
+    }
+
+    /* Create command execution semaphore, it wakes up worker thread */
+    S_OSAL_SEMAPHORE_CONFIG_T app_shell_exec_semaphore_conf = 
+    {
+        .p_name = "App shell exec semaphore"
+    };
+
+    ret_status_osal = osal_semaphore_create(&p_session->shell_exec_os_semaphore, &app_shell_exec_semaphore_conf, 1, 0);
+    if (E_OSAL_RET_STATUS_OK != ret_status_osal)
+    {
+        return E_APP_SHELL_RET_STATUS_ERROR;
+    }
+
+    /* Letter shell initialization */
+    p_session->shell_handle.write       = p_conf->pf_write;
+    p_session->shell_handle.read        = p_conf->pf_read;
+#if SHELL_USING_WATCH == 1
+    p_session->shell_handle.writeSpace  = p_conf->pf_write_space;
+#endif
+    p_session->shell_handle.lock        = _app_shell_lock;
+    p_session->shell_handle.unlock      = _app_shell_unlock;
+#if SHELL_ASYNC_EXEC == 1
+    p_session->shell_handle.dispatch    = _app_shell_dispatch;
+#endif
+
+    shellInit(&p_session->shell_handle, (char*)p_session->shell_rx_parser_buf, D_APP_SHELL_PARSER_BUFFER_SIZE);
+    shellSetCommandList(&p_session->shell_handle, gs_app_shell_cmd_table, gs_app_shell_cmd_count);
+
+    /* Log of letter shell initialization */
+    if (p_conf->is_log_output)
+    {
+        gs_app_shell_log_handle.active  =   1;
+        gs_app_shell_log_handle.level   =   LOG_DEBUG;
+        gs_app_shell_log_handle.write   =   _app_shell_log_write;
+
+        logRegister(&gs_app_shell_log_handle, &p_session->shell_handle);
+    }
+
     return E_APP_SHELL_RET_STATUS_OK;
 }
 
-extern void app_shell_thread(void* argument)
+static S_APP_SHELL_SESSION_T* _app_shell_session_get(Shell *shell)
 {
-    uint8_t data;
-    while (NULL != gs_app_shell_handle.shell_handle.read && 1 == gs_app_shell_handle.shell_handle.read( (char*)&data, 1))
+    for (uint32_t i = 0; i < E_APP_SHELL_SESSION_ID_NUM_MAX; i++)
     {
-        shellHandler(&gs_app_shell_handle.shell_handle, data);
+        if (&gs_app_shell_session[i].shell_handle == shell)
+        {
+            return &gs_app_shell_session[i];
+        }
     }
+
+    return NULL;
 }
 
 static int _app_shell_lock(Shell *shell)
 {
-    (void)shell;
-    
+    S_APP_SHELL_SESSION_T* p_session = _app_shell_session_get(shell);
+    if (NULL == p_session)
+    {
+        return -1;
+    }
+
     E_OSAL_RET_STATUS_T ret_status_osal = E_OSAL_RET_STATUS_OK;
 
-    ret_status_osal = osal_mutex_lock(gs_app_shell_handle.shell_tx_os_mutex);
+    ret_status_osal = osal_mutex_lock(p_session->shell_tx_os_mutex);
     if (E_OSAL_RET_STATUS_OK != ret_status_osal)
     {
         return -1;
@@ -86,11 +311,15 @@ static int _app_shell_lock(Shell *shell)
 
 static int _app_shell_unlock(Shell *shell)
 {
-    (void)shell;
+    S_APP_SHELL_SESSION_T* p_session = _app_shell_session_get(shell);
+    if (NULL == p_session)
+    {
+        return -1;
+    }
 
     E_OSAL_RET_STATUS_T ret_status_osal = E_OSAL_RET_STATUS_OK;
     
-    ret_status_osal = osal_mutex_unlock(gs_app_shell_handle.shell_tx_os_mutex);
+    ret_status_osal = osal_mutex_unlock(p_session->shell_tx_os_mutex);
     if (E_OSAL_RET_STATUS_OK != ret_status_osal)
     {
         return -1;
@@ -101,8 +330,99 @@ static int _app_shell_unlock(Shell *shell)
 
 static void _app_shell_log_write(char* data, short data_size)
 {
-    if (NULL != gs_app_shell_handle.shell_log_handle.shell)
+    if (NULL != gs_app_shell_log_handle.shell)
+    {
+        shellWriteEndLine(gs_app_shell_log_handle.shell, data, data_size);
+    }
+}
+
+static int _app_shell_dispatch(Shell *shell, const ShellCommand *command)
+{
+    (void)command;
+
+    S_APP_SHELL_SESSION_T* p_session = _app_shell_session_get(shell);
+    if (NULL == p_session)
+    {
+        return -1;
+    }
+
+    if (E_OSAL_RET_STATUS_OK != osal_semaphore_release(p_session->shell_exec_os_semaphore) )
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief   Feed received data to shell, called with RX mutex locked
+ * @note    While a command is running on worker thread, only Ctrl-C is handled,
+ *          the rest is kept in pending buffer and replayed when the command finishes
+ */
+static void _app_shell_rx_process(S_APP_SHELL_SESSION_T* p_session, const uint8_t* p_data, uint16_t data_size)
+{
+    Shell* p_shell = &p_session->shell_handle;
+    uint16_t handled_size = 0;
+
+    if (!shellIsBusy(p_shell) && 0 == p_session->shell_rx_pending_size)
+    {
+        handled_size = shellHandlerBuffer(p_shell, (const char*)p_data, data_size);
+    }
+
+    if (handled_size < data_size)
+    {
+        _app_shell_rx_pending_push(p_session, &p_data[handled_size], data_size - handled_size);
+    }
+}
+
+static void _app_shell_rx_pending_push(S_APP_SHELL_SESSION_T* p_session, const uint8_t* p_data, uint16_t data_size)
+{
+    Shell* p_shell = &p_session->shell_handle;
+
+    for (uint16_t i = 0; i < data_size; i++)
+    {
+        if (D_APP_SHELL_KEY_CANCEL == p_data[i] && 0 == shellCancel(p_shell) )
+        {
+            continue;
+        }
+
+        /* Input beyond pending buffer is dropped, like typing ahead into a full terminal */
+        if (D_APP_SHELL_RX_PENDING_BUFFER_SIZE > p_session->shell_rx_pending_size)
+        {
+            p_session->shell_rx_pending_buf[p_session->shell_rx_pending_size++] = p_data[i];
+        }
+    }
+}
+
+static void _app_shell_rx_pending_replay(S_APP_SHELL_SESSION_T* p_session)
+{
+    Shell* p_shell = &p_session->shell_handle;
+    uint16_t handled_size = 0;
+
+    if (shellIsBusy(p_shell) || 0 == p_session->shell_rx_pending_size)
+    {
+        return;
+    }
+
+    /* Replay stops again if pending input dispatches another command */
+    handled_size = shellHandlerBuffer(p_shell, (const char*)p_session->shell_rx_pending_buf, p_session->shell_rx_pending_size);
+
+    p_session->shell_rx_pending_size -= handled_size;
+    memmove(p_session->shell_rx_pending_buf, &p_session->shell_rx_pending_buf[handled_size], p_session->shell_rx_pending_size);
+}
+
+static void _app_shell_trace_output(const char* const p_data, const uint32_t data_size)
+{
+    Shell* p_shell = shellGetCurrent();
+    char line[D_APP_SHELL_TRACE_LINE_SIZE];
+    uint32_t copy_size = (sizeof(line) - 1 < data_size) ? (sizeof(line) - 1) : data_size;
+
+    if (NULL == p_shell)
     {
-        shellWriteEndLine(gs_app_shell_handle.shell_log_handle.shell, data, data_size);
+        return;
     }
-}
\ No newline at end of file
+
+    memcpy(line, p_data, copy_size);
+    line[copy_size] = '\0';
+    shellWriteString(p_shell, line);
+}
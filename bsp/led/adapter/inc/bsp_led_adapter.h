@@ -69,10 +69,18 @@ typedef struct
     uint8_t                                 exec_loop_start_idx;                             
 } S_LED_ADAPTER_DISP_PATTERN_CONFIG_T;
 
+typedef struct
+{
+    uint32_t                                disp_req_count;     /* LED states requested by patterns */
+    uint32_t                                disp_write_count;   /* LED states written to GPIO */
+    uint32_t                                disp_flush_count;   /* GPIO writes carrying them */
+} S_LED_ADAPTER_DISP_STATS_T;
+
 
 extern E_LED_ADAPTER_RET_STATUS_T led_adapter_init(void);
 extern void* led_adapter_thread_entry_get(void);
 extern E_LED_ADAPTER_RET_STATUS_T led_adapter_disp_ptn_preset_set(E_LED_ADAPTER_LED_ID_T, E_LED_ADAPTER_DISP_PATTERN_TYPE_T);
 extern E_LED_ADAPTER_RET_STATUS_T led_adapter_disp_ptn_custom_set(E_LED_ADAPTER_LED_ID_T, S_LED_ADAPTER_DISP_PATTERN_CONFIG_T*);
+extern E_LED_ADAPTER_RET_STATUS_T led_adapter_disp_stats_get(S_LED_ADAPTER_DISP_STATS_T*);
 
 #endif /* __BSP_LED_ADAPTER_H__ */
\ No newline at end of file
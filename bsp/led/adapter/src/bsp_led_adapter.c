@@ -26,6 +26,7 @@
 
 #include "mcu.h"
 
+#include "stdbool.h"
 #include "stddef.h"
 #include "string.h"
 
@@ -95,6 +96,8 @@ static E_LED_DRIVER_RET_STATUS_T _led_adapter_led_drv_disp_off(S_LED_DRIVER_T* c
 static E_LED_DRIVER_RET_STATUS_T _led_adapter_led_drv_disp_toggle(S_LED_DRIVER_T* const p_led_drv);
 static E_LED_DRIVER_RET_STATUS_T _led_adapter_led_drv_disp_status_get(S_LED_DRIVER_T* const p_led_drv, E_LED_DRIVER_DISP_STATUS_T* const p_status);
 
+static E_LED_HANDLER_RET_STATUS_T _led_adapter_led_hdl_disp_state_write(const uint8_t led_mask, const uint8_t led_on_bitmap);
+
 
 /*==============================================================================
  * Private Variable
@@ -125,6 +128,11 @@ static S_LED_HANDLER_TIMEBASE_INTERFACE_T gs_led_hdl_timebase_interface =
     .pf_time_ms_get     =   mcu_time_tick_get
 };
 
+static S_LED_HANDLER_DISP_OUTPUT_INTERFACE_T gs_led_hdl_disp_output_interface = 
+{
+    .pf_disp_state_write    =   _led_adapter_led_hdl_disp_state_write
+};
+
 static S_LED_DRIVER_DISP_OPERATION_INTERFACE_T gs_led_drv_disp_op_interface = 
 {
     .pf_disp_on         =   _led_adapter_led_drv_disp_on,
@@ -144,6 +152,7 @@ static const S_LED_HANDLER_INIT_CONFIG_T gs_led_hdl_init_conf =
     .pp_led_drv             =   gs_led_adp_led_drv_ptr_array,
     .p_led_drv_init_conf    =   &gs_led_drv_init_conf,
     .p_timebase_intf        =   &gs_led_hdl_timebase_interface,
+    .p_disp_output_intf     =   &gs_led_hdl_disp_output_interface,
 };
 
 
@@ -311,6 +320,29 @@ extern E_LED_ADAPTER_RET_STATUS_T led_adapter_disp_ptn_custom_set(E_LED_ADAPTER_
     return E_LED_ADAPTER_RET_STATUS_OK;
 }
 
+extern E_LED_ADAPTER_RET_STATUS_T led_adapter_disp_stats_get(S_LED_ADAPTER_DISP_STATS_T* p_disp_stats)
+{
+    /* Check input parameter */
+    if (NULL == p_disp_stats)
+    {
+        return E_LED_ADAPTER_RET_STATUS_INPUT_PARAM_ERROR;
+    }
+
+    /* Get statistics from handler */
+    S_LED_HANDLER_DISP_STATS_T led_hdl_disp_stats = {0};
+
+    if (E_LED_HANDLER_RET_STATUS_OK != led_handler_disp_stats_get(&led_hdl_disp_stats))
+    {
+        return E_LED_ADAPTER_RET_STATUS_RESOURCE_ERROR;
+    }
+
+    p_disp_stats->disp_req_count    = led_hdl_disp_stats.disp_req_count;
+    p_disp_stats->disp_write_count  = led_hdl_disp_stats.disp_write_count;
+    p_disp_stats->disp_flush_count  = led_hdl_disp_stats.disp_flush_count;
+
+    return E_LED_ADAPTER_RET_STATUS_OK;
+}
+
 
 /*==============================================================================
  * Private Function Implementation
@@ -517,3 +549,39 @@ static E_LED_DRIVER_RET_STATUS_T _led_adapter_led_drv_disp_status_get(S_LED_DRIV
 
     return E_LED_DRIVER_RET_STATUS_OK;
 }
+
+static E_LED_HANDLER_RET_STATUS_T _led_adapter_led_hdl_disp_state_write(const uint8_t led_mask, const uint8_t led_on_bitmap)
+{
+    uint32_t set_pin_mask = 0;
+    uint32_t reset_pin_mask = 0;
+
+    /* Map LEDs to GPIO pins according to active level */
+    for (uint8_t i = 0; i < E_LED_ADAPTER_LED_ID_NUM_MAX; i++)
+    {
+        uint8_t led_bit = (uint8_t)(1U << _led_adapter_led_id_adp_to_hdl( (E_LED_ADAPTER_LED_ID_T)i) );
+
+        if (0 == (led_mask & led_bit))
+        {
+            continue;
+        }
+
+        bool pin_is_set = (0 != (led_on_bitmap & led_bit)) == (E_LED_ADAPTER_LED_ACTIVE_HIGH == gs_led_adp_led_config[i].active_level);
+
+        if (pin_is_set)
+        {
+            set_pin_mask |= D_MCU_GPIO_PIN_MASK(gs_led_adp_led_config[i].gpio_pin);
+        }
+        else
+        {
+            reset_pin_mask |= D_MCU_GPIO_PIN_MASK(gs_led_adp_led_config[i].gpio_pin);
+        }
+    }
+
+    /* One GPIO write for all LEDs */
+    if (E_MCU_GPIO_RET_STATUS_OK != mcu_gpio_write_mask(set_pin_mask, reset_pin_mask))
+    {
+        return E_LED_HANDLER_RET_STATUS_RESOURCE_ERROR;
+    }
+
+    return E_LED_HANDLER_RET_STATUS_OK;
+}
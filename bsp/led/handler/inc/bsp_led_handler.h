@@ -137,6 +137,19 @@ typedef struct
     uint32_t (*pf_time_ms_get)(void);
 } S_LED_HANDLER_TIMEBASE_INTERFACE_T;
 
+typedef struct
+{
+    /* Write LEDs of led_mask at once, bit set in led_on_bitmap turns LED on */
+    E_LED_HANDLER_RET_STATUS_T (*pf_disp_state_write)(const uint8_t led_mask, const uint8_t led_on_bitmap);
+} S_LED_HANDLER_DISP_OUTPUT_INTERFACE_T;
+
+typedef struct
+{
+    uint32_t    disp_req_count;     /* LED states requested by pattern processing */
+    uint32_t    disp_write_count;   /* LED states successfully written to LED driver, failed writes are retried */
+    uint32_t    disp_flush_count;   /* Successful output writes carrying them, one per pass with batched output */
+} S_LED_HANDLER_DISP_STATS_T;
+
 typedef struct 
 {
     uint8_t                             led_drv_num;
@@ -144,6 +157,7 @@ typedef struct
     const S_LED_DRIVER_INIT_CONFIG_T*   p_led_drv_init_conf;
 
     S_LED_HANDLER_TIMEBASE_INTERFACE_T* p_timebase_intf;
+    S_LED_HANDLER_DISP_OUTPUT_INTERFACE_T* p_disp_output_intf;  /* Optional, without it LEDs are written one by one through LED driver */
 } S_LED_HANDLER_INIT_CONFIG_T;
 
 typedef struct S_LED_HANDLER_DISP_PATTERN_INTERFACE_T S_LED_HANDLER_DISP_PATTERN_INTERFACE_T; /* Forward declaration */
@@ -158,10 +172,16 @@ typedef struct
     S_LED_HANDLER_DISP_PATTERN_RUNTIME_T    disp_ptn_runtime[E_LED_HANDLER_LED_ID_NUM_MAX];
     S_LED_HANDLER_DISP_PATTERN_CONFIG_T     disp_ptn_config_custom[E_LED_HANDLER_LED_ID_NUM_MAX];
 
+    uint8_t                                 disp_state_bitmap;          /* Last state written to each LED, bit set is on */
+    uint8_t                                 disp_state_valid_bitmap;    /* LEDs whose written state is known */
+    uint8_t                                 disp_dirty_bitmap;          /* LEDs whose requested state is not written yet */
+    S_LED_HANDLER_DISP_STATS_T              disp_stats;
+
     void*                                   p_os_queue_handle;
 
     S_LED_HANDLER_DISP_PATTERN_INTERFACE_T* p_disp_ptn_intf;    /* Internal implementation */
     S_LED_HANDLER_TIMEBASE_INTERFACE_T*     p_timebase_intf;    /* External implementation */
+    S_LED_HANDLER_DISP_OUTPUT_INTERFACE_T*  p_disp_output_intf; /* External implementation, optional */
 } S_LED_HANDLER_T;
 
 
@@ -172,6 +192,7 @@ typedef struct
 extern void led_handler_thread(void*);
 extern E_LED_HANDLER_RET_STATUS_T led_handler_init(const S_LED_HANDLER_INIT_CONFIG_T* const);
 extern E_LED_HANDLER_RET_STATUS_T led_handler_disp_ptn_set(const S_LED_HANDLER_EVENT_T* const);
+extern E_LED_HANDLER_RET_STATUS_T led_handler_disp_stats_get(S_LED_HANDLER_DISP_STATS_T* const);
 
 
 #endif /* __BSP_LED_HANDLER_H__ */
\ No newline at end of file
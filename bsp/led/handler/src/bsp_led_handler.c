@@ -23,6 +23,7 @@
 #include "bsp_led_handler.h"
 
 #include "osal.h"
+#include "tracer.h"
 
 #include "stdbool.h"
 #include "string.h"
@@ -35,8 +36,8 @@
  /* OS parameters */
 #define D_LED_HANDLER_OS_QUEUE_SIZE                     10
 #define D_LED_HANDLER_OS_QUEUE_SEND_TIMEOUT_MS          0
-#define D_LED_HANDLER_OS_QUEUE_RECEIVE_TIMEOUT_MS       0
-#define D_LED_HANDLER_OS_THREAD_DELAY_MS                10
+/* A failed LED write is retried after this delay even if no step is due */
+#define D_LED_HANDLER_DISP_WRITE_RETRY_MS               10
 
 /* Display pattern parameters */
 #define D_LED_HANDLER_DISP_PATTERN_DURATION_INFINITE    0xFFFFFFFF
@@ -115,6 +116,10 @@
 }
 
 
+/* Compile-time check: Ensure every LED has a bit in the display state bitmaps */
+_Static_assert(8 >= E_LED_HANDLER_LED_ID_NUM_MAX, "LED display state bitmaps are too narrow!");
+
+
 /*==============================================================================
  * Private Structure
  *============================================================================*/
@@ -124,7 +129,7 @@ struct S_LED_HANDLER_DISP_PATTERN_INTERFACE_T
     E_LED_HANDLER_RET_STATUS_T (*pf_disp_ptn_preset_set)(S_LED_HANDLER_T* const, const E_LED_HANDLER_LED_ID_T, const E_LED_HANDLER_DISP_PATTERN_TYPE_T); 
     E_LED_HANDLER_RET_STATUS_T (*pf_disp_ptn_custom_set)(S_LED_HANDLER_T* const, const E_LED_HANDLER_LED_ID_T, const S_LED_HANDLER_DISP_PATTERN_CONFIG_T* const);
     E_LED_HANDLER_RET_STATUS_T (*pf_disp_ptn_start)(S_LED_HANDLER_T* const, const E_LED_HANDLER_LED_ID_T);
-    E_LED_HANDLER_RET_STATUS_T (*pf_disp_ptn_process)(S_LED_HANDLER_T* const);
+    E_LED_HANDLER_RET_STATUS_T (*pf_disp_ptn_process)(S_LED_HANDLER_T* const, uint32_t* const);
 } ;
 
 typedef struct 
@@ -143,7 +148,10 @@ static bool _led_handler_init_conf_is_valid(const S_LED_HANDLER_INIT_CONFIG_T* c
 static E_LED_HANDLER_RET_STATUS_T _led_handler_disp_ptn_preset_set(S_LED_HANDLER_T* const, const E_LED_HANDLER_LED_ID_T, const E_LED_HANDLER_DISP_PATTERN_TYPE_T);
 static E_LED_HANDLER_RET_STATUS_T _led_handler_disp_ptn_custom_set(S_LED_HANDLER_T* const, const E_LED_HANDLER_LED_ID_T, const S_LED_HANDLER_DISP_PATTERN_CONFIG_T* const);
 static E_LED_HANDLER_RET_STATUS_T _led_handler_disp_ptn_start(S_LED_HANDLER_T* const, const E_LED_HANDLER_LED_ID_T);
-static E_LED_HANDLER_RET_STATUS_T _led_handler_disp_ptn_process(S_LED_HANDLER_T* const);
+static E_LED_HANDLER_RET_STATUS_T _led_handler_disp_ptn_process(S_LED_HANDLER_T* const, uint32_t* const);
+
+static void _led_handler_disp_state_set(S_LED_HANDLER_T* const, const uint8_t, const E_LED_HANDLER_DISP_PATTERN_STEP_STATE_T);
+static void _led_handler_disp_state_flush(S_LED_HANDLER_T* const);
 
 static const S_LED_HANDLER_DISP_PATTERN_CONFIG_T* _led_handler_disp_ptn_preset_search(const E_LED_HANDLER_DISP_PATTERN_TYPE_T);
 
@@ -281,11 +289,17 @@ extern void led_handler_thread(void* argument)
     /* Initialize event */
     S_LED_HANDLER_EVENT_T event = {0};
 
+    /* Time until the next step deadline, nothing is running before the first event */
+    uint32_t next_timeout_ms = D_OSAL_CORE_TIMEOUT_FOREVER;
+
     /* Start LED handler loop process */
     while (1)
     {
-        /* Try to receive event from queue with timeout */
-        if (E_OSAL_RET_STATUS_OK == osal_queue_receive(gs_led_handler.p_os_queue_handle, &event, D_LED_HANDLER_OS_QUEUE_RECEIVE_TIMEOUT_MS))
+        /* Sleep until an event arrives or the earliest step deadline is reached, then take all
+         * queued events, so patterns set together start in the same pass and flush together */
+        uint32_t receive_timeout_ms = next_timeout_ms;
+
+        while (E_OSAL_RET_STATUS_OK == osal_queue_receive(gs_led_handler.p_os_queue_handle, &event, receive_timeout_ms))
         {
             /* Process received event */
             switch (event.event_type)
@@ -330,20 +344,20 @@ extern void led_handler_thread(void* argument)
             
             /* Clear event structure for next iteration */
             memset(&event, 0, sizeof(S_LED_HANDLER_EVENT_T));
+            receive_timeout_ms = 0;
         }
         
         /* Process all LED patterns (regardless of whether we received an event or not) */
-        ret_status = gs_led_handler.p_disp_ptn_intf->pf_disp_ptn_process(&gs_led_handler);
+        tracer_span_begin(E_TRACER_SPAN_ID_LED_DISP_PTN_PROCESS);
+        ret_status = gs_led_handler.p_disp_ptn_intf->pf_disp_ptn_process(&gs_led_handler, &next_timeout_ms);
+        tracer_span_end(E_TRACER_SPAN_ID_LED_DISP_PTN_PROCESS);
         if (E_LED_HANDLER_RET_STATUS_OK != ret_status)
         {
             /* Pattern processing failed, but continue thread execution */
             /* In production code, this might be logged for debugging */
             (void)ret_status;
+            next_timeout_ms = D_OSAL_CORE_TIMEOUT_FOREVER;
         }
-        
-        /* Small delay to prevent excessive CPU usage */
-        /* This also determines the LED pattern timing resolution */
-        osal_delay_ms(D_LED_HANDLER_OS_THREAD_DELAY_MS);
     }
 }
 
@@ -372,8 +386,9 @@ extern E_LED_HANDLER_RET_STATUS_T led_handler_init(const S_LED_HANDLER_INIT_CONF
     uint8_t led_drv_initialized_cnt = 0;
 
     /* Set LED handler interface */
-    gs_led_handler.p_timebase_intf  =   p_led_hdl_init_conf->p_timebase_intf;
-    gs_led_handler.p_disp_ptn_intf  =   &gs_led_handler_disp_ptn_intf;
+    gs_led_handler.p_timebase_intf      =   p_led_hdl_init_conf->p_timebase_intf;
+    gs_led_handler.p_disp_output_intf   =   p_led_hdl_init_conf->p_disp_output_intf;
+    gs_led_handler.p_disp_ptn_intf      =   &gs_led_handler_disp_ptn_intf;
 
     /* Create OS queue */
     S_OSAL_QUEUE_CONFIG_T os_queue_conf = 
@@ -481,6 +496,28 @@ extern E_LED_HANDLER_RET_STATUS_T led_handler_disp_ptn_set(const S_LED_HANDLER_E
     return E_LED_HANDLER_RET_STATUS_OK;
 }
 
+extern E_LED_HANDLER_RET_STATUS_T led_handler_disp_stats_get(S_LED_HANDLER_DISP_STATS_T* const p_disp_stats)
+{
+    /* Check input parameter */
+    if (NULL == p_disp_stats)
+    {
+        return E_LED_HANDLER_RET_STATUS_INPUT_PARAM_ERROR;
+    }
+
+    /* Check if LED handler is initialized */
+    if (E_LED_HANDLER_INIT_STATUS_OK != gs_led_handler.is_inited)
+    {
+        return E_LED_HANDLER_RET_STATUS_INIT_STATUS_ERROR;
+    }
+
+    /* Counters are only written by LED handler thread, word reads do not tear */
+    p_disp_stats->disp_req_count    =   gs_led_handler.disp_stats.disp_req_count;
+    p_disp_stats->disp_write_count  =   gs_led_handler.disp_stats.disp_write_count;
+    p_disp_stats->disp_flush_count  =   gs_led_handler.disp_stats.disp_flush_count;
+
+    return E_LED_HANDLER_RET_STATUS_OK;
+}
+
 
 /*==============================================================================
  * Private Functions
@@ -517,6 +554,12 @@ static bool _led_handler_init_conf_is_valid(const S_LED_HANDLER_INIT_CONFIG_T* c
         return false;
     }
 
+    if (NULL != p_led_hdl_init_conf->p_disp_output_intf &&
+        NULL == p_led_hdl_init_conf->p_disp_output_intf->pf_disp_state_write)
+    {
+        return false;
+    }
+
     return true;
 }
 
@@ -711,10 +754,10 @@ static E_LED_HANDLER_RET_STATUS_T _led_handler_disp_ptn_start(S_LED_HANDLER_T* c
     return E_LED_HANDLER_RET_STATUS_OK;
 }
 
-static E_LED_HANDLER_RET_STATUS_T _led_handler_disp_ptn_process(S_LED_HANDLER_T* const p_led_hdl)
+static E_LED_HANDLER_RET_STATUS_T _led_handler_disp_ptn_process(S_LED_HANDLER_T* const p_led_hdl, uint32_t* const p_next_timeout_ms)
 {
     /* Check input parameter */
-    if (NULL == p_led_hdl)
+    if (NULL == p_led_hdl || NULL == p_next_timeout_ms)
     {
         return E_LED_HANDLER_RET_STATUS_INPUT_PARAM_ERROR;
     }
@@ -728,6 +771,9 @@ static E_LED_HANDLER_RET_STATUS_T _led_handler_disp_ptn_process(S_LED_HANDLER_T*
     /* Get current time */
     uint32_t current_time_ms = p_led_hdl->p_timebase_intf->pf_time_ms_get();
 
+    /* Steady, finished and not started patterns have no deadline */
+    *p_next_timeout_ms = D_OSAL_CORE_TIMEOUT_FOREVER;
+
     /* Process each LED */
     for (uint8_t led_drv_idx = 0; led_drv_idx < p_led_hdl->led_drv_num; led_drv_idx++)
     {
@@ -757,14 +803,7 @@ static E_LED_HANDLER_RET_STATUS_T _led_handler_disp_ptn_process(S_LED_HANDLER_T*
         if (D_LED_HANDLER_DISP_PATTERN_DURATION_INFINITE == step_duration_ms)
         {
             /* Set LED state */
-            if (E_LED_HANDLER_DISP_PATTERN_STEP_STATE_ON == p_disp_ptn_config->steps[p_disp_ptn_runtime->step_idx].step_state)
-            {
-                led_driver_disp_on(p_led_hdl->p_led_drv[led_drv_idx]);
-            }
-            else
-            {
-                led_driver_disp_off(p_led_hdl->p_led_drv[led_drv_idx]);
-            }
+            _led_handler_disp_state_set(p_led_hdl, led_drv_idx, p_disp_ptn_config->steps[p_disp_ptn_runtime->step_idx].step_state);
             continue;
         }
 
@@ -793,14 +832,7 @@ static E_LED_HANDLER_RET_STATUS_T _led_handler_disp_ptn_process(S_LED_HANDLER_T*
                         if (p_disp_ptn_config->step_num > 0)
                         {
                             uint8_t last_step = p_disp_ptn_config->step_num - 1;
-                            if (E_LED_HANDLER_DISP_PATTERN_STEP_STATE_ON == p_disp_ptn_config->steps[last_step].step_state)
-                            {
-                                led_driver_disp_on(p_led_hdl->p_led_drv[led_drv_idx]); /* Ignore return status - best-effort execution */
-                            }
-                            else
-                            {
-                                led_driver_disp_off(p_led_hdl->p_led_drv[led_drv_idx]); /* Ignore return status - best-effort execution */
-                            }
+                            _led_handler_disp_state_set(p_led_hdl, led_drv_idx, p_disp_ptn_config->steps[last_step].step_state);
                         }
                         continue;
                     }
@@ -810,23 +842,118 @@ static E_LED_HANDLER_RET_STATUS_T _led_handler_disp_ptn_process(S_LED_HANDLER_T*
                 next_step_idx = p_disp_ptn_config->exec_loop_start_idx;
             } /* Check if one execution is completed */
 
-            /* Update pattern runtime information */
+            /* Update pattern runtime information, the next step starts at the deadline rather than at
+             * the wakeup so lateness does not accumulate, unless it is already over as well */
             p_disp_ptn_runtime->step_idx = next_step_idx;
-            p_disp_ptn_runtime->step_start_time_ms = current_time_ms;
+            p_disp_ptn_runtime->step_start_time_ms += step_duration_ms;
+            if ( (uint32_t)(current_time_ms - p_disp_ptn_runtime->step_start_time_ms) >= p_disp_ptn_config->steps[next_step_idx].dur_ms)
+            {
+                p_disp_ptn_runtime->step_start_time_ms = current_time_ms;
+            }
+            step_duration_ms = p_disp_ptn_config->steps[next_step_idx].dur_ms;
+        }
+
+        /* Keep the earliest deadline, an infinite step has none */
+        if (D_LED_HANDLER_DISP_PATTERN_DURATION_INFINITE != step_duration_ms)
+        {
+            uint32_t elapsed_ms = (uint32_t)(current_time_ms - p_disp_ptn_runtime->step_start_time_ms);
+            uint32_t remain_ms = (elapsed_ms < step_duration_ms) ? (step_duration_ms - elapsed_ms) : 0;
+
+            if (remain_ms < *p_next_timeout_ms)
+            {
+                *p_next_timeout_ms = remain_ms;
+            }
         }
 
         /* Set LED state */
-        if (E_LED_HANDLER_DISP_PATTERN_STEP_STATE_ON == p_disp_ptn_config->steps[p_disp_ptn_runtime->step_idx].step_state)
+        _led_handler_disp_state_set(p_led_hdl, led_drv_idx, p_disp_ptn_config->steps[p_disp_ptn_runtime->step_idx].step_state);
+    }
+
+    /* Only LEDs whose state really changed reach the driver */
+    _led_handler_disp_state_flush(p_led_hdl);
+
+    /* Failed writes stay dirty, wake up to retry them as a finished pattern has no deadline of its own */
+    if (0 != p_led_hdl->disp_dirty_bitmap && D_LED_HANDLER_DISP_WRITE_RETRY_MS < *p_next_timeout_ms)
+    {
+        *p_next_timeout_ms = D_LED_HANDLER_DISP_WRITE_RETRY_MS;
+    }
+
+    return E_LED_HANDLER_RET_STATUS_OK;
+}
+
+static void _led_handler_disp_state_set(S_LED_HANDLER_T* const p_led_hdl, 
+                                        const uint8_t led_drv_idx, 
+                                        const E_LED_HANDLER_DISP_PATTERN_STEP_STATE_T step_state)
+{
+    uint8_t led_bit = (uint8_t)(1U << led_drv_idx);
+    uint8_t state_bit = (E_LED_HANDLER_DISP_PATTERN_STEP_STATE_ON == step_state) ? led_bit : 0;
+
+    p_led_hdl->disp_stats.disp_req_count++;
+
+    /* Same as the state already written, nothing to do */
+    if (0 != (p_led_hdl->disp_state_valid_bitmap & led_bit) &&
+        state_bit == (p_led_hdl->disp_state_bitmap & led_bit))
+    {
+        p_led_hdl->disp_dirty_bitmap &= (uint8_t)~led_bit;
+        return;
+    }
+
+    p_led_hdl->disp_state_bitmap = (uint8_t)( (p_led_hdl->disp_state_bitmap & ~led_bit) | state_bit);
+    p_led_hdl->disp_dirty_bitmap |= led_bit;
+}
+
+static void _led_handler_disp_state_flush(S_LED_HANDLER_T* const p_led_hdl)
+{
+    /* All transitions of this pass land in one write, so LEDs changing together change at the same instant */
+    if (NULL != p_led_hdl->p_disp_output_intf && 0 != p_led_hdl->disp_dirty_bitmap)
+    {
+        uint8_t dirty_bitmap = p_led_hdl->disp_dirty_bitmap;
+
+        /* A failed write leaves the LED states unknown and dirty, the next pass writes them again */
+        if (E_LED_HANDLER_RET_STATUS_OK != p_led_hdl->p_disp_output_intf->pf_disp_state_write(dirty_bitmap, p_led_hdl->disp_state_bitmap & dirty_bitmap))
+        {
+            p_led_hdl->disp_state_valid_bitmap &= (uint8_t)~dirty_bitmap;
+            return;
+        }
+
+        p_led_hdl->disp_state_valid_bitmap |= dirty_bitmap;
+        p_led_hdl->disp_dirty_bitmap = 0;
+        p_led_hdl->disp_stats.disp_write_count += (uint32_t)__builtin_popcount(dirty_bitmap);
+        p_led_hdl->disp_stats.disp_flush_count++;
+        return;
+    }
+
+    for (uint8_t led_drv_idx = 0; led_drv_idx < p_led_hdl->led_drv_num && 0 != p_led_hdl->disp_dirty_bitmap; led_drv_idx++)
+    {
+        uint8_t led_bit = (uint8_t)(1U << led_drv_idx);
+        E_LED_DRIVER_RET_STATUS_T ret_status = E_LED_DRIVER_RET_STATUS_OK;
+
+        if (0 == (p_led_hdl->disp_dirty_bitmap & led_bit))
+        {
+            continue;
+        }
+
+        if (0 != (p_led_hdl->disp_state_bitmap & led_bit))
         {
-            led_driver_disp_on(p_led_hdl->p_led_drv[led_drv_idx]); /* Ignore return status - best-effort execution */
+            ret_status = led_driver_disp_on(p_led_hdl->p_led_drv[led_drv_idx]);
         }
         else
         {
-            led_driver_disp_off(p_led_hdl->p_led_drv[led_drv_idx]); /* Ignore return status - best-effort execution */
+            ret_status = led_driver_disp_off(p_led_hdl->p_led_drv[led_drv_idx]);
         }
-    }
 
-    return E_LED_HANDLER_RET_STATUS_OK;
+        /* A failed write leaves the LED state unknown and dirty, the next pass writes it again */
+        if (E_LED_DRIVER_RET_STATUS_OK != ret_status)
+        {
+            p_led_hdl->disp_state_valid_bitmap &= (uint8_t)~led_bit;
+            continue;
+        }
+
+        p_led_hdl->disp_state_valid_bitmap |= led_bit;
+        p_led_hdl->disp_dirty_bitmap &= (uint8_t)~led_bit;
+        p_led_hdl->disp_stats.disp_write_count++;
+        p_led_hdl->disp_stats.disp_flush_count++;
+    }
 }
 
 static const S_LED_HANDLER_DISP_PATTERN_CONFIG_T* _led_handler_disp_ptn_preset_search(const E_LED_HANDLER_DISP_PATTERN_TYPE_T disp_ptn_type)
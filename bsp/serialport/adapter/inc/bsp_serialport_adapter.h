@@ -18,6 +18,7 @@ typedef enum
     E_SERIALPORT_ADAPTER_RET_STATUS_INPUT_PARAM_ERROR,
     E_SERIALPORT_ADAPTER_RET_STATUS_RESOURCE_ERROR,
     E_SERIALPORT_ADAPTER_RET_STATUS_TX_OVERFLOW,
+    E_SERIALPORT_ADAPTER_RET_STATUS_RX_RECORD_INCOMPLETE,
 } E_SERIALPORT_ADAPTER_RET_STATUS_T;
 
 
@@ -28,7 +29,10 @@ typedef enum
 extern E_SERIALPORT_ADAPTER_RET_STATUS_T serialport_adapter_init(void);
 extern void* serialport_adapter_thread_entry_get(void);
 extern E_SERIALPORT_ADAPTER_RET_STATUS_T serialport_adapter_transmit(const uint8_t* const, const uint16_t);
+extern E_SERIALPORT_ADAPTER_RET_STATUS_T serialport_adapter_tx_free_size_get(uint16_t* const);
 extern E_SERIALPORT_ADAPTER_RET_STATUS_T serialport_adapter_receive(uint8_t* const, uint16_t* const);
+extern E_SERIALPORT_ADAPTER_RET_STATUS_T serialport_adapter_receive_until(uint8_t* const, uint16_t* const, const uint8_t);
+extern E_SERIALPORT_ADAPTER_RET_STATUS_T serialport_adapter_receive_line(uint8_t* const, uint16_t* const);
 
 
 
@@ -55,6 +55,7 @@ static uint16_t _serialport_adapter_hdl_rx_ringbuf_read(uint8_t* const, const ui
 static uint16_t _serialport_adapter_hdl_rx_ringbuf_used_size_get(void);
 static uint16_t _serialport_adapter_hdl_rx_ringbuf_free_size_get(void);
 static uint16_t _serialport_adapter_hdl_rx_ringbuf_max_size_get(void);
+static uint16_t _serialport_adapter_hdl_rx_ringbuf_find(const uint8_t* const, const uint16_t, const uint16_t);
 
 /**
  * @brief  MCU layer callback function
@@ -110,6 +111,7 @@ static S_SERIALPORT_HANDLER_RINGBUF_INTERFACE_T gs_serialport_handler_rx_ringbuf
     .pf_ringbuf_used_size_get    = _serialport_adapter_hdl_rx_ringbuf_used_size_get,
     .pf_ringbuf_free_size_get    = _serialport_adapter_hdl_rx_ringbuf_free_size_get,
     .pf_ringbuf_max_size_get     = _serialport_adapter_hdl_rx_ringbuf_max_size_get,
+    .pf_ringbuf_find             = _serialport_adapter_hdl_rx_ringbuf_find,
 };
 
 static S_SERIALPORT_HANDLER_INIT_CONFIG_T gs_serialport_handler_init_conf = 
@@ -214,6 +216,30 @@ extern E_SERIALPORT_ADAPTER_RET_STATUS_T serialport_adapter_transmit(const uint8
 
     /* Transmit data to handler layer */
     E_SERIALPORT_HANDLER_RET_STATUS_T ret_status_hdl = serialport_handler_transmit(p_data, data_size);
+    if (E_SERIALPORT_HANDLER_RET_STATUS_TX_OVERFLOW == ret_status_hdl)
+    {
+        return E_SERIALPORT_ADAPTER_RET_STATUS_TX_OVERFLOW;
+    }
+    else if (E_SERIALPORT_HANDLER_RET_STATUS_OK != ret_status_hdl)
+    {
+        (void)ret_status_hdl;
+
+        return E_SERIALPORT_ADAPTER_RET_STATUS_RESOURCE_ERROR;
+    }
+
+    return E_SERIALPORT_ADAPTER_RET_STATUS_OK;
+}
+
+extern E_SERIALPORT_ADAPTER_RET_STATUS_T serialport_adapter_tx_free_size_get(uint16_t* const p_free_size)
+{
+    /* Check input parameter */
+    if (NULL == p_free_size)
+    {
+        return E_SERIALPORT_ADAPTER_RET_STATUS_INPUT_PARAM_ERROR;
+    }
+
+    /* Get TX ringbuffer free size from handler layer */
+    E_SERIALPORT_HANDLER_RET_STATUS_T ret_status_hdl = serialport_handler_tx_free_size_get(p_free_size);
     if (E_SERIALPORT_HANDLER_RET_STATUS_OK != ret_status_hdl)
     {
         (void)ret_status_hdl;
@@ -244,6 +270,50 @@ extern E_SERIALPORT_ADAPTER_RET_STATUS_T serialport_adapter_receive(uint8_t* con
     return E_SERIALPORT_ADAPTER_RET_STATUS_OK;
 }
 
+extern E_SERIALPORT_ADAPTER_RET_STATUS_T serialport_adapter_receive_until(uint8_t* const p_data, uint16_t* const p_data_size, const uint8_t delim)
+{
+    /* Check input parameter */
+    if (NULL == p_data || NULL == p_data_size || 0 == *p_data_size)
+    {
+        return E_SERIALPORT_ADAPTER_RET_STATUS_INPUT_PARAM_ERROR;
+    }
+
+    /* Receive one record from handler layer */
+    E_SERIALPORT_HANDLER_RET_STATUS_T ret_status_hdl = serialport_handler_read_until(p_data, p_data_size, delim);
+    if (E_SERIALPORT_HANDLER_RET_STATUS_RX_RECORD_INCOMPLETE == ret_status_hdl)
+    {
+        return E_SERIALPORT_ADAPTER_RET_STATUS_RX_RECORD_INCOMPLETE;
+    }
+    else if (E_SERIALPORT_HANDLER_RET_STATUS_OK != ret_status_hdl)
+    {
+        return E_SERIALPORT_ADAPTER_RET_STATUS_RESOURCE_ERROR;
+    }
+
+    return E_SERIALPORT_ADAPTER_RET_STATUS_OK;
+}
+
+extern E_SERIALPORT_ADAPTER_RET_STATUS_T serialport_adapter_receive_line(uint8_t* const p_data, uint16_t* const p_data_size)
+{
+    /* Check input parameter */
+    if (NULL == p_data || NULL == p_data_size || 0 == *p_data_size)
+    {
+        return E_SERIALPORT_ADAPTER_RET_STATUS_INPUT_PARAM_ERROR;
+    }
+
+    /* Receive one line from handler layer */
+    E_SERIALPORT_HANDLER_RET_STATUS_T ret_status_hdl = serialport_handler_read_line(p_data, p_data_size);
+    if (E_SERIALPORT_HANDLER_RET_STATUS_RX_RECORD_INCOMPLETE == ret_status_hdl)
+    {
+        return E_SERIALPORT_ADAPTER_RET_STATUS_RX_RECORD_INCOMPLETE;
+    }
+    else if (E_SERIALPORT_HANDLER_RET_STATUS_OK != ret_status_hdl)
+    {
+        return E_SERIALPORT_ADAPTER_RET_STATUS_RESOURCE_ERROR;
+    }
+
+    return E_SERIALPORT_ADAPTER_RET_STATUS_OK;
+}
+
 
 /*==============================================================================
  * Private Function Implementation
@@ -499,6 +569,31 @@ static uint16_t _serialport_adapter_hdl_rx_ringbuf_max_size_get(void)
     return D_SERIALPORT_ADAPTER_RECEIVE_RINGBUFFER_CPPACITY_SIZE;
 }
 
+static uint16_t _serialport_adapter_hdl_rx_ringbuf_find(const uint8_t* const p_pattern, const uint16_t pattern_size, const uint16_t start_offset)
+{
+    /* Check input parameter */
+    if (NULL == p_pattern || 0 == pattern_size)
+    {
+        return 0;
+    }
+
+    /* Check if ringbuffer is ready */
+    if (1 != lwrb_is_ready(&gs_serialport_adapter_rx_ringbuf_handle) )
+    {
+        return 0;
+    }
+
+    /* Find pattern in ringbuffer */
+    lwrb_sz_t found_idx = 0;
+    if (1 != lwrb_find(&gs_serialport_adapter_rx_ringbuf_handle, p_pattern, (lwrb_sz_t)pattern_size, (lwrb_sz_t)start_offset, &found_idx) )
+    {
+        return 0;
+    }
+
+    /* Record size includes the pattern */
+    return (uint16_t)(found_idx + pattern_size);
+}
+
 static void _serialport_adapter_mcu_uart_to_drv_on_transmit_complete(void)
 {
     E_SERIALPORT_DRIVER_RET_STATUS_T ret_status_drv = E_SERIALPORT_DRIVER_RET_STATUS_OK;
@@ -20,6 +20,7 @@ typedef enum
     E_SERIALPORT_HANDLER_RET_STATUS_RESOURCE_ERR,
     E_SERIALPORT_HANDLER_RET_STATUS_TX_MAX_SIZE_EXCEED,
     E_SERIALPORT_HANDLER_RET_STATUS_TX_OVERFLOW,
+    E_SERIALPORT_HANDLER_RET_STATUS_RX_RECORD_INCOMPLETE,
 } E_SERIALPORT_HANDLER_RET_STATUS_T;
 
 typedef enum
@@ -47,6 +48,7 @@ typedef uint16_t (*PF_SERIALPORT_HANDLER_RINGBUF_READ_T)(uint8_t* const, const u
 typedef uint16_t (*PF_SERIALPORT_HANDLER_RINGBUF_USED_SIZE_GET_T)(void);
 typedef uint16_t (*PF_SERIALPORT_HANDLER_RINGBUF_FREE_SIZE_GET_T)(void);
 typedef uint16_t (*PF_SERIALPORT_HANDLER_RINGBUF_MAX_SIZE_GET_T)(void);
+typedef uint16_t (*PF_SERIALPORT_HANDLER_RINGBUF_FIND_T)(const uint8_t* const, const uint16_t, const uint16_t);
 
 typedef struct 
 {
@@ -59,6 +61,9 @@ typedef struct
     PF_SERIALPORT_HANDLER_RINGBUF_USED_SIZE_GET_T   pf_ringbuf_used_size_get;
     PF_SERIALPORT_HANDLER_RINGBUF_FREE_SIZE_GET_T   pf_ringbuf_free_size_get;
     PF_SERIALPORT_HANDLER_RINGBUF_MAX_SIZE_GET_T    pf_ringbuf_max_size_get;
+
+    /* Return the record size up to and including the pattern, 0 if not found. Mandatory for RX only */
+    PF_SERIALPORT_HANDLER_RINGBUF_FIND_T            pf_ringbuf_find;
 } S_SERIALPORT_HANDLER_RINGBUF_INTERFACE_T;
 
 typedef struct
@@ -93,8 +98,11 @@ extern E_SERIALPORT_HANDLER_RET_STATUS_T serialport_handler_init(const S_SERIALP
 
 extern E_SERIALPORT_HANDLER_RET_STATUS_T serialport_handler_transmit(const uint8_t* const, const uint16_t);
 extern E_SERIALPORT_HANDLER_RET_STATUS_T serialport_handler_on_transmit_complete(void);
+extern E_SERIALPORT_HANDLER_RET_STATUS_T serialport_handler_tx_free_size_get(uint16_t* const);
 
 extern E_SERIALPORT_HANDLER_RET_STATUS_T serialport_handler_receive(uint8_t* const, uint16_t* const);
+extern E_SERIALPORT_HANDLER_RET_STATUS_T serialport_handler_read_until(uint8_t* const, uint16_t* const, const uint8_t);
+extern E_SERIALPORT_HANDLER_RET_STATUS_T serialport_handler_read_line(uint8_t* const, uint16_t* const);
 extern E_SERIALPORT_HANDLER_RET_STATUS_T serialport_handler_on_hw_receive_process(const uint8_t* const, const uint16_t);
 extern E_SERIALPORT_HANDLER_RET_STATUS_T serialport_handler_on_hw_receive_complete(void);
 
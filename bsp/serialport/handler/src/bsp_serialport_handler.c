@@ -19,6 +19,8 @@
 
 #define D_SERIALPORT_HANDLER_TRANSMIT_TMP_BUFFER_SIZE   (512)
 
+#define D_SERIALPORT_HANDLER_LINE_DELIMITER             ('\n')
+
 
 /*==============================================================================
  * Global Variable
@@ -324,6 +326,29 @@ extern E_SERIALPORT_HANDLER_RET_STATUS_T serialport_handler_on_transmit_complete
     return E_SERIALPORT_HANDLER_RET_STATUS_OK;
 }
 
+/**
+ * @brief   Get free size of TX ringbuffer
+ * @note    The value is a snapshot, it lets producers throttle before transmit fails with TX overflow.
+ */
+extern E_SERIALPORT_HANDLER_RET_STATUS_T serialport_handler_tx_free_size_get(uint16_t* const p_free_size)
+{
+    /* Check input parameter */
+    if (NULL == p_free_size)
+    {
+        return E_SERIALPORT_HANDLER_RET_STATUS_INPUT_PARAM_ERR;
+    }
+
+    /* Check handler initialization status */
+    if (E_SERIALPORT_HANDLER_INIT_STATUS_OK != gs_serialport_handler.is_inited)
+    {
+        return E_SERIALPORT_HANDLER_RET_STATUS_INIT_STATUS_ERR;
+    }
+
+    *p_free_size = gs_serialport_handler.p_tx_ringbuf_intf->pf_ringbuf_free_size_get();
+
+    return E_SERIALPORT_HANDLER_RET_STATUS_OK;
+}
+
 extern E_SERIALPORT_HANDLER_RET_STATUS_T serialport_handler_receive(uint8_t* const p_data, uint16_t* const p_data_size)
 {
     /* Check input parameter */
@@ -364,6 +389,97 @@ extern E_SERIALPORT_HANDLER_RET_STATUS_T serialport_handler_receive(uint8_t* con
     return E_SERIALPORT_HANDLER_RET_STATUS_OK;
 }
 
+/**
+ * @brief   Read one record terminated by the delimiter from RX ringbuffer
+ * @note    Block until the delimiter is present in RX ringbuffer, then copy the whole record
+ *          (delimiter included) in one read. The caller is woken up per hardware receive event
+ *          instead of per byte, and already searched data is not searched again.
+ *          If the record does not fit into the caller buffer, or RX ringbuffer is full without
+ *          delimiter, the first part is returned with RX_RECORD_INCOMPLETE, the rest is kept.
+ * @param   p_data      Output buffer
+ * @param   p_data_size Input: output buffer size. Output: record size
+ * @param   delim       Record delimiter
+ */
+extern E_SERIALPORT_HANDLER_RET_STATUS_T serialport_handler_read_until(uint8_t* const p_data, uint16_t* const p_data_size, const uint8_t delim)
+{
+    /* Check input parameter */
+    if (NULL == p_data || NULL == p_data_size || 0 == *p_data_size)
+    {
+        return E_SERIALPORT_HANDLER_RET_STATUS_INPUT_PARAM_ERR;
+    }
+
+    /* Check handler initialization status */
+    if (E_SERIALPORT_HANDLER_INIT_STATUS_OK != gs_serialport_handler.is_inited)
+    {
+        return E_SERIALPORT_HANDLER_RET_STATUS_INIT_STATUS_ERR;
+    }
+
+    E_SERIALPORT_HANDLER_RET_STATUS_T ret_status = E_SERIALPORT_HANDLER_RET_STATUS_OK;
+    S_SERIALPORT_HANDLER_RINGBUF_INTERFACE_T* p_rx_ringbuf_intf = gs_serialport_handler.p_rx_ringbuf_intf;
+
+    uint16_t buffer_size = *p_data_size;
+    uint16_t max_size = p_rx_ringbuf_intf->pf_ringbuf_max_size_get();
+    uint16_t search_offset = 0;
+    uint16_t need_size = 0;
+
+    while (1)
+    {
+        /* Acquire semaphore, released on each hardware receive event */
+        if (E_OSAL_RET_STATUS_OK != osal_semaphore_acquire(gs_serialport_handler.p_rx_semaphore_handle, D_OSAL_CORE_TIMEOUT_FOREVER) )
+        {
+            return E_SERIALPORT_HANDLER_RET_STATUS_RESOURCE_ERR;
+        }
+
+        /* Search delimiter from the first byte not searched yet */
+        uint16_t used_size = p_rx_ringbuf_intf->pf_ringbuf_used_size_get();
+        need_size = p_rx_ringbuf_intf->pf_ringbuf_find(&delim, 1, search_offset);
+        if (0 < need_size)
+        {
+            break;
+        }
+
+        /* No delimiter, but the record can not grow any more */
+        if (buffer_size <= used_size || max_size <= used_size)
+        {
+            need_size = used_size;
+            ret_status = E_SERIALPORT_HANDLER_RET_STATUS_RX_RECORD_INCOMPLETE;
+            break;
+        }
+
+        search_offset = used_size;
+    }
+
+    /* Record is larger than output buffer */
+    if (buffer_size < need_size)
+    {
+        need_size = buffer_size;
+        ret_status = E_SERIALPORT_HANDLER_RET_STATUS_RX_RECORD_INCOMPLETE;
+    }
+
+    /* Copy record in one read */
+    *p_data_size = p_rx_ringbuf_intf->pf_ringbuf_read(p_data, need_size);
+
+    /* If ringbuffer is still not empty, release semaphore again */
+    if (0 < p_rx_ringbuf_intf->pf_ringbuf_used_size_get() )
+    {
+        if (E_OSAL_RET_STATUS_OK != osal_semaphore_release(gs_serialport_handler.p_rx_semaphore_handle) )
+        {
+            return E_SERIALPORT_HANDLER_RET_STATUS_RESOURCE_ERR;
+        }
+    }
+
+    return ret_status;
+}
+
+/**
+ * @brief   Read one line terminated by LF from RX ringbuffer
+ * @note    See serialport_handler_read_until
+ */
+extern E_SERIALPORT_HANDLER_RET_STATUS_T serialport_handler_read_line(uint8_t* const p_data, uint16_t* const p_data_size)
+{
+    return serialport_handler_read_until(p_data, p_data_size, D_SERIALPORT_HANDLER_LINE_DELIMITER);
+}
+
 /**
  * @brief   Callback function for hardware receive process
  * @note    This function is used to notify the handler to process hardware receive data.
@@ -448,7 +564,8 @@ static bool _serialport_handler_init_conf_is_valid(const S_SERIALPORT_HANDLER_IN
         NULL == p_init_config->p_rx_ringbuf_intf->pf_ringbuf_read           ||
         NULL == p_init_config->p_rx_ringbuf_intf->pf_ringbuf_free_size_get  ||
         NULL == p_init_config->p_rx_ringbuf_intf->pf_ringbuf_used_size_get  ||
-        NULL == p_init_config->p_rx_ringbuf_intf->pf_ringbuf_max_size_get)
+        NULL == p_init_config->p_rx_ringbuf_intf->pf_ringbuf_max_size_get  ||
+        NULL == p_init_config->p_rx_ringbuf_intf->pf_ringbuf_find)
     {
         return false;
     }
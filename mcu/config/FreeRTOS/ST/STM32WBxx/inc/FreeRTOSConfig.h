@@ -385,6 +385,16 @@ extern uint32_t SystemCoreClock; /* GCW: A additional variable from system_stm32
   * the additional information from the structures. Defaults to 0 if left
   * undefined. */
  #define configUSE_TRACE_FACILITY                1
+
+ /* Trace hooks of mcu/core, weak and empty there and overridden by utility/tracer:
+  * task names at creation and task switches. They run inside tasks.c, where the
+  * TCB members are visible. */
+ #ifndef __ASSEMBLER__
+     extern void mcu_core_trace_task_create( const uint32_t, const char * const );
+     extern void mcu_core_trace_task_switched_in( const uint32_t );
+ #endif
+ #define traceTASK_CREATE( pxNewTCB )    mcu_core_trace_task_create( ( uint32_t ) ( pxNewTCB )->uxTCBNumber, ( pxNewTCB )->pcTaskName )
+ #define traceTASK_SWITCHED_IN()         mcu_core_trace_task_switched_in( ( uint32_t ) pxCurrentTCB->uxTCBNumber )
  
  /* Set to 1 to include the vTaskList() and vTaskGetRunTimeStats() functions in
   * the build.  Set to 0 to exclude these functions from the build.  These two
@@ -2,13 +2,39 @@
 #ifndef __MCU_CORE_H__
 #define __MCU_CORE_H__
 
+#include "stdint.h"
+
 typedef enum
 {
     E_MCU_CORE_RET_STATUS_OK = 0,
     E_MCU_CORE_RET_STATUS_ERROR,
 } E_MCU_CORE_RET_STATUS_T;
 
+typedef enum
+{
+    E_MCU_CORE_FAULT_TYPE_HARD = 0,
+    E_MCU_CORE_FAULT_TYPE_MEM_MANAGE,
+} E_MCU_CORE_FAULT_TYPE_T;
+
+/* Interrupt handlers reporting to the trace hooks */
+typedef enum
+{
+    E_MCU_CORE_ISR_ID_USART1 = 0,
+    E_MCU_CORE_ISR_ID_UART_TX_DMA,
+    E_MCU_CORE_ISR_ID_UART_RX_DMA,
+    E_MCU_CORE_ISR_ID_NUM_MAX,
+} E_MCU_CORE_ISR_ID_T;
+
+typedef void (*PF_MCU_CORE_FAULT_CALLBACK_T)(const E_MCU_CORE_FAULT_TYPE_T);
+
 extern E_MCU_CORE_RET_STATUS_T mcu_core_init(void);
+extern E_MCU_CORE_RET_STATUS_T mcu_core_fault_callback_register(const PF_MCU_CORE_FAULT_CALLBACK_T);
+
+/* Trace hooks, empty weak definitions in mcu_core.c, a tracer overrides them */
+extern void mcu_core_trace_isr_enter(const E_MCU_CORE_ISR_ID_T);
+extern void mcu_core_trace_isr_exit(const E_MCU_CORE_ISR_ID_T);
+extern void mcu_core_trace_task_create(const uint32_t, const char* const);
+extern void mcu_core_trace_task_switched_in(const uint32_t);
 
 extern void NMI_Handler(void);
 extern void HardFault_Handler(void);
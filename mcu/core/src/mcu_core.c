@@ -2,6 +2,10 @@
 
 #include "stm32wbxx_hal.h"
 
+#include "stddef.h"
+
+
+static PF_MCU_CORE_FAULT_CALLBACK_T gs_mcu_core_fault_callback = NULL;
 
 static E_MCU_CORE_RET_STATUS_T _mcu_core_system_clock_config(void);
 
@@ -12,6 +16,58 @@ extern E_MCU_CORE_RET_STATUS_T mcu_core_init(void)
     return _mcu_core_system_clock_config();    
 }
 
+/**
+ * @brief   Register the callback run by fault handlers before they halt
+ *          It runs in fault context: no OS call, no blocking, keep it to saving state
+ * @param   pf_callback Callback, NULL to remove
+ * @return  E_MCU_CORE_RET_STATUS_T
+ */
+extern E_MCU_CORE_RET_STATUS_T mcu_core_fault_callback_register(const PF_MCU_CORE_FAULT_CALLBACK_T pf_callback)
+{
+    gs_mcu_core_fault_callback = pf_callback;
+
+    return E_MCU_CORE_RET_STATUS_OK;
+}
+
+/**
+ * @brief   Trace hook at the entry of an instrumented interrupt handler
+ *          Weak and empty, a tracer overrides it without mcu linking the tracer
+ * @param   isr_id ISR ID
+ */
+__weak void mcu_core_trace_isr_enter(const E_MCU_CORE_ISR_ID_T isr_id)
+{
+    (void)isr_id;
+}
+
+/**
+ * @brief   Trace hook at the exit of an instrumented interrupt handler
+ * @param   isr_id ISR ID
+ */
+__weak void mcu_core_trace_isr_exit(const E_MCU_CORE_ISR_ID_T isr_id)
+{
+    (void)isr_id;
+}
+
+/**
+ * @brief   Trace hook of FreeRTOS traceTASK_CREATE, see FreeRTOSConfig.h
+ * @param   task_num FreeRTOS task number
+ * @param   p_name Task name
+ */
+__weak void mcu_core_trace_task_create(const uint32_t task_num, const char* const p_name)
+{
+    (void)task_num;
+    (void)p_name;
+}
+
+/**
+ * @brief   Trace hook of FreeRTOS traceTASK_SWITCHED_IN, see FreeRTOSConfig.h
+ * @param   task_num FreeRTOS task number
+ */
+__weak void mcu_core_trace_task_switched_in(const uint32_t task_num)
+{
+    (void)task_num;
+}
+
 static E_MCU_CORE_RET_STATUS_T _mcu_core_system_clock_config(void)
 {
     RCC_OscInitTypeDef RCC_OscInitStruct = {0};
@@ -66,6 +122,11 @@ extern void NMI_Handler(void)
 
 extern void HardFault_Handler(void)
 {
+    if (NULL != gs_mcu_core_fault_callback)
+    {
+        gs_mcu_core_fault_callback(E_MCU_CORE_FAULT_TYPE_HARD);
+    }
+
     while (1)
     {
 
@@ -74,6 +135,11 @@ extern void HardFault_Handler(void)
 
 extern void MemManage_Handler(void)
 {
+    if (NULL != gs_mcu_core_fault_callback)
+    {
+        gs_mcu_core_fault_callback(E_MCU_CORE_FAULT_TYPE_MEM_MANAGE);
+    }
+
     while (1)
     {
 
@@ -9,6 +9,17 @@
 #include "stdint.h"
 
 
+/*==============================================================================
+ * Macro
+ *============================================================================*/
+
+/* Bit of a pin in the masks of mcu_gpio_write_mask */
+#define D_MCU_GPIO_PIN_MASK(gpio_pin)   (1UL << (gpio_pin))
+
+/* Recorded port writes kept by host backend */
+#define D_MCU_GPIO_SIM_WRITE_LOG_SIZE   (64)
+
+
 /*==============================================================================
  * Enum
  *============================================================================*/
@@ -43,6 +54,22 @@ typedef enum
 } E_MCU_GPIO_PIN_T;
 
 
+/*==============================================================================
+ * Structure
+ *============================================================================*/
+
+/**
+ * @brief Port write recorded by host backend, masks are port pin bits like BSRR
+ */
+typedef struct
+{
+    char        port_name;
+    uint16_t    set_mask;
+    uint16_t    reset_mask;
+    uint16_t    output;         /* Port output after the write */
+} S_MCU_GPIO_SIM_WRITE_T;
+
+
 /*==============================================================================
  * External Function
  *============================================================================*/
@@ -52,6 +79,12 @@ extern E_MCU_GPIO_RET_STATUS_T mcu_gpio_deinit(void);
 extern E_MCU_GPIO_RET_STATUS_T mcu_gpio_write_pin(const E_MCU_GPIO_PIN_T gpio_pin, const E_MCU_GPIO_PIN_STATE_T pin_state);
 extern E_MCU_GPIO_RET_STATUS_T mcu_gpio_read_pin(const E_MCU_GPIO_PIN_T gpio_pin, E_MCU_GPIO_PIN_STATE_T* const pin_state);
 extern E_MCU_GPIO_RET_STATUS_T mcu_gpio_toggle_pin(const E_MCU_GPIO_PIN_T gpio_pin); 
+extern E_MCU_GPIO_RET_STATUS_T mcu_gpio_write_mask(const uint32_t set_pin_mask, const uint32_t reset_pin_mask);
+
+#if defined(__linux__)
+extern uint32_t mcu_gpio_sim_write_num_get(void);
+extern E_MCU_GPIO_RET_STATUS_T mcu_gpio_sim_write_get(const uint32_t write_idx, S_MCU_GPIO_SIM_WRITE_T* const p_write);
+#endif
 
 
 #endif /* __MCU_GPIO_H__ */
\ No newline at end of file
@@ -4,7 +4,11 @@
 
 #include "mcu_gpio.h"
 
+#if defined(__linux__)
+#include "stddef.h"
+#else
 #include "stm32wbxx_hal.h"
+#endif
 
 #include "assert.h"
 
@@ -12,7 +16,9 @@
  * Static Function Declaration
  *============================================================================*/
 
+#if !defined(__linux__)
  static void _mcu_gpio_port_b_clk_enable(void);
+#endif
 
 
 /*==============================================================================
@@ -24,6 +30,33 @@
     X(LED_1, GPIOB, GPIO_PIN_0, GPIO_MODE_OUTPUT_PP, GPIO_NOPULL, GPIO_SPEED_FREQ_LOW, _mcu_gpio_port_b_clk_enable) \
     X(LED_2, GPIOB, GPIO_PIN_1, GPIO_MODE_OUTPUT_PP, GPIO_NOPULL, GPIO_SPEED_FREQ_LOW, _mcu_gpio_port_b_clk_enable)
 
+#if defined(__linux__)
+/* Host backend: ports and pins of the list mapped to simulated ports */
+ #define D_MCU_GPIO_SIM_PORT_GPIOA      (&gs_mcu_gpio_sim_port[0])
+ #define D_MCU_GPIO_SIM_PORT_GPIOB      (&gs_mcu_gpio_sim_port[1])
+ #define D_MCU_GPIO_SIM_PORT_GPIOC      (&gs_mcu_gpio_sim_port[2])
+ #define D_MCU_GPIO_SIM_PORT_GPIOD      (&gs_mcu_gpio_sim_port[3])
+ #define D_MCU_GPIO_SIM_PORT_GPIOE      (&gs_mcu_gpio_sim_port[4])
+ #define D_MCU_GPIO_SIM_PORT_GPIOH      (&gs_mcu_gpio_sim_port[5])
+
+ #define D_MCU_GPIO_SIM_GPIO_PIN_0      (1U << 0)
+ #define D_MCU_GPIO_SIM_GPIO_PIN_1      (1U << 1)
+ #define D_MCU_GPIO_SIM_GPIO_PIN_2      (1U << 2)
+ #define D_MCU_GPIO_SIM_GPIO_PIN_3      (1U << 3)
+ #define D_MCU_GPIO_SIM_GPIO_PIN_4      (1U << 4)
+ #define D_MCU_GPIO_SIM_GPIO_PIN_5      (1U << 5)
+ #define D_MCU_GPIO_SIM_GPIO_PIN_6      (1U << 6)
+ #define D_MCU_GPIO_SIM_GPIO_PIN_7      (1U << 7)
+ #define D_MCU_GPIO_SIM_GPIO_PIN_8      (1U << 8)
+ #define D_MCU_GPIO_SIM_GPIO_PIN_9      (1U << 9)
+ #define D_MCU_GPIO_SIM_GPIO_PIN_10     (1U << 10)
+ #define D_MCU_GPIO_SIM_GPIO_PIN_11     (1U << 11)
+ #define D_MCU_GPIO_SIM_GPIO_PIN_12     (1U << 12)
+ #define D_MCU_GPIO_SIM_GPIO_PIN_13     (1U << 13)
+ #define D_MCU_GPIO_SIM_GPIO_PIN_14     (1U << 14)
+ #define D_MCU_GPIO_SIM_GPIO_PIN_15     (1U << 15)
+#endif
+
 
 /*==============================================================================
  * Enum
@@ -43,19 +76,39 @@ static_assert((uint8_t)E_MCU_GPIO_PIN_NUM_MAX == (uint8_t)E_MCU_GPIO_PIN_ACTUAL_
     "LED GPIO configuration count mismatch! Check D_MCU_GPIO_PIN_CONF_LIST and E_MCU_GPIO_PIN_NUM_MAX"
 );
 
+/* Compile-time check: Ensure every pin has a bit in the masks of mcu_gpio_write_mask */
+static_assert(32 >= (uint8_t)E_MCU_GPIO_PIN_NUM_MAX, "Too many GPIO pins for a 32-bit pin mask!");
+
+#if !defined(__linux__)
 /* Compile-time check: Ensure the pin state enum is equal to HAL pin state enum */
 static_assert((uint8_t)E_MCU_GPIO_PIN_STATE_RESET == (uint8_t)GPIO_PIN_RESET, "Pin state RESET mismatch!");
 static_assert((uint8_t)E_MCU_GPIO_PIN_STATE_SET == (uint8_t)GPIO_PIN_SET, "Pin state SET mismatch!");
+#endif
 
 
  /*==============================================================================
  * Structure
  *============================================================================*/
 
+#if defined(__linux__)
+/* Host backend: a port is its output register, nothing else is simulated */
+typedef struct
+{
+    char        name;
+    uint16_t    output;
+} S_MCU_GPIO_SIM_PORT_T;
+
+typedef S_MCU_GPIO_SIM_PORT_T S_MCU_GPIO_PORT_T;
+#else
+typedef GPIO_TypeDef S_MCU_GPIO_PORT_T;
+#endif
+
+static void _mcu_gpio_port_write(S_MCU_GPIO_PORT_T* const, const uint16_t, const uint16_t);
+
 typedef struct
 {
     const char* name;
-    GPIO_TypeDef* port;
+    S_MCU_GPIO_PORT_T* port;
     uint16_t pin;
     uint32_t mode;
     uint32_t pull;
@@ -63,6 +116,28 @@ typedef struct
     void (*pf_clk_enable)(void);
 } S_MCU_GPIO_PIN_CONFIG_T;
 
+#if defined(__linux__)
+static S_MCU_GPIO_SIM_PORT_T gs_mcu_gpio_sim_port[] = 
+{
+    {.name = 'A'}, {.name = 'B'}, {.name = 'C'}, {.name = 'D'}, {.name = 'E'}, {.name = 'H'},
+};
+
+static S_MCU_GPIO_SIM_WRITE_T gs_mcu_gpio_sim_write_log[D_MCU_GPIO_SIM_WRITE_LOG_SIZE];
+static uint32_t gs_mcu_gpio_sim_write_num = 0;
+
+static const S_MCU_GPIO_PIN_CONFIG_T gs_mcu_gpio_pin_config[E_MCU_GPIO_PIN_NUM_MAX] = 
+{
+#define X(gpio_name, gpio_port, gpio_pin, ...) \
+    [E_MCU_GPIO_PIN_##gpio_name] =  \
+    {                               \
+        .name   =   #gpio_name,     \
+        .port   =   D_MCU_GPIO_SIM_PORT_##gpio_port, \
+        .pin    =   D_MCU_GPIO_SIM_##gpio_pin, \
+    },
+    D_MCU_GPIO_PIN_CONF_LIST
+#undef X
+};
+#else
 static const S_MCU_GPIO_PIN_CONFIG_T gs_mcu_gpio_pin_config[E_MCU_GPIO_PIN_NUM_MAX] = 
 {
 #define X(gpio_name, gpio_port, gpio_pin, gpio_mode, gpio_pull, gpio_speed, gpio_clk_enable) \
@@ -79,12 +154,106 @@ static const S_MCU_GPIO_PIN_CONFIG_T gs_mcu_gpio_pin_config[E_MCU_GPIO_PIN_NUM_M
     D_MCU_GPIO_PIN_CONF_LIST
 #undef X
 };
+#endif
 
 
 /*==============================================================================
  * External Function Implementation
  *============================================================================*/
 
+#if defined(__linux__)
+/* Host backend: pins change the simulated port output and every port write is recorded */
+
+extern E_MCU_GPIO_RET_STATUS_T mcu_gpio_init(void)
+{
+    for (uint32_t i = 0; i < sizeof(gs_mcu_gpio_sim_port) / sizeof(gs_mcu_gpio_sim_port[0]); i++)
+    {
+        gs_mcu_gpio_sim_port[i].output = 0;
+    }
+
+    gs_mcu_gpio_sim_write_num = 0;
+
+    return E_MCU_GPIO_RET_STATUS_OK;
+}
+
+extern E_MCU_GPIO_RET_STATUS_T mcu_gpio_deinit(void)
+{
+    return E_MCU_GPIO_RET_STATUS_OK;
+}
+
+extern E_MCU_GPIO_RET_STATUS_T mcu_gpio_write_pin(const E_MCU_GPIO_PIN_T gpio_pin, const E_MCU_GPIO_PIN_STATE_T pin_state)
+{
+    if (0 > gpio_pin || E_MCU_GPIO_PIN_NUM_MAX <= gpio_pin)
+    {
+        return E_MCU_GPIO_RET_STATUS_INPUT_PARAM_ERR;
+    }
+
+    if (E_MCU_GPIO_PIN_STATE_RESET != pin_state)
+    {
+        _mcu_gpio_port_write(gs_mcu_gpio_pin_config[gpio_pin].port, gs_mcu_gpio_pin_config[gpio_pin].pin, 0);
+    }
+    else
+    {
+        _mcu_gpio_port_write(gs_mcu_gpio_pin_config[gpio_pin].port, 0, gs_mcu_gpio_pin_config[gpio_pin].pin);
+    }
+
+    return E_MCU_GPIO_RET_STATUS_OK;
+}
+
+extern E_MCU_GPIO_RET_STATUS_T mcu_gpio_read_pin(const E_MCU_GPIO_PIN_T gpio_pin, E_MCU_GPIO_PIN_STATE_T* const pin_state)
+{
+    if (0 > gpio_pin || E_MCU_GPIO_PIN_NUM_MAX <= gpio_pin)
+    {
+        return E_MCU_GPIO_RET_STATUS_INPUT_PARAM_ERR;
+    }
+
+    *pin_state = (0 != (gs_mcu_gpio_pin_config[gpio_pin].port->output & gs_mcu_gpio_pin_config[gpio_pin].pin) ) ? E_MCU_GPIO_PIN_STATE_SET : E_MCU_GPIO_PIN_STATE_RESET;
+
+    return E_MCU_GPIO_RET_STATUS_OK;
+}
+
+extern E_MCU_GPIO_RET_STATUS_T mcu_gpio_toggle_pin(const E_MCU_GPIO_PIN_T gpio_pin)
+{
+    E_MCU_GPIO_PIN_STATE_T pin_state = E_MCU_GPIO_PIN_STATE_RESET;
+
+    if (E_MCU_GPIO_RET_STATUS_OK != mcu_gpio_read_pin(gpio_pin, &pin_state) )
+    {
+        return E_MCU_GPIO_RET_STATUS_INPUT_PARAM_ERR;
+    }
+
+    return mcu_gpio_write_pin(gpio_pin, (E_MCU_GPIO_PIN_STATE_RESET == pin_state) ? E_MCU_GPIO_PIN_STATE_SET : E_MCU_GPIO_PIN_STATE_RESET);
+}
+
+/**
+ * @brief   Get how many port writes were recorded since mcu_gpio_init
+ * @return  Write number
+ */
+extern uint32_t mcu_gpio_sim_write_num_get(void)
+{
+    return gs_mcu_gpio_sim_write_num;
+}
+
+/**
+ * @brief   Get a recorded port write, only the last D_MCU_GPIO_SIM_WRITE_LOG_SIZE ones are kept
+ * @param   write_idx   Index counted from mcu_gpio_init
+ * @param   p_write     Recorded write
+ * @return  Status
+ */
+extern E_MCU_GPIO_RET_STATUS_T mcu_gpio_sim_write_get(const uint32_t write_idx, S_MCU_GPIO_SIM_WRITE_T* const p_write)
+{
+    if (NULL == p_write || gs_mcu_gpio_sim_write_num <= write_idx ||
+        D_MCU_GPIO_SIM_WRITE_LOG_SIZE < gs_mcu_gpio_sim_write_num - write_idx)
+    {
+        return E_MCU_GPIO_RET_STATUS_INPUT_PARAM_ERR;
+    }
+
+    *p_write = gs_mcu_gpio_sim_write_log[write_idx % D_MCU_GPIO_SIM_WRITE_LOG_SIZE];
+
+    return E_MCU_GPIO_RET_STATUS_OK;
+}
+
+#else
+
 extern E_MCU_GPIO_RET_STATUS_T mcu_gpio_init(void)
 {
     for (uint32_t i = 0; i < E_MCU_GPIO_PIN_NUM_MAX; i++)
@@ -148,12 +317,93 @@ extern E_MCU_GPIO_RET_STATUS_T mcu_gpio_toggle_pin(const E_MCU_GPIO_PIN_T gpio_p
     return E_MCU_GPIO_RET_STATUS_OK;
 }
 
+#endif /* __linux__ */
+
+/**
+ * @brief   Set and reset several pins, pins sharing a port change in one register write
+ * @param   set_pin_mask    Pins to set, bit D_MCU_GPIO_PIN_MASK(pin)
+ * @param   reset_pin_mask  Pins to reset, must not overlap set_pin_mask
+ * @return  Status
+ */
+extern E_MCU_GPIO_RET_STATUS_T mcu_gpio_write_mask(const uint32_t set_pin_mask, const uint32_t reset_pin_mask)
+{
+    const uint32_t pin_mask_all = (uint32_t)( (1ULL << E_MCU_GPIO_PIN_NUM_MAX) - 1ULL);
+
+    if (0 != (set_pin_mask & reset_pin_mask) || 0 != ( (set_pin_mask | reset_pin_mask) & ~pin_mask_all) )
+    {
+        return E_MCU_GPIO_RET_STATUS_INPUT_PARAM_ERR;
+    }
+
+    /* Gather pins by port */
+    S_MCU_GPIO_PORT_T* p_port[E_MCU_GPIO_PIN_NUM_MAX] = {0};
+    uint16_t port_set_mask[E_MCU_GPIO_PIN_NUM_MAX] = {0};
+    uint16_t port_reset_mask[E_MCU_GPIO_PIN_NUM_MAX] = {0};
+    uint8_t port_num = 0;
+
+    for (uint8_t i = 0; i < E_MCU_GPIO_PIN_NUM_MAX; i++)
+    {
+        if (0 == ( (set_pin_mask | reset_pin_mask) & D_MCU_GPIO_PIN_MASK(i) ) )
+        {
+            continue;
+        }
+
+        uint8_t port_idx = 0;
+        while (port_idx < port_num && p_port[port_idx] != gs_mcu_gpio_pin_config[i].port)
+        {
+            port_idx++;
+        }
+
+        if (port_idx == port_num)
+        {
+            p_port[port_num++] = gs_mcu_gpio_pin_config[i].port;
+        }
+
+        if (0 != (set_pin_mask & D_MCU_GPIO_PIN_MASK(i) ) )
+        {
+            port_set_mask[port_idx] |= gs_mcu_gpio_pin_config[i].pin;
+        }
+        else
+        {
+            port_reset_mask[port_idx] |= gs_mcu_gpio_pin_config[i].pin;
+        }
+    }
+
+    for (uint8_t port_idx = 0; port_idx < port_num; port_idx++)
+    {
+        _mcu_gpio_port_write(p_port[port_idx], port_set_mask[port_idx], port_reset_mask[port_idx]);
+    }
+
+    return E_MCU_GPIO_RET_STATUS_OK;
+}
+
 /*==============================================================================
  * Static Function Implementation
  *============================================================================*/
 
+/**
+ * @brief   Set and reset pins of a port at once, like a single BSRR write
+ */
+static void _mcu_gpio_port_write(S_MCU_GPIO_PORT_T* const p_port, const uint16_t set_mask, const uint16_t reset_mask)
+{
+#if defined(__linux__)
+    p_port->output = (uint16_t)( (p_port->output & ~reset_mask) | set_mask);
+
+    S_MCU_GPIO_SIM_WRITE_T* p_write = &gs_mcu_gpio_sim_write_log[gs_mcu_gpio_sim_write_num % D_MCU_GPIO_SIM_WRITE_LOG_SIZE];
+    p_write->port_name  = p_port->name;
+    p_write->set_mask   = set_mask;
+    p_write->reset_mask = reset_mask;
+    p_write->output     = p_port->output;
+    gs_mcu_gpio_sim_write_num++;
+#else
+    /* Upper half of BSRR resets, lower half sets, all in one bus write */
+    p_port->BSRR = ( (uint32_t)reset_mask << 16) | set_mask;
+#endif
+}
+
+#if !defined(__linux__)
 static void _mcu_gpio_port_b_clk_enable(void)
 {
     __HAL_RCC_GPIOB_CLK_ENABLE();
 }
+#endif
 
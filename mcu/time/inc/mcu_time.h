@@ -15,5 +15,8 @@
 
 extern uint32_t mcu_time_tick_get(void);
 extern void mcu_time_delay_ms(uint32_t delay_ms);   
+extern uint64_t mcu_time_us_get(void);
+extern uint32_t mcu_time_cycles_get(void);
+extern uint32_t mcu_time_cycles_freq_get(void);
 
 #endif /* __MCU_TIME_H__ */
\ No newline at end of file
@@ -4,7 +4,11 @@
 
 #include "mcu_time.h"
 
+#if defined(__linux__)
+#include "time.h"
+#else
 #include "stm32wbxx_hal.h"
+#endif
 
 
 /*==============================================================================
@@ -15,19 +19,65 @@
  #define D_MCU_TIME_TIMEBASE_CLK_ENABLE()     __HAL_RCC_TIM17_CLK_ENABLE()
  #define D_MCU_TIME_TIMEBASE_CLK_DISABLE()    __HAL_RCC_TIM17_CLK_DISABLE()
  #define D_MCU_TIME_TIMEBASE_IRQ_NUM          TIM1_TRG_COM_TIM17_IRQn
+ /* Timebase counter runs at 1 MHz and wraps every millisecond */
+ #define D_MCU_TIME_TIMEBASE_COUNTER_HZ       (1000000U)
+ #define D_MCU_TIME_TIMEBASE_PERIOD_US        (1000U)
 
 
 /*==============================================================================
  * Variable
  *============================================================================*/
 
+#if !defined(__linux__)
 static TIM_HandleTypeDef gs_mcu_time_timbase_handle;
+/* High word of the millisecond tick, HAL_GetTick() wraps after 49.7 days */
+static volatile uint32_t gs_mcu_time_tick_high = 0;
+/* Last value returned by mcu_time_us_get(), it never goes back */
+static uint64_t gs_mcu_time_us_last = 0;
+#endif
 
 
 /*==============================================================================
  * External Function Implementation
  *============================================================================*/
 
+#if defined(__linux__)
+/* Host backend: monotonic clock of the OS, cycles are nanoseconds */
+
+extern uint32_t mcu_time_tick_get(void)
+{
+    return (uint32_t)(mcu_time_us_get() / 1000U);
+}
+
+extern void mcu_time_delay_ms(uint32_t delay_ms)
+{
+    struct timespec ts = { .tv_sec = delay_ms / 1000U, .tv_nsec = (long)(delay_ms % 1000U) * 1000000L };
+    while (0 != nanosleep(&ts, &ts) )
+    {
+    }
+}
+
+extern uint64_t mcu_time_us_get(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000U + (uint64_t)ts.tv_nsec / 1000U;
+}
+
+extern uint32_t mcu_time_cycles_get(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)( (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec);
+}
+
+extern uint32_t mcu_time_cycles_freq_get(void)
+{
+    return 1000000000U;
+}
+
+#else
+
 extern uint32_t mcu_time_tick_get(void)
 {
     return HAL_GetTick();
@@ -38,6 +88,61 @@ extern void mcu_time_delay_ms(uint32_t delay_ms)
     HAL_Delay(delay_ms);
 }
 
+/**
+ * @brief   Get the time since boot in microseconds
+ *          64-bit millisecond tick plus the 1 MHz timebase counter, read with interrupts masked,
+ *          a wrap whose interrupt is still pending (critical section or higher priority ISR) is counted
+ * @note    An ISR preempting the tick handler between clearing UIF and HAL_IncTick() sees neither
+ *          the flag nor the new tick, it gets the last returned value instead of going back 1 ms
+ * @return  Microseconds, monotonic
+ */
+extern uint64_t mcu_time_us_get(void)
+{
+    TIM_TypeDef* p_tim = D_MCU_TIME_TIMEBASE_INSTANCE;
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    uint64_t tick = ( (uint64_t)gs_mcu_time_tick_high << 32) | HAL_GetTick();
+    uint32_t counter = p_tim->CNT;
+
+    /* Counter wrapped but the tick is not incremented yet, read the counter again behind the wrap */
+    if (0 != (p_tim->SR & TIM_SR_UIF) )
+    {
+        counter = p_tim->CNT;
+        tick++;
+    }
+
+    uint64_t us = tick * D_MCU_TIME_TIMEBASE_PERIOD_US + counter;
+    if (us < gs_mcu_time_us_last)
+    {
+        us = gs_mcu_time_us_last;
+    }
+    gs_mcu_time_us_last = us;
+
+    __set_PRIMASK(primask);
+
+    return us;
+}
+
+/**
+ * @brief   Get the core cycle counter (DWT CYCCNT), it wraps around
+ * @return  Cycles
+ */
+extern uint32_t mcu_time_cycles_get(void)
+{
+    return DWT->CYCCNT;
+}
+
+/**
+ * @brief   Get the core cycle counter frequency
+ * @return  Hz
+ */
+extern uint32_t mcu_time_cycles_freq_get(void)
+{
+    return SystemCoreClock;
+}
+
 extern HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
 {
     RCC_ClkInitTypeDef    clkconfig;
@@ -50,6 +155,10 @@ extern HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
     /* Enable the TIM17 global Interrupt */
     HAL_NVIC_EnableIRQ(D_MCU_TIME_TIMEBASE_IRQ_NUM);
 
+    /* Start the core cycle counter, HAL_Init() calls this before anything is timed */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
     /* Enable TIM17 clock */
     D_MCU_TIME_TIMEBASE_CLK_ENABLE();
     /* Get clock configuration */
@@ -58,7 +167,7 @@ extern HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
     uwTimclock = HAL_RCC_GetPCLK2Freq();
 
     /* Compute the prescaler value to have TIM17 counter clock equal to 1MHz */
-    uwPrescalerValue = (uint32_t) ((uwTimclock / 1000000U) - 1U);
+    uwPrescalerValue = (uint32_t) ((uwTimclock / D_MCU_TIME_TIMEBASE_COUNTER_HZ) - 1U);
 
     /* Initialize TIM17 */
     gs_mcu_time_timbase_handle.Instance = D_MCU_TIME_TIMEBASE_INSTANCE;
@@ -70,7 +179,7 @@ extern HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
     + ClockDivision = 0
     + Counter direction = Up
     */
-    gs_mcu_time_timbase_handle.Init.Period          =   (1000000U / 1000U) - 1U;
+    gs_mcu_time_timbase_handle.Init.Period          =   D_MCU_TIME_TIMEBASE_PERIOD_US - 1U;
     gs_mcu_time_timbase_handle.Init.Prescaler       =   uwPrescalerValue;
     gs_mcu_time_timbase_handle.Init.ClockDivision   =   0;
     gs_mcu_time_timbase_handle.Init.CounterMode     =   TIM_COUNTERMODE_UP;
@@ -118,7 +227,8 @@ extern void TIM1_TRG_COM_TIM17_IRQHandler(void)
  * @brief  Period elapsed callback in non blocking mode
  * @note   This function is called  when TIM17 interrupt took place, inside
  * HAL_TIM_IRQHandler(). It makes a direct call to HAL_IncTick() to increment
- * a global variable "uwTick" used as application time base.
+ * a global variable "uwTick" used as application time base, and carries its
+ * wrap into the high word used by mcu_time_us_get().
  * @param  htim : TIM handle
  * @retval None
  */
@@ -126,6 +236,14 @@ extern void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
 {
     if (htim->Instance == gs_mcu_time_timbase_handle.Instance)
     {
+        uint32_t tick = HAL_GetTick();
+
         HAL_IncTick();
+        if (HAL_GetTick() < tick)
+        {
+            gs_mcu_time_tick_high++;
+        }
     }
 }
+
+#endif /* __linux__ */
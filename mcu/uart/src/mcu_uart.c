@@ -6,6 +6,8 @@
 
 #include "stm32wbxx_hal.h"
 
+#include "mcu_core.h"
+
 
 #include "string.h"
 
@@ -598,15 +600,21 @@ extern void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef* huart, uint16_t Size)
 
 extern void DMA1_Channel1_IRQHandler(void)
 {
+	mcu_core_trace_isr_enter(E_MCU_CORE_ISR_ID_UART_TX_DMA);
 	HAL_DMA_IRQHandler(&(gs_mcu_uart_handle.tx_dma_hal_handle) );
+	mcu_core_trace_isr_exit(E_MCU_CORE_ISR_ID_UART_TX_DMA);
 }
 
 extern void DMA1_Channel2_IRQHandler(void)
 {
+	mcu_core_trace_isr_enter(E_MCU_CORE_ISR_ID_UART_RX_DMA);
 	HAL_DMA_IRQHandler(&(gs_mcu_uart_handle.rx_dma_hal_handle) );
+	mcu_core_trace_isr_exit(E_MCU_CORE_ISR_ID_UART_RX_DMA);
 }
 
 extern void USART1_IRQHandler()
 {
+	mcu_core_trace_isr_enter(E_MCU_CORE_ISR_ID_USART1);
 	HAL_UART_IRQHandler(&(gs_mcu_uart_handle.uart_hal_handle) );
+	mcu_core_trace_isr_exit(E_MCU_CORE_ISR_ID_USART1);
 }
@@ -39,6 +39,12 @@ typedef enum
     E_OSAL_THREAD_PRIORITY_NUM_MAX,
 } E_OSAL_THREAD_PRIORITY_T;
 
+typedef enum
+{
+    E_OSAL_TIMER_TYPE_ONCE,     /* One-shot timer */
+    E_OSAL_TIMER_TYPE_PERIODIC, /* Periodic timer */
+} E_OSAL_TIMER_TYPE_T;
+
 typedef struct 
 {
     const char*                 p_name;
@@ -63,6 +69,14 @@ typedef struct
     const char*                 p_name;
 } S_OSAL_QUEUE_CONFIG_T;
 
+typedef struct
+{
+    const char*                 p_name;
+    void                       (*p_callback)(void*); /* Runs in timer service thread, keep it short and non-blocking */
+    void*                       p_arg;
+    E_OSAL_TIMER_TYPE_T         type;
+} S_OSAL_TIMER_CONFIG_T;
+
 
 /*==============================================================================
  * External Function Declaration
@@ -72,10 +86,13 @@ extern E_OSAL_RET_STATUS_T osal_kernel_init(void);
 extern E_OSAL_RET_STATUS_T osal_kernel_start(void);
 
 extern uint32_t osal_get_tick(void);
+extern uint64_t osal_get_time_us(void);
 
 extern E_OSAL_RET_STATUS_T osal_delay_ms(const uint32_t delay_ms);
 
 extern E_OSAL_RET_STATUS_T osal_thread_create(void** const pp_thread_handle, const S_OSAL_THREAD_CONFIG_T* const p_thread_config);
+extern void* osal_thread_self(void);
+extern const char* osal_thread_name_get(void* const p_thread_handle);
 
 extern E_OSAL_RET_STATUS_T osal_mutex_create(void** const pp_mutex_handle, const S_OSAL_MUTEX_CONFIG_T* const p_mutex_config);
 extern E_OSAL_RET_STATUS_T osal_mutex_delete(void* const p_mutex_handle);
@@ -93,5 +110,10 @@ extern E_OSAL_RET_STATUS_T osal_queue_send(void* const p_queue_handle, const voi
 extern E_OSAL_RET_STATUS_T osal_queue_receive(void* const p_queue_handle, void* const p_item, const uint32_t timeout_ms);
 extern E_OSAL_RET_STATUS_T osal_queue_space_get(void* const p_queue_handle, uint32_t* const p_space);
 
+extern E_OSAL_RET_STATUS_T osal_timer_create(void** const pp_timer_handle, const S_OSAL_TIMER_CONFIG_T* const p_timer_config);
+extern E_OSAL_RET_STATUS_T osal_timer_delete(void* const p_timer_handle);
+extern E_OSAL_RET_STATUS_T osal_timer_start(void* const p_timer_handle, const uint32_t period_ms);
+extern E_OSAL_RET_STATUS_T osal_timer_stop(void* const p_timer_handle);
+
 
 #endif /* __OSAL_CORE_H__ */
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include "osal_core.h"
 
 #include "cmsis_os2.h"
+#include "cmsis_compiler.h"
+#include "mcu_time.h"
 
 #include "stdint.h"
 
@@ -48,6 +50,15 @@ extern uint32_t osal_get_tick(void)
     return osKernelGetTickCount();
 }
 
+/**
+ * @brief   Get the time since boot in microseconds, for latency measurement
+ * @return  Microseconds
+ */
+extern uint64_t osal_get_time_us(void)
+{
+    return mcu_time_us_get();
+}
+
 extern E_OSAL_RET_STATUS_T osal_delay_ms(const uint32_t delay_ms)
  {
     osDelay(_osal_ms_to_os_tick(delay_ms) );
@@ -98,6 +109,29 @@ extern E_OSAL_RET_STATUS_T osal_thread_create(void** const pp_thread_handle, con
     return E_OSAL_RET_STATUS_OK;
 }
 
+extern void* osal_thread_self(void)
+{
+    /* osThreadGetId() returns the interrupted thread in ISR and the first created one before kernel start */
+    if ( (0U != __get_IPSR() ) || (osKernelRunning != osKernelGetState() ) )
+    {
+        return NULL;
+    }
+
+    /* Handle of the calling thread */
+    return (void*)osThreadGetId();
+}
+
+extern const char* osal_thread_name_get(void* const p_thread_handle)
+{
+    /* Check input parameter */
+    if (NULL == p_thread_handle)
+    {
+        return NULL;
+    }
+
+    return osThreadGetName( (osThreadId_t)p_thread_handle);
+}
+
 extern E_OSAL_RET_STATUS_T osal_mutex_create(void** const pp_mutex_handle, const S_OSAL_MUTEX_CONFIG_T* const p_mutex_config)
 {
     /* Check input parameter */
@@ -387,6 +421,94 @@ extern E_OSAL_RET_STATUS_T osal_queue_space_get(void* const p_queue_handle, uint
     return E_OSAL_RET_STATUS_OK;
 }
 
+extern E_OSAL_RET_STATUS_T osal_timer_create(void** const pp_timer_handle, const S_OSAL_TIMER_CONFIG_T* const p_timer_config)
+{
+    /* Check input parameters */
+    if (NULL == pp_timer_handle || NULL == p_timer_config || NULL == p_timer_config->p_callback)
+    {
+        return E_OSAL_RET_STATUS_INPUT_PARAM_ERROR;
+    }
+
+    /* Define timer attributes */
+    osTimerAttr_t timer_attr = 
+    {
+        .name = p_timer_config->p_name,
+        .attr_bits = 0,
+        .cb_mem = NULL,
+        .cb_size = 0,
+    };
+
+    /* Create timer */
+    osTimerType_t timer_type = (E_OSAL_TIMER_TYPE_PERIODIC == p_timer_config->type) ? osTimerPeriodic : osTimerOnce;
+    *pp_timer_handle = osTimerNew( (osTimerFunc_t)p_timer_config->p_callback, timer_type, p_timer_config->p_arg, &timer_attr);
+    if (NULL == *pp_timer_handle)
+    {
+        return E_OSAL_RET_STATUS_RESOURCE_ERROR;
+    }
+
+    return E_OSAL_RET_STATUS_OK;
+}
+
+extern E_OSAL_RET_STATUS_T osal_timer_delete(void* const p_timer_handle)
+{
+    /* Check input parameter */
+    if (NULL == p_timer_handle)
+    {
+        return E_OSAL_RET_STATUS_INPUT_PARAM_ERROR;
+    }
+
+    /* Delete timer */
+    osStatus_t status = osTimerDelete( (osTimerId_t)p_timer_handle);
+    if (osOK != status)
+    {
+        return E_OSAL_RET_STATUS_RESOURCE_ERROR;
+    }
+
+    return E_OSAL_RET_STATUS_OK;
+}
+
+extern E_OSAL_RET_STATUS_T osal_timer_start(void* const p_timer_handle, const uint32_t period_ms)
+{
+    /* Check input parameters */
+    if (NULL == p_timer_handle || 0 == period_ms)
+    {
+        return E_OSAL_RET_STATUS_INPUT_PARAM_ERROR;
+    }
+
+    /* Start (or restart) timer, period is at least one tick */
+    uint32_t period_tick = _osal_ms_to_os_tick(period_ms);
+    osStatus_t status = osTimerStart( (osTimerId_t)p_timer_handle, (0U == period_tick) ? 1U : period_tick);
+    if (osOK != status)
+    {
+        return E_OSAL_RET_STATUS_RESOURCE_ERROR;
+    }
+
+    return E_OSAL_RET_STATUS_OK;
+}
+
+extern E_OSAL_RET_STATUS_T osal_timer_stop(void* const p_timer_handle)
+{
+    /* Check input parameter */
+    if (NULL == p_timer_handle)
+    {
+        return E_OSAL_RET_STATUS_INPUT_PARAM_ERROR;
+    }
+
+    /* Stop timer, stopping a timer that is not running is not an error */
+    if (0U == osTimerIsRunning( (osTimerId_t)p_timer_handle) )
+    {
+        return E_OSAL_RET_STATUS_OK;
+    }
+
+    osStatus_t status = osTimerStop( (osTimerId_t)p_timer_handle);
+    if (osOK != status)
+    {
+        return E_OSAL_RET_STATUS_RESOURCE_ERROR;
+    }
+
+    return E_OSAL_RET_STATUS_OK;
+}
+
 
 /*==============================================================================
  * Static Function Implementation
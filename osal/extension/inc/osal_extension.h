@@ -7,6 +7,8 @@
 
 extern void osal_critical_enter(void);
 extern void osal_critical_exit(void);
+extern uint32_t osal_critical_enter_from_isr(void);
+extern void osal_critical_exit_from_isr(uint32_t);
 
 extern void* osal_mem_malloc(uint32_t);
 extern void osal_mem_free(void*);
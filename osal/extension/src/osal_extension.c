@@ -21,6 +21,32 @@ extern void osal_critical_exit(void)
 #endif
 }
 
+/**
+ * @brief   Enter a critical section in ISR or thread, unlike osal_critical_enter() it is legal in handler mode
+ * @return  Interrupt mask state to give back to osal_critical_exit_from_isr()
+ */
+extern uint32_t osal_critical_enter_from_isr(void)
+{
+#ifdef OSAL_EX_FREERTOS
+    return (uint32_t)taskENTER_CRITICAL_FROM_ISR();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief   Exit a critical section entered by osal_critical_enter_from_isr()
+ * @param   state Interrupt mask state it returned
+ */
+extern void osal_critical_exit_from_isr(uint32_t state)
+{
+#ifdef OSAL_EX_FREERTOS
+    taskEXIT_CRITICAL_FROM_ISR( (UBaseType_t)state);
+#else
+    (void)state;
+#endif
+}
+
 extern void* osal_mem_malloc(uint32_t size)
 {
 #ifdef OSAL_EX_FREERTOS
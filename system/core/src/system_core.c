@@ -8,6 +8,10 @@
 
 #include "osal.h"
 
+#include "crashlog.h"
+#include "elog.h"
+#include "tracer.h"
+
 #include "mcu.h"
 
 #include "stddef.h"
@@ -17,6 +21,7 @@
 #define D_SYSTEM_CORE_OS_THREAD_STACK_SIZE_BSP_SERIALPORT  (2048)
 #define D_SYSTEM_CORE_OS_THREAD_STACK_SIZE_APP_TEST        (2048)
 #define D_SYSTEM_CORE_OS_THREAD_STACK_SIZE_APP_SHELL       (2048)
+#define D_SYSTEM_CORE_OS_THREAD_STACK_SIZE_APP_SHELL_WORKER (2048)
 
 
 typedef enum
@@ -25,6 +30,7 @@ typedef enum
     E_SYSTEM_CORE_OS_THREAD_ID_BSP_SERIALPORT,
     E_SYSTEM_CORE_OS_THREAD_ID_APP_TEST,
     E_SYSTEM_CORE_OS_THREAD_ID_APP_SHELL,
+    E_SYSTEM_CORE_OS_THREAD_ID_APP_SHELL_WORKER,
     E_SYSTEM_CORE_OS_THREAD_ID_NUM_MAX,
 } E_SYSTEM_CORE_OS_THREAD_ID_T;
 
@@ -65,12 +71,29 @@ static S_OSAL_THREAD_CONFIG_T gs_system_os_thread_conf[] = {
     [E_SYSTEM_CORE_OS_THREAD_ID_APP_SHELL] = {
         .p_name     =   "APP Shell",
         .p_entry    =   app_shell_thread,
-        .p_arg      =   NULL,
+        .p_arg      =   (void*)E_APP_SHELL_SESSION_ID_SERIALPORT,
         .stack_size =   D_SYSTEM_CORE_OS_THREAD_STACK_SIZE_APP_SHELL,
+    },
+    /* APP Shell worker (runs shell commands, lower than APP Shell so input keeps being drained) */
+    [E_SYSTEM_CORE_OS_THREAD_ID_APP_SHELL_WORKER] = {
+        .p_name     =   "APP Shell Worker",
+        .p_entry    =   app_shell_worker_thread,
+        .p_arg      =   (void*)E_APP_SHELL_SESSION_ID_SERIALPORT,
+        .stack_size =   D_SYSTEM_CORE_OS_THREAD_STACK_SIZE_APP_SHELL_WORKER,
+        .priority   =   E_OSAL_THREAD_PRIORITY_NORMAL,
     }
 };
 
 
+/*==============================================================================
+ * Private Function Declaration
+ *============================================================================*/
+
+static void _system_core_fault_callback(const E_MCU_CORE_FAULT_TYPE_T);
+static void _system_core_elog_assert_hook(const char*, const char*, size_t);
+static void _system_core_crashlog_output(const char* const, const uint32_t);
+
+
 /*==============================================================================
  * External Function Implementation
  *============================================================================*/
@@ -86,6 +109,12 @@ static S_OSAL_THREAD_CONFIG_T gs_system_os_thread_conf[] = {
         return E_SYSTEM_CORE_RET_STATUS_ERROR;
     }
 
+    /* 1.1 Start tracer before any thread is created, dump it with the shell command trace */
+    if (E_TRACER_RET_STATUS_OK != tracer_init() )
+    {
+        return E_SYSTEM_CORE_RET_STATUS_ERROR;
+    }
+
     /* 2. Initialize BSP layer */
 
     /* 2.1. Initialize BSP LED and get thread entry */
@@ -112,6 +141,56 @@ static S_OSAL_THREAD_CONFIG_T gs_system_os_thread_conf[] = {
         return E_SYSTEM_CORE_RET_STATUS_ERROR;
     }
 
+    /* 2.3 Initialize crash log before any log is written, fault handlers seal it */
+    if (E_CRASHLOG_RET_STATUS_OK != crashlog_init() )
+    {
+        return E_SYSTEM_CORE_RET_STATUS_ERROR;
+    }
+
+    mcu_core_fault_callback_register(_system_core_fault_callback);
+
+    /* 2.4 Initialize log, output goes through BSP Serialport */
+    if (ELOG_NO_ERR != elog_init() )
+    {
+        return E_SYSTEM_CORE_RET_STATUS_ERROR;
+    }
+
+    elog_assert_set_hook(_system_core_elog_assert_hook);
+
+    elog_set_fmt(ELOG_LVL_ASSERT, ELOG_FMT_ALL & ~ELOG_FMT_P_INFO);
+    elog_set_fmt(ELOG_LVL_ERROR, ELOG_FMT_LVL | ELOG_FMT_TAG | ELOG_FMT_TIME | ELOG_FMT_T_INFO);
+    elog_set_fmt(ELOG_LVL_WARN, ELOG_FMT_LVL | ELOG_FMT_TAG | ELOG_FMT_TIME | ELOG_FMT_T_INFO);
+    elog_set_fmt(ELOG_LVL_INFO, ELOG_FMT_LVL | ELOG_FMT_TAG | ELOG_FMT_TIME);
+    elog_set_fmt(ELOG_LVL_DEBUG, ELOG_FMT_LVL | ELOG_FMT_TAG | ELOG_FMT_TIME);
+    elog_set_fmt(ELOG_LVL_VERBOSE, ELOG_FMT_LVL | ELOG_FMT_TAG | ELOG_FMT_TIME);
+    elog_start();
+
+    /**
+     * 2.5 Dump the previous run kept by crash log
+     * Raw output is not copied into crash log, so the dump does not pile up across reboots.
+     * It is queued in the async buffer until the serialport thread runs, which holds the whole ring
+     */
+    S_CRASHLOG_PREV_INFO_T crashlog_prev_info;
+    if (E_CRASHLOG_RET_STATUS_OK == crashlog_prev_info_get(&crashlog_prev_info) )
+    {
+        elog_raw_output("==== previous run (boot %lu, ended by %s, %lu bytes) ====" ELOG_NEWLINE_SIGN,
+                        (unsigned long)crashlog_prev_info.boot_count,
+                        crashlog_reason_name_get(crashlog_prev_info.reason),
+                        (unsigned long)crashlog_prev_info.size);
+        crashlog_prev_dump(_system_core_crashlog_output);
+        elog_raw_output("==== end of previous run ====" ELOG_NEWLINE_SIGN);
+
+        /* The same summary as a key-value record, so host tools can index resets without parsing text */
+        ElogKv kv;
+        if (elog_kv_begin(&kv, ELOG_LVL_INFO, ELOG_TAG_ID_SYSTEM, ELOG_KV_EVENT_ID_PREV_RUN) )
+        {
+            elog_kv_uint(&kv, ELOG_KV_FIELD_ID_BOOT_COUNT, crashlog_prev_info.boot_count);
+            elog_kv_str(&kv, ELOG_KV_FIELD_ID_REASON, crashlog_reason_name_get(crashlog_prev_info.reason) );
+            elog_kv_uint(&kv, ELOG_KV_FIELD_ID_SIZE, crashlog_prev_info.size);
+            elog_kv_end(&kv);
+        }
+    }
+
     /* 3. Initialize APP layer */
 
     /* 3.1 Initialize APP Test */
@@ -125,6 +204,7 @@ static S_OSAL_THREAD_CONFIG_T gs_system_os_thread_conf[] = {
     void* p_thread_handle_bsp_serialport    = NULL;
     void* p_thread_handle_app_test          = NULL;
     void* p_thread_handle_app_shell         = NULL;
+    void* p_thread_handle_app_shell_worker  = NULL;
 
     if (E_OSAL_RET_STATUS_OK != osal_thread_create(&p_thread_handle_bsp_led, &gs_system_os_thread_conf[E_SYSTEM_CORE_OS_THREAD_ID_BSP_LED]) )
     {
@@ -146,6 +226,11 @@ static S_OSAL_THREAD_CONFIG_T gs_system_os_thread_conf[] = {
        return E_SYSTEM_CORE_RET_STATUS_ERROR;
     }
 
+    if (E_OSAL_RET_STATUS_OK != osal_thread_create(&p_thread_handle_app_shell_worker, &gs_system_os_thread_conf[E_SYSTEM_CORE_OS_THREAD_ID_APP_SHELL_WORKER]) )
+    {
+       return E_SYSTEM_CORE_RET_STATUS_ERROR;
+    }
+
     return E_SYSTEM_CORE_RET_STATUS_OK;
 }
 
@@ -165,10 +250,43 @@ extern E_SYSTEM_CORE_RET_STATUS_T system_core_start(void)
 }
 
 
+/*==============================================================================
+ * Private Function Implementation
+ *============================================================================*/
 
+/**
+ * @brief   Fault handler callback, records the reason so the next boot reports it
+ * @param   fault_type Fault type
+ */
+static void _system_core_fault_callback(const E_MCU_CORE_FAULT_TYPE_T fault_type)
+{
+    crashlog_seal( (E_MCU_CORE_FAULT_TYPE_MEM_MANAGE == fault_type) ? E_CRASHLOG_REASON_MEM_MANAGE_FAULT : E_CRASHLOG_REASON_HARD_FAULT);
+}
 
+/**
+ * @brief   EasyLogger assert hook, same as the default one but seals the crash log before halting
+ * @param   expr Failed expression
+ * @param   func Function name
+ * @param   line Line number
+ */
+static void _system_core_elog_assert_hook(const char* expr, const char* func, size_t line)
+{
+    elog_a("elog", "(%s) has assert failed at %s:%lu.", expr, func, (unsigned long)line);
 
+    crashlog_seal(E_CRASHLOG_REASON_ASSERT);
 
+    while (1)
+    {
 
+    }
+}
 
-
+/**
+ * @brief   Output of crash log dump
+ * @param   p_data Data
+ * @param   size Data size
+ */
+static void _system_core_crashlog_output(const char* const p_data, const uint32_t size)
+{
+    elog_raw_output("%.*s", (int)size, p_data);
+}
@@ -0,0 +1,90 @@
+#ifndef __CRASHLOG_H__
+#define __CRASHLOG_H__
+
+
+/*==============================================================================
+ * Include
+ *============================================================================*/
+
+#include "stdint.h"
+
+
+/*==============================================================================
+ * Macro
+ *============================================================================*/
+
+/* Size of the log ring kept across resets, header not included */
+#ifndef D_CRASHLOG_DATA_SIZE
+#define D_CRASHLOG_DATA_SIZE                    (2048)
+#endif
+
+/* Space reserved in front of the ring for the header */
+#define D_CRASHLOG_HEADER_SIZE                  (32)
+
+/* Size of each piece handed to the output callback when dumping the previous run */
+#define D_CRASHLOG_DUMP_CHUNK_SIZE              (64)
+
+
+/*==============================================================================
+ * Enumeration
+ *============================================================================*/
+
+typedef enum
+{
+    E_CRASHLOG_RET_STATUS_OK = 0,
+    E_CRASHLOG_RET_STATUS_INPUT_PARAM_ERROR,
+    E_CRASHLOG_RET_STATUS_INIT_STATUS_ERROR,
+    E_CRASHLOG_RET_STATUS_RESOURCE_ERROR,
+    E_CRASHLOG_RET_STATUS_NO_DATA,
+} E_CRASHLOG_RET_STATUS_T;
+
+typedef enum
+{
+    E_CRASHLOG_INIT_STATUS_NO = 0,
+    E_CRASHLOG_INIT_STATUS_OK,
+} E_CRASHLOG_INIT_STATUS_T;
+
+typedef enum
+{
+    E_CRASHLOG_REASON_RESET = 0,        /* Not sealed: reset pin, watchdog, software reset */
+    E_CRASHLOG_REASON_HARD_FAULT,
+    E_CRASHLOG_REASON_MEM_MANAGE_FAULT,
+    E_CRASHLOG_REASON_ASSERT,
+    E_CRASHLOG_REASON_NUM_MAX,
+} E_CRASHLOG_REASON_T;
+
+
+/*==============================================================================
+ * Struct
+ *============================================================================*/
+
+/**
+ * @brief Previous run found in the ring at boot
+ */
+typedef struct
+{
+    E_CRASHLOG_REASON_T reason;
+    uint32_t            boot_count;     /* Boot number of the previous run */
+    uint32_t            size;           /* Bytes of the previous run still kept in the ring */
+} S_CRASHLOG_PREV_INFO_T;
+
+
+/*==============================================================================
+ * Type
+ *============================================================================*/
+
+typedef void (*PF_CRASHLOG_OUTPUT_T)(const char* const, const uint32_t);
+
+
+/*==============================================================================
+ * Public Function Declaration
+ *============================================================================*/
+
+extern E_CRASHLOG_RET_STATUS_T crashlog_init(void);
+extern void crashlog_write(const char* const, const uint32_t);
+extern void crashlog_seal(const E_CRASHLOG_REASON_T);
+extern E_CRASHLOG_RET_STATUS_T crashlog_prev_info_get(S_CRASHLOG_PREV_INFO_T* const);
+extern E_CRASHLOG_RET_STATUS_T crashlog_prev_dump(const PF_CRASHLOG_OUTPUT_T);
+extern const char* crashlog_reason_name_get(const E_CRASHLOG_REASON_T);
+
+#endif /* __CRASHLOG_H__ */
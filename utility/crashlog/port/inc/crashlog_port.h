@@ -0,0 +1,12 @@
+#ifndef __CRASHLOG_PORT_H__
+#define __CRASHLOG_PORT_H__
+
+
+#include "stdint.h"
+
+
+extern uint8_t* crashlog_port_region_get(uint32_t* const);
+extern void crashlog_port_lock(void);
+extern void crashlog_port_unlock(void);
+
+#endif /* __CRASHLOG_PORT_H__ */
@@ -0,0 +1,118 @@
+#include "crashlog_port.h"
+#include "crashlog.h"
+
+#include "stddef.h"
+
+#if defined(__linux__)
+#include "fcntl.h"
+#include "pthread.h"
+#include "stdlib.h"
+#include "sys/mman.h"
+#include "unistd.h"
+#else
+#include "osal_extension.h"
+#endif
+
+
+/*==============================================================================
+ * Macro
+ *============================================================================*/
+
+#define D_CRASHLOG_PORT_REGION_SIZE             (D_CRASHLOG_HEADER_SIZE + D_CRASHLOG_DATA_SIZE)
+
+#if defined(__linux__)
+/* Backing file of the region on host, CRASHLOG_FILE in environment overrides it */
+#define D_CRASHLOG_PORT_HOST_FILE               "crashlog.bin"
+#endif
+
+
+/*==============================================================================
+ * Global Variable
+ *============================================================================*/
+
+#if defined(__linux__)
+static uint8_t* gs_crashlog_port_region = NULL;
+static pthread_mutex_t gs_crashlog_port_mutex = PTHREAD_MUTEX_INITIALIZER;
+#else
+/* Placed in .noinit, startup code neither loads nor zeroes it so the content survives a reset */
+static uint8_t gs_crashlog_port_region[D_CRASHLOG_PORT_REGION_SIZE] __attribute__((section(".noinit"), aligned(4)));
+/* Interrupt mask saved by crashlog_port_lock(), the lock does not nest */
+static uint32_t gs_crashlog_port_lock_state = 0;
+#endif
+
+
+/*==============================================================================
+ * Public Function Implementation
+ *============================================================================*/
+
+/**
+ * @brief   Get the memory region kept across resets
+ * @param   p_size [out] Region size
+ * @return  Region, NULL if it is not available
+ */
+extern uint8_t* crashlog_port_region_get(uint32_t* const p_size)
+{
+    /* Check input parameter */
+    if (NULL == p_size)
+    {
+        return NULL;
+    }
+
+#if defined(__linux__)
+    /* A shared file mapping outlives the process, a killed process plays the reset */
+    if (NULL == gs_crashlog_port_region)
+    {
+        const char* p_path = getenv("CRASHLOG_FILE");
+        int fd = open( (NULL != p_path) ? p_path : D_CRASHLOG_PORT_HOST_FILE, O_RDWR | O_CREAT, 0644);
+        if (0 > fd)
+        {
+            return NULL;
+        }
+
+        if (0 != ftruncate(fd, D_CRASHLOG_PORT_REGION_SIZE) )
+        {
+            close(fd);
+            return NULL;
+        }
+
+        void* p_map = mmap(NULL, D_CRASHLOG_PORT_REGION_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (MAP_FAILED == p_map)
+        {
+            return NULL;
+        }
+
+        gs_crashlog_port_region = (uint8_t*)p_map;
+    }
+#endif
+
+    *p_size = D_CRASHLOG_PORT_REGION_SIZE;
+
+    return gs_crashlog_port_region;
+}
+
+/**
+ * @brief   Lock the ring, a critical section on target as a write is only a short copy
+ *          Writers run in ISR too (log output), so it is the variant legal in handler mode
+ */
+extern void crashlog_port_lock(void)
+{
+#if defined(__linux__)
+    pthread_mutex_lock(&gs_crashlog_port_mutex);
+#else
+    uint32_t state = osal_critical_enter_from_isr();
+    gs_crashlog_port_lock_state = state;
+#endif
+}
+
+/**
+ * @brief   Unlock the ring
+ */
+extern void crashlog_port_unlock(void)
+{
+#if defined(__linux__)
+    pthread_mutex_unlock(&gs_crashlog_port_mutex);
+#else
+    osal_critical_exit_from_isr(gs_crashlog_port_lock_state);
+#endif
+}
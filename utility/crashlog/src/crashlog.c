@@ -0,0 +1,419 @@
+/*==============================================================================
+ * Include
+ *============================================================================*/
+
+#include "crashlog.h"
+#include "crashlog_port.h"
+
+#include "stdbool.h"
+#include "stddef.h"
+#include "string.h"
+
+
+/*==============================================================================
+ * Macro
+ *============================================================================*/
+
+#define D_CRASHLOG_MAGIC                        (0x474F4C43UL)  /* "CLOG" */
+
+#define D_CRASHLOG_DATA_MASK                    (D_CRASHLOG_DATA_SIZE - 1)
+
+
+/*==============================================================================
+ * Struct
+ *============================================================================*/
+
+/**
+ * @brief Header in front of the ring
+ *        The fields covered by crc only change at boot and when the run is sealed,
+ *        head changes on every write and is guarded by its inverted copy instead
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t data_size;
+    uint32_t boot_count;
+    uint32_t start;         /* head when this run booted */
+    uint32_t reason;        /* E_CRASHLOG_REASON_T */
+    uint32_t crc;           /* CRC32 of the fields above */
+    uint32_t head;          /* Total bytes written, ring offset is head & D_CRASHLOG_DATA_MASK */
+    uint32_t head_inv;      /* ~head */
+} S_CRASHLOG_HEADER_T;
+
+typedef struct
+{
+    E_CRASHLOG_INIT_STATUS_T        is_inited;
+    volatile S_CRASHLOG_HEADER_T*   p_header;
+    uint8_t*                        p_data;
+    bool                            has_prev;
+    uint32_t                        prev_head;
+    S_CRASHLOG_PREV_INFO_T          prev_info;
+} S_CRASHLOG_T;
+
+_Static_assert(0 == (D_CRASHLOG_DATA_SIZE & D_CRASHLOG_DATA_MASK), "D_CRASHLOG_DATA_SIZE must be a power of two");
+_Static_assert(sizeof(S_CRASHLOG_HEADER_T) <= D_CRASHLOG_HEADER_SIZE, "D_CRASHLOG_HEADER_SIZE is too small");
+
+
+/*==============================================================================
+ * Global Variable
+ *============================================================================*/
+
+static S_CRASHLOG_T gs_crashlog = {0};
+
+static const char* const gs_crashlog_reason_name[E_CRASHLOG_REASON_NUM_MAX] = {
+    [E_CRASHLOG_REASON_RESET]               = "reset",
+    [E_CRASHLOG_REASON_HARD_FAULT]          = "hard fault",
+    [E_CRASHLOG_REASON_MEM_MANAGE_FAULT]    = "mem manage fault",
+    [E_CRASHLOG_REASON_ASSERT]              = "assert",
+};
+
+
+/*==============================================================================
+ * Private Function Declaration
+ *============================================================================*/
+
+static uint32_t _crashlog_header_crc_calc(const volatile S_CRASHLOG_HEADER_T* const);
+static bool _crashlog_header_is_valid(const volatile S_CRASHLOG_HEADER_T* const);
+static bool _crashlog_header_head_recover(volatile S_CRASHLOG_HEADER_T* const);
+
+
+/*==============================================================================
+ * Public Function Implementation
+ *============================================================================*/
+
+/**
+ * @brief   Take over the ring, the previous run is kept if the header survived the reset
+ *          Call it before any log is written, the new run is appended behind the previous one
+ * @return  E_CRASHLOG_RET_STATUS_T
+ */
+extern E_CRASHLOG_RET_STATUS_T crashlog_init(void)
+{
+    uint32_t region_size = 0;
+    uint8_t* p_region = crashlog_port_region_get(&region_size);
+    if (NULL == p_region || (D_CRASHLOG_HEADER_SIZE + D_CRASHLOG_DATA_SIZE) > region_size)
+    {
+        return E_CRASHLOG_RET_STATUS_RESOURCE_ERROR;
+    }
+
+    volatile S_CRASHLOG_HEADER_T* p_header = (volatile S_CRASHLOG_HEADER_T*)p_region;
+
+    gs_crashlog.p_header = p_header;
+    gs_crashlog.p_data = p_region + D_CRASHLOG_HEADER_SIZE;
+    gs_crashlog.has_prev = false;
+
+    if (true == _crashlog_header_is_valid(p_header) && true == _crashlog_header_head_recover(p_header) )
+    {
+        uint32_t prev_size = p_header->head - p_header->start;
+
+        gs_crashlog.has_prev = true;
+        gs_crashlog.prev_head = p_header->head;
+        gs_crashlog.prev_info.reason = (E_CRASHLOG_REASON_T)p_header->reason;
+        gs_crashlog.prev_info.boot_count = p_header->boot_count;
+        gs_crashlog.prev_info.size = (D_CRASHLOG_DATA_SIZE < prev_size) ? D_CRASHLOG_DATA_SIZE : prev_size;
+
+        p_header->boot_count++;
+    }
+    else
+    {
+        /* Power on or a broken header, nothing to keep */
+        p_header->magic = D_CRASHLOG_MAGIC;
+        p_header->data_size = D_CRASHLOG_DATA_SIZE;
+        p_header->boot_count = 1;
+        p_header->head = 0;
+        p_header->head_inv = 0xFFFFFFFFUL;
+    }
+
+    p_header->start = p_header->head;
+    p_header->reason = E_CRASHLOG_REASON_RESET;
+    p_header->crc = _crashlog_header_crc_calc(p_header);
+
+    gs_crashlog.is_inited = E_CRASHLOG_INIT_STATUS_OK;
+
+    return E_CRASHLOG_RET_STATUS_OK;
+}
+
+/**
+ * @brief   Append data to the ring, the oldest data is overwritten
+ *          Only a copy in a short critical section, data written before init is dropped
+ * @param   p_data Data
+ * @param   size Data size
+ */
+extern void crashlog_write(const char* const p_data, const uint32_t size)
+{
+    /* Check input parameter */
+    if (NULL == p_data || 0 == size)
+    {
+        return;
+    }
+
+    if (E_CRASHLOG_INIT_STATUS_OK != gs_crashlog.is_inited)
+    {
+        return;
+    }
+
+    /* Only the tail fits */
+    const char* p_src = p_data;
+    uint32_t write_size = size;
+    if (D_CRASHLOG_DATA_SIZE < write_size)
+    {
+        p_src += write_size - D_CRASHLOG_DATA_SIZE;
+        write_size = D_CRASHLOG_DATA_SIZE;
+    }
+
+    crashlog_port_lock();
+
+    uint32_t head = gs_crashlog.p_header->head;
+    uint32_t offset = head & D_CRASHLOG_DATA_MASK;
+    uint32_t first_size = D_CRASHLOG_DATA_SIZE - offset;
+    if (first_size > write_size)
+    {
+        first_size = write_size;
+    }
+
+    memcpy(&gs_crashlog.p_data[offset], p_src, first_size);
+    memcpy(&gs_crashlog.p_data[0], p_src + first_size, write_size - first_size);
+
+    /*
+     * Data first, then head, then head_inv
+     * A reset before head is stored loses only this write,
+     * a reset between head and head_inv is settled by _crashlog_header_head_recover() at boot
+     */
+    head += write_size;
+    gs_crashlog.p_header->head = head;
+    gs_crashlog.p_header->head_inv = ~head;
+
+    crashlog_port_unlock();
+}
+
+/**
+ * @brief   Record why this run ends, called from fault handlers so it takes no lock
+ * @param   reason Reason
+ */
+extern void crashlog_seal(const E_CRASHLOG_REASON_T reason)
+{
+    if (E_CRASHLOG_INIT_STATUS_OK != gs_crashlog.is_inited || E_CRASHLOG_REASON_NUM_MAX <= reason)
+    {
+        return;
+    }
+
+    gs_crashlog.p_header->reason = reason;
+    gs_crashlog.p_header->crc = _crashlog_header_crc_calc(gs_crashlog.p_header);
+}
+
+/**
+ * @brief   Get the previous run found at boot
+ * @param   p_info [out] Previous run information
+ * @return  E_CRASHLOG_RET_STATUS_NO_DATA if the ring held no valid previous run
+ */
+extern E_CRASHLOG_RET_STATUS_T crashlog_prev_info_get(S_CRASHLOG_PREV_INFO_T* const p_info)
+{
+    /* Check input parameter */
+    if (NULL == p_info)
+    {
+        return E_CRASHLOG_RET_STATUS_INPUT_PARAM_ERROR;
+    }
+
+    if (E_CRASHLOG_INIT_STATUS_OK != gs_crashlog.is_inited)
+    {
+        return E_CRASHLOG_RET_STATUS_INIT_STATUS_ERROR;
+    }
+
+    if (false == gs_crashlog.has_prev)
+    {
+        return E_CRASHLOG_RET_STATUS_NO_DATA;
+    }
+
+    *p_info = gs_crashlog.prev_info;
+
+    return E_CRASHLOG_RET_STATUS_OK;
+}
+
+/**
+ * @brief   Output the tail of the previous run, oldest first
+ *          The current run keeps writing meanwhile and overwrites the oldest part of it,
+ *          whatever is overwritten before being read is skipped up to the next complete line
+ * @param   pf_output Output callback, may block
+ * @return  E_CRASHLOG_RET_STATUS_T
+ */
+extern E_CRASHLOG_RET_STATUS_T crashlog_prev_dump(const PF_CRASHLOG_OUTPUT_T pf_output)
+{
+    /* Check input parameter */
+    if (NULL == pf_output)
+    {
+        return E_CRASHLOG_RET_STATUS_INPUT_PARAM_ERROR;
+    }
+
+    if (E_CRASHLOG_INIT_STATUS_OK != gs_crashlog.is_inited)
+    {
+        return E_CRASHLOG_RET_STATUS_INIT_STATUS_ERROR;
+    }
+
+    if (false == gs_crashlog.has_prev)
+    {
+        return E_CRASHLOG_RET_STATUS_NO_DATA;
+    }
+
+    char chunk[D_CRASHLOG_DUMP_CHUNK_SIZE];
+    const uint32_t end = gs_crashlog.prev_head;
+    uint32_t pos = end - gs_crashlog.prev_info.size;
+    /* The kept part of a long run starts in the middle of a line */
+    bool skip_line = (D_CRASHLOG_DATA_SIZE == gs_crashlog.prev_info.size);
+
+    while (pos != end)
+    {
+        crashlog_port_lock();
+
+        uint32_t head = gs_crashlog.p_header->head;
+        if (D_CRASHLOG_DATA_SIZE < head - pos)
+        {
+            pos = head - D_CRASHLOG_DATA_SIZE;
+            skip_line = true;
+        }
+
+        /* Overwritten up to or past the end */
+        if (0 >= (int32_t)(end - pos) )
+        {
+            crashlog_port_unlock();
+            break;
+        }
+
+        uint32_t read_size = end - pos;
+        if (sizeof(chunk) < read_size)
+        {
+            read_size = sizeof(chunk);
+        }
+
+        uint32_t offset = pos & D_CRASHLOG_DATA_MASK;
+        uint32_t first_size = D_CRASHLOG_DATA_SIZE - offset;
+        if (first_size > read_size)
+        {
+            first_size = read_size;
+        }
+
+        memcpy(chunk, &gs_crashlog.p_data[offset], first_size);
+        memcpy(chunk + first_size, &gs_crashlog.p_data[0], read_size - first_size);
+
+        crashlog_port_unlock();
+
+        pos += read_size;
+
+        const char* p_out = chunk;
+        uint32_t out_size = read_size;
+        if (true == skip_line)
+        {
+            const char* p_newline = memchr(chunk, '\n', read_size);
+            if (NULL == p_newline)
+            {
+                continue;
+            }
+
+            skip_line = false;
+            p_out = p_newline + 1;
+            out_size = read_size - (uint32_t)(p_out - chunk);
+        }
+
+        if (0 < out_size)
+        {
+            pf_output(p_out, out_size);
+        }
+    }
+
+    return E_CRASHLOG_RET_STATUS_OK;
+}
+
+/**
+ * @brief   Get the printable name of a reason
+ * @param   reason Reason
+ * @return  Name
+ */
+extern const char* crashlog_reason_name_get(const E_CRASHLOG_REASON_T reason)
+{
+    if (E_CRASHLOG_REASON_NUM_MAX <= reason)
+    {
+        return "unknown";
+    }
+
+    return gs_crashlog_reason_name[reason];
+}
+
+
+/*==============================================================================
+ * Private Function Implementation
+ *============================================================================*/
+
+/**
+ * @brief   CRC32 (IEEE 802.3) of the header fields in front of crc, bitwise as it only runs at boot and seal
+ * @param   p_header Header
+ * @return  CRC32
+ */
+static uint32_t _crashlog_header_crc_calc(const volatile S_CRASHLOG_HEADER_T* const p_header)
+{
+    const uint32_t fields[] = {
+        p_header->magic,
+        p_header->data_size,
+        p_header->boot_count,
+        p_header->start,
+        p_header->reason,
+    };
+    const uint8_t* p_byte = (const uint8_t*)fields;
+    uint32_t crc = 0xFFFFFFFFUL;
+
+    for (uint32_t i = 0; i < sizeof(fields); i++)
+    {
+        crc ^= p_byte[i];
+        for (uint32_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1UL) ) );
+        }
+    }
+
+    return ~crc;
+}
+
+/**
+ * @brief   Check whether the header left by the previous run can be trusted
+ * @param   p_header Header
+ * @return  true if valid
+ */
+static bool _crashlog_header_is_valid(const volatile S_CRASHLOG_HEADER_T* const p_header)
+{
+    if (D_CRASHLOG_MAGIC != p_header->magic || D_CRASHLOG_DATA_SIZE != p_header->data_size)
+    {
+        return false;
+    }
+
+    if (_crashlog_header_crc_calc(p_header) != p_header->crc)
+    {
+        return false;
+    }
+
+    return (E_CRASHLOG_REASON_NUM_MAX > p_header->reason);
+}
+
+/**
+ * @brief   Settle head left by the previous run
+ *          head and head_inv are two stores, a reset between them leaves head one write ahead of ~head_inv,
+ *          the data of that write is already in the ring so head is kept and head_inv is repaired
+ * @param   p_header Header with valid fixed fields
+ * @return  true if head can be trusted
+ */
+static bool _crashlog_header_head_recover(volatile S_CRASHLOG_HEADER_T* const p_header)
+{
+    uint32_t head = p_header->head;
+    uint32_t advance = head - (uint32_t)~p_header->head_inv;
+
+    if (0 == advance)
+    {
+        return true;
+    }
+
+    /* One write advances head by at most the ring size, anything else is not an interrupted write */
+    if (D_CRASHLOG_DATA_SIZE < advance)
+    {
+        return false;
+    }
+
+    p_header->head_inv = ~head;
+
+    return true;
+}
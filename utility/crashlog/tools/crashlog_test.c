@@ -0,0 +1,215 @@
+/*==============================================================================
+ * Host test of the crash log on the mmap backend
+ *
+ * The region is a shared file mapping, a child process that exits without any
+ * cleanup plays the reset and crashlog_init() in the parent plays the next boot.
+ * A reset between the two head stores of crashlog_write() is replayed by
+ * rewinding head_inv in the mapped header.
+ *
+ * Build and run on host:
+ *   gcc -O2 -std=gnu11 -I../inc -I../port/inc ../src/crashlog.c ../port/src/crashlog_port.c \
+ *       crashlog_test.c -lpthread -o crashlog_test
+ *   ./crashlog_test
+ *============================================================================*/
+
+#include "crashlog.h"
+#include "crashlog_port.h"
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "sys/wait.h"
+#include "unistd.h"
+
+
+/*==============================================================================
+ * Macro
+ *============================================================================*/
+
+/* Word offsets in the header, see S_CRASHLOG_HEADER_T */
+#define D_CRASHLOG_TEST_HEADER_HEAD             (6)
+#define D_CRASHLOG_TEST_HEADER_HEAD_INV         (7)
+
+#define D_CRASHLOG_TEST_DUMP_SIZE               (D_CRASHLOG_DATA_SIZE)
+
+
+/*==============================================================================
+ * Global Variable
+ *============================================================================*/
+
+static char gs_test_dump[D_CRASHLOG_TEST_DUMP_SIZE + 1];
+static uint32_t gs_test_dump_size = 0;
+static unsigned int gs_test_failed = 0;
+
+
+/*==============================================================================
+ * Private Function Implementation
+ *============================================================================*/
+
+static void _test_expect(const char* p_case, int condition, const char* p_what)
+{
+    if (!condition)
+    {
+        printf("FAIL %s: %s\n", p_case, p_what);
+        gs_test_failed++;
+    }
+}
+
+static void _test_dump_output(const char* const p_data, const uint32_t data_size)
+{
+    uint32_t copy_size = D_CRASHLOG_TEST_DUMP_SIZE - gs_test_dump_size;
+    if (copy_size > data_size)
+    {
+        copy_size = data_size;
+    }
+    memcpy(gs_test_dump + gs_test_dump_size, p_data, copy_size);
+    gs_test_dump_size += copy_size;
+    gs_test_dump[gs_test_dump_size] = '\0';
+}
+
+/* Boot again on the same region and dump what the previous run left */
+static E_CRASHLOG_RET_STATUS_T _test_reboot(S_CRASHLOG_PREV_INFO_T* const p_info)
+{
+    gs_test_dump_size = 0;
+    gs_test_dump[0] = '\0';
+    memset(p_info, 0, sizeof(*p_info) );
+
+    if (E_CRASHLOG_RET_STATUS_OK != crashlog_init() )
+    {
+        return E_CRASHLOG_RET_STATUS_RESOURCE_ERROR;
+    }
+
+    E_CRASHLOG_RET_STATUS_T ret = crashlog_prev_info_get(p_info);
+    if (E_CRASHLOG_RET_STATUS_OK == ret)
+    {
+        crashlog_prev_dump(_test_dump_output);
+    }
+    return ret;
+}
+
+static volatile uint32_t* _test_header_get(void)
+{
+    uint32_t region_size = 0;
+    return (volatile uint32_t*)crashlog_port_region_get(&region_size);
+}
+
+static void _test_killed_process(void)
+{
+    S_CRASHLOG_PREV_INFO_T info;
+
+    pid_t pid = fork();
+    if (0 == pid)
+    {
+        crashlog_init();
+        crashlog_write("child line\n", 11);
+        crashlog_seal(E_CRASHLOG_REASON_HARD_FAULT);
+        _exit(0);
+    }
+    waitpid(pid, NULL, 0);
+
+    /* First boot of this process maps the file the child left behind */
+    _test_expect("killed", E_CRASHLOG_RET_STATUS_OK == _test_reboot(&info), "previous run lost");
+    _test_expect("killed", E_CRASHLOG_REASON_HARD_FAULT == info.reason, "seal reason lost");
+    _test_expect("killed", 11 == info.size, "wrong previous size");
+    _test_expect("killed", 0 == strcmp(gs_test_dump, "child line\n"), "wrong previous content");
+}
+
+static void _test_reset_run(void)
+{
+    S_CRASHLOG_PREV_INFO_T info;
+    uint32_t boot_count = 0;
+
+    crashlog_write("first\n", 6);
+    crashlog_write("second\n", 7);
+    crashlog_prev_info_get(&info);
+    boot_count = info.boot_count + 1;
+
+    _test_expect("reset", E_CRASHLOG_RET_STATUS_OK == _test_reboot(&info), "previous run lost");
+    _test_expect("reset", E_CRASHLOG_REASON_RESET == info.reason, "unsealed run not a reset");
+    _test_expect("reset", boot_count == info.boot_count, "wrong boot count");
+    _test_expect("reset", 0 == strcmp(gs_test_dump, "first\nsecond\n"), "wrong previous content");
+}
+
+static void _test_torn_head(void)
+{
+    S_CRASHLOG_PREV_INFO_T info;
+    volatile uint32_t* p_header = _test_header_get();
+
+    crashlog_write("kept\n", 5);
+
+    /* Reset after head was stored but before head_inv */
+    p_header[D_CRASHLOG_TEST_HEADER_HEAD_INV] = ~(p_header[D_CRASHLOG_TEST_HEADER_HEAD] - 5);
+
+    _test_expect("torn head", E_CRASHLOG_RET_STATUS_OK == _test_reboot(&info), "previous run discarded");
+    _test_expect("torn head", 0 == strcmp(gs_test_dump, "kept\n"), "last write lost");
+    _test_expect("torn head", p_header[D_CRASHLOG_TEST_HEADER_HEAD] == ~p_header[D_CRASHLOG_TEST_HEADER_HEAD_INV],
+                 "head_inv not repaired");
+}
+
+static void _test_broken_head(void)
+{
+    S_CRASHLOG_PREV_INFO_T info;
+    volatile uint32_t* p_header = _test_header_get();
+
+    crashlog_write("lost\n", 5);
+
+    /* Further apart than one write can move head */
+    p_header[D_CRASHLOG_TEST_HEADER_HEAD_INV] = ~(p_header[D_CRASHLOG_TEST_HEADER_HEAD] - D_CRASHLOG_DATA_SIZE - 1);
+
+    _test_expect("broken head", E_CRASHLOG_RET_STATUS_NO_DATA == _test_reboot(&info), "broken head trusted");
+}
+
+static void _test_wrap(void)
+{
+    S_CRASHLOG_PREV_INFO_T info;
+    char line[32];
+
+    _test_reboot(&info);
+    for (uint32_t i = 0; i < D_CRASHLOG_DATA_SIZE / 8; i++)
+    {
+        int len = snprintf(line, sizeof(line), "line %lu\n", (unsigned long)i);
+        crashlog_write(line, (uint32_t)len);
+    }
+
+    _test_expect("wrap", E_CRASHLOG_RET_STATUS_OK == _test_reboot(&info), "previous run lost");
+    _test_expect("wrap", D_CRASHLOG_DATA_SIZE == info.size, "ring not full");
+    /* Oldest partial line is skipped, the newest line is last */
+    snprintf(line, sizeof(line), "line %lu\n", (unsigned long)(D_CRASHLOG_DATA_SIZE / 8 - 1) );
+    _test_expect("wrap", 0 == strncmp(gs_test_dump, "line ", 5), "dump starts inside a line");
+    _test_expect("wrap", gs_test_dump_size >= strlen(line)
+                 && 0 == strcmp(gs_test_dump + gs_test_dump_size - strlen(line), line), "newest line missing");
+}
+
+
+/*==============================================================================
+ * Main
+ *============================================================================*/
+
+int main(void)
+{
+    char path[] = "/tmp/crashlog_test_XXXXXX";
+    int fd = mkstemp(path);
+    if (0 > fd)
+    {
+        printf("no temporary file\n");
+        return 1;
+    }
+    close(fd);
+    setenv("CRASHLOG_FILE", path, 1);
+
+    _test_killed_process();
+    _test_reset_run();
+    _test_torn_head();
+    _test_broken_head();
+    _test_wrap();
+
+    unlink(path);
+
+    if (0 != gs_test_failed)
+    {
+        printf("%u check(s) failed\n", gs_test_failed);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
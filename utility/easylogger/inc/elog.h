@@ -194,8 +194,64 @@ typedef struct {
 /* EasyLogger error code */
 typedef enum {
     ELOG_NO_ERR,
+    ELOG_RES_ERR,   /* OS resource (lock, thread, semaphore) create failed */
+    ELOG_FLASH_ERR, /* flash plugin device read, write or erase failed */
 } ElogErrCode;
 
+/* declared tag ID, see elog_tag_cfg.h */
+typedef enum {
+#define ELOG_TAG_DEF(id, name)               ELOG_TAG_ID_##id,
+#include <elog_tag_cfg.h>
+#undef ELOG_TAG_DEF
+    ELOG_TAG_ID_NUM,
+} ElogTagId;
+
+/* declared key-value log event and field ID, see elog_kv_cfg.h */
+typedef enum {
+#define ELOG_KV_EVENT_DEF(id, name)          ELOG_KV_EVENT_ID_##id,
+#define ELOG_KV_FIELD_DEF(id, name)
+#include <elog_kv_cfg.h>
+#undef ELOG_KV_EVENT_DEF
+#undef ELOG_KV_FIELD_DEF
+    ELOG_KV_EVENT_ID_NUM,
+} ElogKvEventId;
+
+typedef enum {
+#define ELOG_KV_EVENT_DEF(id, name)
+#define ELOG_KV_FIELD_DEF(id, name)          ELOG_KV_FIELD_ID_##id,
+#include <elog_kv_cfg.h>
+#undef ELOG_KV_EVENT_DEF
+#undef ELOG_KV_FIELD_DEF
+    ELOG_KV_FIELD_ID_NUM,
+} ElogKvFieldId;
+
+/* key-value log record under construction, lives on the caller's stack, see elog_kv.c */
+#ifndef ELOG_KV_FRAME_MAX_SIZE
+#define ELOG_KV_FRAME_MAX_SIZE               96
+#endif
+typedef struct {
+    uint8_t frame[ELOG_KV_FRAME_MAX_SIZE];
+    uint8_t len;            /**< frame bytes used */
+    uint8_t map_pos;        /**< position of the map head */
+    uint8_t field_num;      /**< fields in the map */
+    uint8_t level;
+    uint8_t tag_id;
+    bool truncated;         /**< a field did not fit and was dropped */
+} ElogKv;
+
+/* per-callsite rate limit state, see elog_limit.c */
+typedef struct {
+    uint32_t last_tick;     /**< tick of the last refill */
+    uint32_t tokens;        /**< token bucket, in 1/1000 token */
+    uint16_t suppressed;    /**< logs suppressed since the last output */
+    uint16_t sample;        /**< sampling counter */
+} ElogLimit;
+#define ELOG_LIMIT_INIT                      { 0, ELOG_LIMIT_BURST * 1000, 0, 0 }
+
+/* effective level of each declared tag, -1 when the tag is filtered out or output is disabled */
+extern int8_t elog_tag_lvl[ELOG_TAG_ID_NUM];
+extern const char * const elog_tag_name[ELOG_TAG_ID_NUM];
+
 /* elog.c */
 ElogErrCode elog_init(void);
 void elog_deinit(void);
@@ -208,6 +264,7 @@ bool elog_get_text_color_enabled(void);
 void elog_set_fmt(uint8_t level, size_t set);
 void elog_set_filter(uint8_t level, const char *tag, const char *keyword);
 void elog_set_filter_lvl(uint8_t level);
+uint8_t elog_get_filter_lvl(void);
 void elog_set_filter_tag(const char *tag);
 void elog_set_filter_kw(const char *keyword);
 void elog_set_filter_tag_lvl(const char *tag, uint8_t level);
@@ -215,6 +272,8 @@ uint8_t elog_get_filter_tag_lvl(const char *tag);
 void elog_raw_output(const char *format, ...);
 void elog_output(uint8_t level, const char *tag, const char *file, const char *func,
         const long line, const char *format, ...);
+void elog_output_id(uint8_t level, ElogTagId tag_id, const char *file, const char *func,
+        const long line, const char *format, ...);
 void elog_output_lock_enabled(bool enabled);
 extern void (*elog_assert_hook)(const char* expr, const char* func, size_t line);
 void elog_assert_set_hook(void (*hook)(const char* expr, const char* func, size_t line));
@@ -229,43 +288,84 @@ void elog_hexdump(const char *name, uint8_t width, const void *buf, uint16_t siz
 #define elog_d(tag, ...)     elog_debug(tag, __VA_ARGS__)
 #define elog_v(tag, ...)     elog_verbose(tag, __VA_ARGS__)
 
+/**
+ * per-callsite rate limit of declared tag logs, each callsite owns a static ElogLimit
+ */
+#ifdef ELOG_LIMIT_ENABLE
+    #define ELOG_LIMIT_DEFINE(name)              static ElogLimit name = ELOG_LIMIT_INIT
+    #define ELOG_LIMIT_PASS(limit, level, tag_id) elog_limit_pass(limit, level, tag_id)
+#else
+    #define ELOG_LIMIT_DEFINE(name)
+    #define ELOG_LIMIT_PASS(limit, level, tag_id) (true)
+#endif /* ELOG_LIMIT_ENABLE */
+
+/**
+ * declared tag API, the level is checked inline before any call
+ */
+#ifdef ELOG_OUTPUT_ENABLE
+    #define elog_id(level, tag_id, ...)                                                      \
+            do {                                                                             \
+                if ((level) <= ELOG_OUTPUT_LVL && (int8_t)(level) <= elog_tag_lvl[tag_id]) { \
+                    ELOG_LIMIT_DEFINE(elog_limit_);                                          \
+                    if (ELOG_LIMIT_PASS(&elog_limit_, level, tag_id)) {                      \
+                        elog_output_id(level, tag_id, ELOG_OUTPUT_DIR, ELOG_OUTPUT_FUNC,     \
+                                ELOG_OUTPUT_LINE, __VA_ARGS__);                              \
+                    }                                                                        \
+                }                                                                            \
+            } while (0)
+#else
+    #define elog_id(level, tag_id, ...)
+#endif /* ELOG_OUTPUT_ENABLE */
+#define elog_id_a(tag_id, ...)   elog_id(ELOG_LVL_ASSERT, tag_id, __VA_ARGS__)
+#define elog_id_e(tag_id, ...)   elog_id(ELOG_LVL_ERROR, tag_id, __VA_ARGS__)
+#define elog_id_w(tag_id, ...)   elog_id(ELOG_LVL_WARN, tag_id, __VA_ARGS__)
+#define elog_id_i(tag_id, ...)   elog_id(ELOG_LVL_INFO, tag_id, __VA_ARGS__)
+#define elog_id_d(tag_id, ...)   elog_id(ELOG_LVL_DEBUG, tag_id, __VA_ARGS__)
+#define elog_id_v(tag_id, ...)   elog_id(ELOG_LVL_VERBOSE, tag_id, __VA_ARGS__)
+
 /**
  * log API short definition
- * NOTE: The `LOG_TAG` and `LOG_LVL` must defined before including the <elog.h> when you want to use log_x API.
+ * NOTE: The `LOG_TAG` (or `LOG_TAG_ID`) and `LOG_LVL` must defined before including the <elog.h> when you want to use log_x API.
  */
-#if !defined(LOG_TAG)
-    #define LOG_TAG          "NO_TAG"
+#if defined(LOG_TAG_ID)
+    #define LOG_TAG          elog_tag_name[LOG_TAG_ID]
+    #define ELOG_LOG_X(level, x, ...)    elog_id(level, LOG_TAG_ID, __VA_ARGS__)
+#else
+    #if !defined(LOG_TAG)
+        #define LOG_TAG      "NO_TAG"
+    #endif
+    #define ELOG_LOG_X(level, x, ...)    elog_##x(LOG_TAG, __VA_ARGS__)
 #endif
 #if !defined(LOG_LVL)
     #define LOG_LVL          ELOG_LVL_VERBOSE
 #endif
 #if LOG_LVL >= ELOG_LVL_ASSERT
-    #define log_a(...)       elog_a(LOG_TAG, __VA_ARGS__)
+    #define log_a(...)       ELOG_LOG_X(ELOG_LVL_ASSERT, a, __VA_ARGS__)
 #else
     #define log_a(...)       ((void)0);
 #endif
 #if LOG_LVL >= ELOG_LVL_ERROR
-    #define log_e(...)       elog_e(LOG_TAG, __VA_ARGS__)
+    #define log_e(...)       ELOG_LOG_X(ELOG_LVL_ERROR, e, __VA_ARGS__)
 #else
     #define log_e(...)       ((void)0);
 #endif
 #if LOG_LVL >= ELOG_LVL_WARN
-    #define log_w(...)       elog_w(LOG_TAG, __VA_ARGS__)
+    #define log_w(...)       ELOG_LOG_X(ELOG_LVL_WARN, w, __VA_ARGS__)
 #else
     #define log_w(...)       ((void)0);
 #endif
 #if LOG_LVL >= ELOG_LVL_INFO
-    #define log_i(...)       elog_i(LOG_TAG, __VA_ARGS__)
+    #define log_i(...)       ELOG_LOG_X(ELOG_LVL_INFO, i, __VA_ARGS__)
 #else
     #define log_i(...)       ((void)0);
 #endif
 #if LOG_LVL >= ELOG_LVL_DEBUG
-    #define log_d(...)       elog_d(LOG_TAG, __VA_ARGS__)
+    #define log_d(...)       ELOG_LOG_X(ELOG_LVL_DEBUG, d, __VA_ARGS__)
 #else
     #define log_d(...)       ((void)0);
 #endif
 #if LOG_LVL >= ELOG_LVL_VERBOSE
-    #define log_v(...)       elog_v(LOG_TAG, __VA_ARGS__)
+    #define log_v(...)       ELOG_LOG_X(ELOG_LVL_VERBOSE, v, __VA_ARGS__)
 #else
     #define log_v(...)       ((void)0);
 #endif
@@ -275,6 +375,87 @@ void elog_hexdump(const char *name, uint8_t width, const void *buf, uint16_t siz
     #define assert           ELOG_ASSERT
 #endif
 
+/* elog_bin.c */
+/* binary frame sync byte and truncated flag in the level byte */
+#define ELOG_BIN_SYNC                        0xEB
+#define ELOG_BIN_LVL_TRUNCATED               0x80
+void elog_bin_output(uint8_t level, const char *tag, const char *format, ...);
+
+/**
+ * binary log API, same usage as elog_x/log_x, falls back to text output when binary mode is disabled
+ * NOTE: The tag and format must be string literals, the host tool reads them from the ELF file.
+ */
+#if defined(ELOG_OUTPUT_ENABLE) && defined(ELOG_BIN_OUTPUT_ENABLE)
+    #define elog_bin(level, tag, ...)    elog_bin_output(level, tag, __VA_ARGS__)
+#elif defined(ELOG_OUTPUT_ENABLE)
+    #define elog_bin(level, tag, ...) \
+            elog_output(level, tag, ELOG_OUTPUT_DIR, ELOG_OUTPUT_FUNC, ELOG_OUTPUT_LINE, __VA_ARGS__)
+#else
+    #define elog_bin(level, tag, ...)
+#endif
+#define elog_bin_a(tag, ...)     elog_bin(ELOG_LVL_ASSERT, tag, __VA_ARGS__)
+#define elog_bin_e(tag, ...)     elog_bin(ELOG_LVL_ERROR, tag, __VA_ARGS__)
+#define elog_bin_w(tag, ...)     elog_bin(ELOG_LVL_WARN, tag, __VA_ARGS__)
+#define elog_bin_i(tag, ...)     elog_bin(ELOG_LVL_INFO, tag, __VA_ARGS__)
+#define elog_bin_d(tag, ...)     elog_bin(ELOG_LVL_DEBUG, tag, __VA_ARGS__)
+#define elog_bin_v(tag, ...)     elog_bin(ELOG_LVL_VERBOSE, tag, __VA_ARGS__)
+
+#if LOG_LVL >= ELOG_LVL_ASSERT && ELOG_OUTPUT_LVL >= ELOG_LVL_ASSERT
+    #define log_bin_a(...)   elog_bin_a(LOG_TAG, __VA_ARGS__)
+#else
+    #define log_bin_a(...)   ((void)0);
+#endif
+#if LOG_LVL >= ELOG_LVL_ERROR && ELOG_OUTPUT_LVL >= ELOG_LVL_ERROR
+    #define log_bin_e(...)   elog_bin_e(LOG_TAG, __VA_ARGS__)
+#else
+    #define log_bin_e(...)   ((void)0);
+#endif
+#if LOG_LVL >= ELOG_LVL_WARN && ELOG_OUTPUT_LVL >= ELOG_LVL_WARN
+    #define log_bin_w(...)   elog_bin_w(LOG_TAG, __VA_ARGS__)
+#else
+    #define log_bin_w(...)   ((void)0);
+#endif
+#if LOG_LVL >= ELOG_LVL_INFO && ELOG_OUTPUT_LVL >= ELOG_LVL_INFO
+    #define log_bin_i(...)   elog_bin_i(LOG_TAG, __VA_ARGS__)
+#else
+    #define log_bin_i(...)   ((void)0);
+#endif
+#if LOG_LVL >= ELOG_LVL_DEBUG && ELOG_OUTPUT_LVL >= ELOG_LVL_DEBUG
+    #define log_bin_d(...)   elog_bin_d(LOG_TAG, __VA_ARGS__)
+#else
+    #define log_bin_d(...)   ((void)0);
+#endif
+#if LOG_LVL >= ELOG_LVL_VERBOSE && ELOG_OUTPUT_LVL >= ELOG_LVL_VERBOSE
+    #define log_bin_v(...)   elog_bin_v(LOG_TAG, __VA_ARGS__)
+#else
+    #define log_bin_v(...)   ((void)0);
+#endif
+
+/* elog_limit.c */
+bool elog_limit_pass(ElogLimit *limit, uint8_t level, ElogTagId tag_id);
+uint32_t elog_limit_get_drop_count(void);
+
+/* elog_kv.c */
+/* key-value frame sync byte, the frame is SYNC | LEN | CBOR record | XOR */
+#define ELOG_KV_SYNC                         0xEC
+#ifdef ELOG_KV_ENABLE
+bool elog_kv_begin(ElogKv *kv, uint8_t level, ElogTagId tag_id, ElogKvEventId event_id);
+void elog_kv_uint(ElogKv *kv, ElogKvFieldId field_id, uint32_t value);
+void elog_kv_int(ElogKv *kv, ElogKvFieldId field_id, int32_t value);
+void elog_kv_bool(ElogKv *kv, ElogKvFieldId field_id, bool value);
+void elog_kv_float(ElogKv *kv, ElogKvFieldId field_id, float value);
+void elog_kv_str(ElogKv *kv, ElogKvFieldId field_id, const char *value);
+void elog_kv_end(ElogKv *kv);
+#else
+    #define elog_kv_begin(kv, level, tag_id, event_id)   (false)
+    #define elog_kv_uint(kv, field_id, value)
+    #define elog_kv_int(kv, field_id, value)
+    #define elog_kv_bool(kv, field_id, value)
+    #define elog_kv_float(kv, field_id, value)
+    #define elog_kv_str(kv, field_id, value)
+    #define elog_kv_end(kv)
+#endif /* ELOG_KV_ENABLE */
+
 /* elog_buf.c */
 void elog_buf_enabled(bool enabled);
 void elog_flush(void);
@@ -283,6 +464,7 @@ void elog_flush(void);
 void elog_async_enabled(bool enabled);
 size_t elog_async_get_log(char *log, size_t size);
 size_t elog_async_get_line_log(char *log, size_t size);
+uint32_t elog_async_get_drop_count(void);
 
 /* elog_utils.c */
 size_t elog_strcpy(size_t cur_len, char *dst, const char *src);
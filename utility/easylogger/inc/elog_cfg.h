@@ -36,7 +36,7 @@
 /* enable assert check */
 #define ELOG_ASSERT_ENABLE
 /* buffer size for every line's log */
-#define ELOG_LINE_BUF_SIZE                       1024
+#define ELOG_LINE_BUF_SIZE                       256
 /* output line number max length */
 #define ELOG_LINE_NUM_MAX_LEN                    5
 /* output filter's tag max length */
@@ -45,8 +45,10 @@
 #define ELOG_FILTER_KW_MAX_LEN                   16
 /* output filter's tag level max num */
 #define ELOG_FILTER_TAG_LVL_MAX_NUM              5
+/* per-thread staging buffer num, threads format logs without waiting on each other */
+#define ELOG_STAGING_BUF_NUM                     6
 /* output newline sign */
-#define ELOG_NEWLINE_SIGN                        "\n"
+#define ELOG_NEWLINE_SIGN                        "\r\n"
 /*---------------------------------------------------------------------------*/
 /* enable log color */
 #define ELOG_COLOR_ENABLE
@@ -69,14 +71,46 @@
 /* the highest output level for async mode, other level will sync output */
 #define ELOG_ASYNC_OUTPUT_LVL                    ELOG_LVL_ASSERT
 /* buffer size for asynchronous output mode */
-#define ELOG_ASYNC_OUTPUT_BUF_SIZE               (ELOG_LINE_BUF_SIZE * 10)
+#define ELOG_ASYNC_OUTPUT_BUF_SIZE               (ELOG_LINE_BUF_SIZE * 16)
 /* each asynchronous output's log which must end with newline sign */
 #define ELOG_ASYNC_LINE_OUTPUT
 /* asynchronous output mode using POSIX pthread implementation */
-#define ELOG_ASYNC_OUTPUT_USING_PTHREAD
+// #define ELOG_ASYNC_OUTPUT_USING_PTHREAD
+/* asynchronous output mode using OSAL thread and semaphore implementation */
+#define ELOG_ASYNC_OUTPUT_USING_OSAL
+/* stack size of the OSAL asynchronous output thread */
+#define ELOG_ASYNC_OUTPUT_OSAL_STACK_SIZE        1024
+/* priority of the OSAL asynchronous output thread, value of E_OSAL_THREAD_PRIORITY_T */
+#define ELOG_ASYNC_OUTPUT_OSAL_PRIORITY          E_OSAL_THREAD_PRIORITY_BACKGROUND
+/*---------------------------------------------------------------------------*/
+/* enable per-callsite rate limit of declared tag logs (log_x with LOG_TAG_ID) */
+#define ELOG_LIMIT_ENABLE
+/* token bucket of each callsite: logs per second and burst */
+#define ELOG_LIMIT_RATE                          10
+#define ELOG_LIMIT_BURST                         20
+/* 1-in-N sampling of the levels from ELOG_LIMIT_SAMPLE_LVL, 1: no sampling */
+#define ELOG_LIMIT_SAMPLE_LVL                    ELOG_LVL_VERBOSE
+#define ELOG_LIMIT_SAMPLE_RATE                   10
+/*---------------------------------------------------------------------------*/
+/* enable copying each formatted log into the crashlog ring kept across resets */
+#define ELOG_CRASHLOG_ENABLE
+/*---------------------------------------------------------------------------*/
+/* enable binary output mode, elog_bin_x/log_bin_x record the format address and raw arguments */
+#define ELOG_BIN_OUTPUT_ENABLE
+/* max size of each binary frame */
+#define ELOG_BIN_FRAME_MAX_SIZE                  64
+/* max length of each string argument in binary frame */
+#define ELOG_BIN_STR_MAX_LEN                     24
+/*---------------------------------------------------------------------------*/
+/* enable structured key-value logs (elog_kv_x), events and fields are declared in elog_kv_cfg.h */
+#define ELOG_KV_ENABLE
+/* output key-value logs as CBOR frames, otherwise they are rendered as text lines */
+#define ELOG_KV_OUTPUT_BIN
+/* max size of each key-value frame */
+#define ELOG_KV_FRAME_MAX_SIZE                   96
 /*---------------------------------------------------------------------------*/
 /* enable buffered output mode */
-#define ELOG_BUF_OUTPUT_ENABLE
+// #define ELOG_BUF_OUTPUT_ENABLE
 /* buffer size for buffered output mode */
 #define ELOG_BUF_OUTPUT_BUF_SIZE                 (ELOG_LINE_BUF_SIZE * 10)
 
@@ -0,0 +1,18 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Function: Declared events and fields of structured key-value logs.
+ *           ELOG_KV_EVENT_DEF(ID, "name") gets the ID ELOG_KV_EVENT_ID_<ID>,
+ *           ELOG_KV_FIELD_DEF(ID, "name") gets the ID ELOG_KV_FIELD_ID_<ID>.
+ *           Records carry the IDs only, the names are used by the text
+ *           rendering and by tools/elog_bin_decode.py which reads this file.
+ *           Append new entries at the end, so the IDs of old captures stay valid.
+ * Created on: 2026-10-19
+ */
+
+/* NOTE: no include guard, this file is expanded with different ELOG_KV_EVENT_DEF and ELOG_KV_FIELD_DEF definitions */
+ELOG_KV_EVENT_DEF(PREV_RUN,         "prev_run")
+
+ELOG_KV_FIELD_DEF(BOOT_COUNT,       "boot_count")
+ELOG_KV_FIELD_DEF(REASON,           "reason")
+ELOG_KV_FIELD_DEF(SIZE,             "size")
@@ -0,0 +1,20 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Function: Declared log tags. Each ELOG_TAG_DEF(ID, "name") gets the ID
+ *           ELOG_TAG_ID_<ID> at compile time, a file logs with it by
+ *           defining LOG_TAG_ID instead of LOG_TAG before including <elog.h>:
+ *
+ *               #define LOG_TAG_ID ELOG_TAG_ID_SYSTEM
+ *               #include <elog.h>
+ *
+ *           The level of a declared tag is checked inline against a table
+ *           indexed by its ID, a filtered out log costs a load and a compare.
+ *           Tags not declared here still work through LOG_TAG. Declare a
+ *           tag here only with the module that logs with it.
+ * Created on: 2026-10-19
+ */
+
+/* NOTE: no include guard, this file is expanded with different ELOG_TAG_DEF definitions */
+ELOG_TAG_DEF(ELOG,              "elog")
+ELOG_TAG_DEF(SYSTEM,            "system")
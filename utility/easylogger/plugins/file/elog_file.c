@@ -26,7 +26,7 @@
  * Created on: 2019-01-05
  */
 
- #define LOG_TAG    "elog.file"
+#define LOG_TAG    "elog.file"
 
 #include <stdio.h>
 #include <stdbool.h>
@@ -37,10 +37,40 @@
 
 #ifdef ELOG_FILE_ENABLE
 
+#define SUFFIX_LEN                     10
+#define ROTATING_SUFFIX                ".rotating"
+
 /* initialize OK flag */
 static bool init_ok = false;
 static FILE *fp = NULL;
 static ElogFileCfg local_cfg;
+/* size of current file, tracked in memory so writing never asks the file system */
+static size_t cur_size = 0;
+/* current file is over max size, rotation is left to elog_file_background */
+static bool rotate_pending = false;
+/* full buffered stdio, a new file takes the other buffer while the old one is closed */
+static char file_buf[2][ELOG_FILE_BUF_SIZE];
+static int file_buf_index = 0;
+
+/*
+ * open the log file with a user space buffer and get its size once
+ */
+static FILE *elog_file_open(const char *name)
+{
+    FILE *new_fp = fopen(name, "a+");
+
+    if (new_fp == NULL) {
+        return NULL;
+    }
+
+    file_buf_index ^= 1;
+    setvbuf(new_fp, file_buf[file_buf_index], _IOFBF, ELOG_FILE_BUF_SIZE);
+    fseek(new_fp, 0L, SEEK_END);
+    cur_size = ftell(new_fp);
+    rotate_pending = false;
+
+    return new_fp;
+}
 
 ElogErrCode elog_file_init(void)
 {
@@ -65,53 +95,101 @@ __exit:
 
 /*
  * rotate the log file xxx.log.n-1 => xxx.log.n, and xxx.log => xxx.log.0
+ *
+ * Only the swap to a new xxx.log is done under the lock: xxx.log is renamed to
+ * xxx.log.rotating and reopened. The old file is closed and the older files are
+ * renamed afterwards, writers are not blocked meanwhile.
  */
 static bool elog_file_rotate(void)
 {
-#define SUFFIX_LEN                     10
     /* mv xxx.log.n-1 => xxx.log.n, and xxx.log => xxx.log.0 */
     int n, err = 0;
-    char oldpath[256]= {0}, newpath[256] = {0};
-    size_t base = strlen(local_cfg.name);
+    char oldpath[256]= {0}, newpath[256] = {0}, rotating[256] = {0};
+    size_t base;
     bool result = true;
-    FILE *tmp_fp;
+    FILE *old_fp, *new_fp;
 
+    elog_file_port_lock();
+
+    if (fp == NULL || !rotate_pending) {
+        elog_file_port_unlock();
+        return true;
+    }
+    base = strlen(local_cfg.name);
+    if (base + sizeof(ROTATING_SUFFIX) > sizeof(rotating)) {
+        rotate_pending = false;
+        elog_file_port_unlock();
+        return false;
+    }
     memcpy(oldpath, local_cfg.name, base);
     memcpy(newpath, local_cfg.name, base);
+    memcpy(rotating, local_cfg.name, base);
+    memcpy(rotating + base, ROTATING_SUFFIX, sizeof(ROTATING_SUFFIX));
+
+    fflush(fp);
+    if (rename(local_cfg.name, rotating) < 0 || (new_fp = elog_file_open(local_cfg.name)) == NULL) {
+        /* keep writing the current file, retried when the next log finds it over size */
+        rotate_pending = false;
+        elog_file_port_unlock();
+        return false;
+    }
+    old_fp = fp;
+    fp = new_fp;
+
+    elog_file_port_unlock();
 
-    fclose(fp);
+    fclose(old_fp);
 
     for (n = local_cfg.max_rotate - 1; n >= 0; --n) {
-        snprintf(oldpath + base, SUFFIX_LEN, n ? ".%d" : "", n - 1);
-        snprintf(newpath + base, SUFFIX_LEN, ".%d", n);
-        /* remove the old file */
-        if ((tmp_fp = fopen(newpath , "r")) != NULL) {
-            fclose(tmp_fp);
-            remove(newpath);
+        if (n) {
+            snprintf(oldpath + base, SUFFIX_LEN, ".%d", n - 1);
+        } else {
+            memcpy(oldpath, rotating, sizeof(rotating));
         }
-        /* change the new log file to old file name */
-        if ((tmp_fp = fopen(oldpath , "r")) != NULL) {
-            fclose(tmp_fp);
+        snprintf(newpath + base, SUFFIX_LEN, ".%d", n);
+        /* change the new log file to old file name, the old file is replaced */
+        if ((old_fp = fopen(oldpath , "r")) != NULL) {
+            fclose(old_fp);
             err = rename(oldpath, newpath);
         }
 
         if (err < 0) {
             result = false;
-            goto __exit;
+            break;
         }
     }
 
-__exit:
-    /* reopen the file */
-    fp = fopen(local_cfg.name, "a+");
-
     return result;
 }
 
+/*
+ * background step of file log: rotate an over size file, or flush the buffered logs.
+ * Call it periodically (ELOG_FILE_FLUSH_PERIOD) and when elog_file_port_notify is called,
+ * the port does it in its background thread.
+ */
+void elog_file_background(void)
+{
+    bool rotate;
+
+    if (!init_ok) {
+        return;
+    }
+
+    elog_file_port_lock();
+    rotate = rotate_pending;
+    if (fp != NULL && !rotate) {
+        fflush(fp);
+    }
+    elog_file_port_unlock();
+
+    if (rotate) {
+        elog_file_rotate();
+    }
+}
 
 void elog_file_write(const char *log, size_t size)
 {
-    size_t file_size = 0;
+    bool notify = false;
 
     ELOG_ASSERT(init_ok);
     ELOG_ASSERT(log);
@@ -121,13 +199,12 @@ void elog_file_write(const char *log, size_t size)
 
     elog_file_port_lock();
 
-    fseek(fp, 0L, SEEK_END);
-    file_size = ftell(fp);
-
-    if (unlikely(file_size > local_cfg.max_size)) {
+    if (unlikely(cur_size > local_cfg.max_size)) {
 #if ELOG_FILE_MAX_ROTATE > 0
-        if (!elog_file_rotate()) {
-            goto __exit;
+        /* keep writing until the background step swaps the file */
+        if (!rotate_pending) {
+            rotate_pending = true;
+            notify = true;
         }
 #else
         goto __exit;
@@ -135,13 +212,20 @@ void elog_file_write(const char *log, size_t size)
     }
 
     fwrite(log, size, 1, fp);
+    cur_size += size;
 
 #ifdef ELOG_FILE_FLUSH_CACHE_ENABLE
     fflush(fp);
 #endif
 
+#if ELOG_FILE_MAX_ROTATE <= 0
 __exit:
+#endif
     elog_file_port_unlock();
+
+    if (notify) {
+        elog_file_port_notify();
+    }
 }
 
 void elog_file_deinit(void)
@@ -172,7 +256,7 @@ void elog_file_config(ElogFileCfg *cfg)
         local_cfg.max_rotate = cfg->max_rotate;
 
         if (local_cfg.name != NULL && strlen(local_cfg.name) > 0)
-            fp = fopen(local_cfg.name, "a+");
+            fp = elog_file_open(local_cfg.name);
     }
 
     elog_file_port_unlock();
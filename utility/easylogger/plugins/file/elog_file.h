@@ -38,7 +38,7 @@ extern "C" {
 #endif
 
 /* EasyLogger file log plugin's software version number */
-#define ELOG_FILE_SW_VERSION                "V1.0.0"
+#define ELOG_FILE_SW_VERSION                "V1.1.0"
 #ifdef linux
 #define likely(x) __builtin_expect(!!(x), 1)
 #define unlikely(x) __builtin_expect(!!(x), 0)
@@ -58,12 +58,14 @@ ElogErrCode elog_file_init(void);
 void elog_file_write(const char *log, size_t size);
 void elog_file_config(ElogFileCfg *cfg);
 void elog_file_deinit(void);
+void elog_file_background(void);
 
 /* elog_file_port.c */
 ElogErrCode elog_file_port_init(void);
 void elog_file_port_lock(void);
 void elog_file_port_unlock(void);
 void elog_file_port_deinit(void);
+void elog_file_port_notify(void);
 
 #ifdef __cplusplus
 }
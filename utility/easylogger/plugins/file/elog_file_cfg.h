@@ -38,4 +38,10 @@
 /* EasyLogger file log plugin's using max rotate file count */
 #define ELOG_FILE_MAX_ROTATE           /* @note you must define it for a value */
 
+/* EasyLogger file log plugin's user space write buffer size */
+#define ELOG_FILE_BUF_SIZE             (64 * 1024)
+
+/* EasyLogger file log plugin's period (ms) of the background step which flushes the buffer */
+#define ELOG_FILE_FLUSH_PERIOD         1000
+
 #endif /* _ELOG_FILE_CFG_H_ */
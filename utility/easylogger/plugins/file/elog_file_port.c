@@ -28,6 +28,46 @@
 
 #include "elog_file.h"
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <time.h>
+
+static pthread_mutex_t file_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t background_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t background_cond;
+static pthread_t background_thread;
+static bool background_running = false;
+static bool background_notified = false;
+
+/* background step thread: periodic flush, rotation as soon as it is notified */
+static void *background_entry(void *arg)
+{
+    struct timespec deadline;
+
+    (void) arg;
+    pthread_mutex_lock(&background_lock);
+    while (background_running) {
+        if (!background_notified) {
+            clock_gettime(CLOCK_MONOTONIC, &deadline);
+            deadline.tv_sec += ELOG_FILE_FLUSH_PERIOD / 1000;
+            deadline.tv_nsec += (ELOG_FILE_FLUSH_PERIOD % 1000) * 1000000L;
+            if (deadline.tv_nsec >= 1000000000L) {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000L;
+            }
+            pthread_cond_timedwait(&background_cond, &background_lock, &deadline);
+        }
+        background_notified = false;
+        pthread_mutex_unlock(&background_lock);
+        elog_file_background();
+        pthread_mutex_lock(&background_lock);
+    }
+    pthread_mutex_unlock(&background_lock);
+
+    return NULL;
+}
+#endif
+
 /**
  * EasyLogger flile log pulgin port initialize
  *
@@ -37,7 +77,21 @@ ElogErrCode elog_file_port_init(void)
 {
     ElogErrCode result = ELOG_NO_ERR;
 
-    /* add your code here */
+#if defined(__linux__)
+    pthread_condattr_t attr;
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&background_cond, &attr);
+    pthread_condattr_destroy(&attr);
+    background_running = true;
+    if (pthread_create(&background_thread, NULL, background_entry, NULL) != 0) {
+        background_running = false;
+        result = ELOG_RES_ERR;
+    }
+#else
+    /* add your code here: run elog_file_background every ELOG_FILE_FLUSH_PERIOD ms and on notify */
+#endif
 
     return result;
 }
@@ -47,7 +101,11 @@ ElogErrCode elog_file_port_init(void)
  */
 void elog_file_port_lock(void) {
 
+#if defined(__linux__)
+    pthread_mutex_lock(&file_lock);
+#else
     /* add your code here */
+#endif
 
 }
 
@@ -56,7 +114,11 @@ void elog_file_port_lock(void) {
  */
 void elog_file_port_unlock(void) {
 
+#if defined(__linux__)
+    pthread_mutex_unlock(&file_lock);
+#else
     /* add your code here */
+#endif
 
 }
 
@@ -65,6 +127,33 @@ void elog_file_port_unlock(void) {
  */
 void elog_file_port_deinit(void) {
 
+#if defined(__linux__)
+    if (background_running) {
+        pthread_mutex_lock(&background_lock);
+        background_running = false;
+        pthread_cond_signal(&background_cond);
+        pthread_mutex_unlock(&background_lock);
+        pthread_join(background_thread, NULL);
+        pthread_cond_destroy(&background_cond);
+    }
+#else
+    /* add your code here */
+#endif
+
+}
+
+/**
+ * wake up the background step at once, called by elog_file_write when the file needs rotation
+ */
+void elog_file_port_notify(void) {
+
+#if defined(__linux__)
+    pthread_mutex_lock(&background_lock);
+    background_notified = true;
+    pthread_cond_signal(&background_cond);
+    pthread_mutex_unlock(&background_lock);
+#else
     /* add your code here */
+#endif
 
 }
@@ -22,24 +22,81 @@
  * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
  * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  *
- * Function: Save log to flash. Must use EasyFlash(https://github.com/armink/EasyFlash) library.
+ * Function: Save log to flash. Log-structured records in rotating sectors of an ElogFlashDev.
  * Created on: 2015-06-05
  */
 
 #define LOG_TAG    "elog.flash"
 
 #include "elog_flash.h"
-#include <easyflash.h>
 #include <stdio.h>
-#include <stdlib.h>
 #include <string.h>
 
-#ifdef ELOG_FLASH_USING_BUF_MODE
-/* flash log buffer */
-static char log_buf[ELOG_FLASH_BUF_SIZE] = { 0 };
-/* current flash log buffer write position  */
-static size_t cur_buf_size = 0;
-#endif
+/*
+ * Flash layout, each sector:
+ *
+ * | sector header (16) | record | record | pad | record | ... | erased |
+ *
+ * sector header: magic, sequence number, timestamp of the first record, CRC32 of the former three
+ * record: size | ~size << 16, timestamp, CRC32 of timestamp and log, log padded to word
+ * pad: zero words up to the write granularity, left by a flush
+ *
+ * Sectors are used round-robin in sequence number order, the next one is erased when the
+ * current one is full, so every sector is erased equally often. The sequence number and first
+ * timestamp of each sector are kept in RAM as index.
+ */
+#define SECTOR_MAGIC                   0x53464C45   /* "ELFS" */
+#define SECTOR_HDR_SIZE                16
+#define RECORD_HDR_SIZE                12
+#define WORD_ERASED                    0xFFFFFFFFUL
+#define WORD_PAD                       0x00000000UL
+
+#define ALIGN_UP(size, align)          (((size) + (align) - 1) / (align) * (align))
+#define ALIGN_DOWN(size, align)        ((size) / (align) * (align))
+
+/* RAM index of each sector */
+typedef struct {
+    /* 0: sector is not used */
+    uint32_t seq;
+    /* timestamp of the first record */
+    uint32_t time;
+    /* offset behind the last record, staged data included for current sector */
+    size_t end;
+    /* log bytes in this sector */
+    size_t log_size;
+} sector_index;
+
+/* record position of an iteration */
+typedef struct {
+    size_t sector;
+    size_t offset;
+} record_iter;
+
+/* record header read back */
+typedef struct {
+    size_t addr;
+    size_t size;
+    uint32_t time;
+    uint32_t crc;
+} record_info;
+
+/* flash device */
+static const ElogFlashDev *dev = NULL;
+/* sector index */
+static sector_index sectors[ELOG_FLASH_SECTOR_MAX_NUM];
+/* current sector */
+static size_t cur_sector = 0;
+/* last used sequence number */
+static uint32_t cur_seq = 0;
+/* programmed offset of current sector, the staging buffer starts here */
+static size_t cur_offset = 0;
+/* staging buffer, the not yet programmed tail of current sector */
+static uint32_t stage_buf[ELOG_FLASH_BUF_SIZE / 4];
+static size_t stage_size = 0;
+/* read back buffer of one record */
+static uint32_t read_buf[ALIGN_UP(ELOG_FLASH_RECORD_MAX_SIZE, 4) / 4];
+/* statistics */
+static ElogFlashStats stats = { 0 };
 
 /* initialize OK flag */
 static bool init_ok = false;
@@ -51,6 +108,262 @@ static bool log_buf_is_locked_before_enable = false;
 static bool log_buf_is_locked_before_disable = false;
 static void log_buf_lock(void);
 static void log_buf_unlock(void);
+static void flash_flush(void);
+static void flash_output(size_t index, size_t size);
+
+extern uint32_t elog_port_get_timestamp(void);
+
+/**
+ * CRC32 (IEEE 802.3), 4 bits at a time with a 16 entries table
+ *
+ * @param crc CRC of the former data, 0 for the first
+ * @param buf data
+ * @param size data size
+ *
+ * @return CRC
+ */
+static uint32_t crc32_update(uint32_t crc, const void *buf, size_t size) {
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+    const uint8_t *p = buf;
+
+    crc = ~crc;
+    while (size--) {
+        crc ^= *p++;
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+static uint32_t record_crc(uint32_t time, const void *log, size_t size) {
+    return crc32_update(crc32_update(0, &time, sizeof(time)), log, size);
+}
+
+/**
+ * program the head of staging buffer into current sector
+ *
+ * @param size program size, multiple of write granularity
+ *
+ * @return result
+ */
+static ElogErrCode stage_program(size_t size) {
+    ElogErrCode result;
+
+    result = dev->write(cur_sector * dev->sector_size + cur_offset, stage_buf, size);
+    stats.write_bytes += size;
+    cur_offset += size;
+    stage_size -= size;
+    memmove(stage_buf, (uint8_t *) stage_buf + size, stage_size);
+
+    return result;
+}
+
+/**
+ * append to staging buffer, every page filled up is programmed
+ *
+ * @param data data
+ * @param size data size
+ */
+static void stage_append(const void *data, size_t size) {
+    const uint8_t *p = data;
+    size_t copy_size, boundary;
+
+    while (size) {
+        copy_size = ELOG_FLASH_BUF_SIZE - stage_size;
+        if (copy_size > size) {
+            copy_size = size;
+        }
+        memcpy((uint8_t *) stage_buf + stage_size, p, copy_size);
+        stage_size += copy_size;
+        p += copy_size;
+        size -= copy_size;
+        /* program up to the last page boundary reached */
+        boundary = ALIGN_DOWN(cur_offset + stage_size, ELOG_FLASH_PAGE_SIZE);
+        if (boundary > cur_offset) {
+            stage_program(boundary - cur_offset);
+        }
+    }
+}
+
+/**
+ * program all staged data, the tail is padded with zero words to write granularity
+ */
+static void stage_flush(void) {
+    size_t pad_size;
+
+    if (stage_size == 0) {
+        return;
+    }
+    /* staged records are word aligned, so is the pad */
+    pad_size = ALIGN_UP(stage_size, dev->write_gran) - stage_size;
+    memset((uint8_t *) stage_buf + stage_size, 0, pad_size);
+    stage_size += pad_size;
+    sectors[cur_sector].end += pad_size;
+    stage_program(stage_size);
+}
+
+/**
+ * erase the oldest sector and start writing into it
+ *
+ * @param time timestamp of the first record
+ *
+ * @return result
+ */
+static ElogErrCode sector_open(uint32_t time) {
+    /* current sector is the last one before the first open, so the first open takes sector 0 */
+    size_t next = (cur_sector + 1) % dev->sector_num;
+    size_t addr = next * dev->sector_size;
+    uint32_t hdr[SECTOR_HDR_SIZE / 4];
+
+    stats.used_size -= sectors[next].log_size;
+    memset(&sectors[next], 0, sizeof(sector_index));
+    cur_sector = next;
+    cur_offset = dev->sector_size;
+    stage_size = 0;
+
+    stats.erase_count++;
+    if (dev->erase(addr) != ELOG_NO_ERR) {
+        return ELOG_FLASH_ERR;
+    }
+    hdr[0] = SECTOR_MAGIC;
+    hdr[1] = ++cur_seq;
+    hdr[2] = time;
+    hdr[3] = crc32_update(0, hdr, 12);
+    stats.write_bytes += SECTOR_HDR_SIZE;
+    if (dev->write(addr, hdr, SECTOR_HDR_SIZE) != ELOG_NO_ERR) {
+        return ELOG_FLASH_ERR;
+    }
+
+    sectors[next].seq = cur_seq;
+    sectors[next].time = time;
+    sectors[next].end = SECTOR_HDR_SIZE;
+    cur_offset = SECTOR_HDR_SIZE;
+
+    return ELOG_NO_ERR;
+}
+
+/**
+ * find the end of records in a sector
+ *
+ * @param sector sector
+ * @param log_size log bytes in this sector
+ *
+ * @return offset behind the last record, sector size if the sector is damaged
+ */
+static size_t sector_scan(size_t sector, size_t *log_size) {
+    size_t base = sector * dev->sector_size, offset = SECTOR_HDR_SIZE, size;
+    uint32_t word;
+
+    *log_size = 0;
+    while (offset + RECORD_HDR_SIZE <= dev->sector_size) {
+        if (dev->read(base + offset, &word, sizeof(word)) != ELOG_NO_ERR) {
+            return dev->sector_size;
+        }
+        if (word == WORD_ERASED) {
+            return offset;
+        } else if (word == WORD_PAD) {
+            offset += 4;
+            continue;
+        }
+        size = word & 0xFFFF;
+        if ((word >> 16) != (~size & 0xFFFF) || offset + RECORD_HDR_SIZE + ALIGN_UP(size, 4) > dev->sector_size) {
+            return dev->sector_size;
+        }
+        *log_size += size;
+        offset += RECORD_HDR_SIZE + ALIGN_UP(size, 4);
+    }
+    return dev->sector_size;
+}
+
+/**
+ * read next record header
+ *
+ * @param iter position, moved behind the record
+ * @param info record header
+ *
+ * @return false when there is no more record
+ */
+static bool record_next(record_iter *iter, record_info *info) {
+    uint32_t hdr[RECORD_HDR_SIZE / 4];
+    size_t size;
+
+    while (true) {
+        if (iter->offset + RECORD_HDR_SIZE > sectors[iter->sector].end) {
+            if (iter->sector == cur_sector) {
+                return false;
+            }
+            iter->sector = (iter->sector + 1) % dev->sector_num;
+            iter->offset = SECTOR_HDR_SIZE;
+            continue;
+        }
+        info->addr = iter->sector * dev->sector_size + iter->offset;
+        if (dev->read(info->addr, hdr, sizeof(hdr)) != ELOG_NO_ERR) {
+            iter->offset = sectors[iter->sector].end;
+            continue;
+        }
+        if (hdr[0] == WORD_PAD) {
+            iter->offset += 4;
+            continue;
+        }
+        size = hdr[0] & 0xFFFF;
+        if ((hdr[0] >> 16) != (~size & 0xFFFF)
+                || iter->offset + RECORD_HDR_SIZE + ALIGN_UP(size, 4) > sectors[iter->sector].end) {
+            /* damaged, skip the rest of this sector */
+            iter->offset = sectors[iter->sector].end;
+            continue;
+        }
+        info->addr += RECORD_HDR_SIZE;
+        info->size = size;
+        info->time = hdr[1];
+        info->crc = hdr[2];
+        iter->offset += RECORD_HDR_SIZE + ALIGN_UP(size, 4);
+        return true;
+    }
+}
+
+/**
+ * position of the oldest record
+ *
+ * @param iter position
+ *
+ * @return false when flash log is empty
+ */
+static bool record_first(record_iter *iter) {
+    size_t i, sector;
+
+    if (!sectors[cur_sector].seq) {
+        return false;
+    }
+    /* sectors are used round-robin, the oldest one follows current sector */
+    for (i = 1; i <= dev->sector_num; i++) {
+        sector = (cur_sector + i) % dev->sector_num;
+        if (sectors[sector].seq) {
+            iter->sector = sector;
+            iter->offset = SECTOR_HDR_SIZE;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * read a record log into read buffer and check it
+ *
+ * @param info record header
+ *
+ * @return true if the log is intact
+ */
+static bool record_read(const record_info *info) {
+    if (info->size > sizeof(read_buf) || dev->read(info->addr, read_buf, info->size) != ELOG_NO_ERR
+            || record_crc(info->time, read_buf, info->size) != info->crc) {
+        stats.bad_records++;
+        return false;
+    }
+    return true;
+}
 
 /**
  * EasyLogger flash log plugin initialize.
@@ -59,17 +372,50 @@ static void log_buf_unlock(void);
  */
 ElogErrCode elog_flash_init(void) {
     ElogErrCode result = ELOG_NO_ERR;
+    uint32_t hdr[SECTOR_HDR_SIZE / 4];
+    size_t i;
 
-    /* buffer size must be word alignment */
-    ELOG_ASSERT(ELOG_FLASH_BUF_SIZE % 4 == 0);
+    /* port initialize */
+    result = elog_flash_port_init();
+    if (result != ELOG_NO_ERR) {
+        return result;
+    }
+    dev = elog_flash_port_get_dev();
+    ELOG_ASSERT(dev);
+    ELOG_ASSERT(dev->write_gran >= 4 && dev->write_gran <= SECTOR_HDR_SIZE && (dev->write_gran & (dev->write_gran - 1)) == 0);
+    ELOG_ASSERT(ELOG_FLASH_PAGE_SIZE % dev->write_gran == 0 && dev->sector_size % ELOG_FLASH_PAGE_SIZE == 0);
+    ELOG_ASSERT(dev->sector_num >= 2 && dev->sector_num <= ELOG_FLASH_SECTOR_MAX_NUM);
+    ELOG_ASSERT(SECTOR_HDR_SIZE + RECORD_HDR_SIZE + ELOG_FLASH_RECORD_MAX_SIZE <= dev->sector_size);
 
-#ifdef ELOG_FLASH_USING_BUF_MODE
-    /* initialize current flash log buffer write position */
-    cur_buf_size = 0;
-#endif
+    memset(sectors, 0, sizeof(sectors));
+    memset(&stats, 0, sizeof(stats));
+    cur_sector = dev->sector_num - 1;
+    cur_seq = 0;
+    stage_size = 0;
+    /* mount: index every sector with a valid header, the newest is current sector */
+    for (i = 0; i < dev->sector_num; i++) {
+        if (dev->read(i * dev->sector_size, hdr, sizeof(hdr)) != ELOG_NO_ERR) {
+            return ELOG_FLASH_ERR;
+        }
+        if (hdr[0] != SECTOR_MAGIC || hdr[1] == 0 || hdr[3] != crc32_update(0, hdr, 12)) {
+            continue;
+        }
+        sectors[i].seq = hdr[1];
+        sectors[i].time = hdr[2];
+        sectors[i].end = sector_scan(i, &sectors[i].log_size);
+        stats.used_size += sectors[i].log_size;
+        if (hdr[1] > cur_seq) {
+            cur_seq = hdr[1];
+            cur_sector = i;
+        }
+    }
+    /* an interrupted program may leave a partly written unit, continue behind it */
+    cur_offset = ALIGN_UP(sectors[cur_sector].end, dev->write_gran);
+    if (cur_offset > dev->sector_size) {
+        cur_offset = dev->sector_size;
+    }
+    sectors[cur_sector].end = cur_offset;
 
-    /* port initialize */
-    elog_flash_port_init();
     /* initialize OK */
     init_ok = true;
 
@@ -79,57 +425,74 @@ ElogErrCode elog_flash_init(void) {
 /**
  * Read and output log which saved in flash.
  *
- * @param index index for saved log. @note It will auto word alignment.
- *        Minimum index is 0.
- *        Maximum index is log used flash total size - 1.
- * @param size
+ * @param index index of the first byte in all saved log, minimum index is 0
+ * @param size output size, index + size is at most the used size
  */
 void elog_flash_output(size_t index, size_t size) {
-    /* 128 bytes buffer */
-    uint32_t buf[32] = { 0 };
-    size_t log_total_size = ef_log_get_used_size();
-    size_t buf_size = sizeof(buf);
-    size_t read_size = 0, read_overage_size = 0;
-
-    /* word alignment for index */
-    index = index / 4 * 4;
-    if (index + size > log_total_size) {
-        log_i("The output position and size is out of bound. The max size is %d.", log_total_size);
-        return;
-    }
     /* must be call this function after initialize OK */
     ELOG_ASSERT(init_ok);
     /* lock flash log buffer */
     log_buf_lock();
-    /* output all flash saved log. It will use filter */
-    while (true) {
-        if (read_size + buf_size < size) {
-            ef_log_read(index + read_size, buf, buf_size);
-            elog_flash_port_output((const char*)buf, buf_size);
-            read_size += buf_size;
-        } else {
-            /* flash read is word alignment */
-            if ((size - read_size) % 4 == 0) {
-                read_overage_size = 0;
-            } else {
-                read_overage_size = 4 - ((size - read_size) % 4);
-            }
-            ef_log_read(index + read_size, buf, size - read_size + read_overage_size);
-            elog_flash_port_output((const char*) buf + read_overage_size, size - read_size);
-            /* output newline sign */
-            elog_flash_port_output(ELOG_NEWLINE_SIGN, strlen(ELOG_NEWLINE_SIGN));
-            break;
-        }
+    /* staged logs are readable only after programmed */
+    flash_flush();
+    if (index + size > stats.used_size) {
+        log_buf_unlock();
+        log_i("The output position and size is out of bound. The max size is %d.", stats.used_size);
+        return;
     }
+    flash_output(index, size);
     /* unlock flash log buffer */
     log_buf_unlock();
 }
 
+/**
+ * output saved log, flash log buffer must be locked
+ *
+ * @param index index of the first byte in all saved log
+ * @param size output size
+ */
+static void flash_output(size_t index, size_t size) {
+    record_iter iter;
+    record_info info;
+    size_t pos = 0, skip, len;
+
+    if (size == 0 || !record_first(&iter)) {
+        return;
+    }
+    /* whole sectors before index are skipped by the index */
+    while (iter.sector != cur_sector && pos + sectors[iter.sector].log_size <= index) {
+        pos += sectors[iter.sector].log_size;
+        do {
+            iter.sector = (iter.sector + 1) % dev->sector_num;
+        } while (!sectors[iter.sector].seq);
+    }
+    while (size && record_next(&iter, &info)) {
+        if (pos + info.size <= index) {
+            pos += info.size;
+            continue;
+        }
+        skip = index > pos ? index - pos : 0;
+        pos += info.size;
+        if (!record_read(&info)) {
+            continue;
+        }
+        len = info.size - skip < size ? info.size - skip : size;
+        elog_flash_port_output((const char *) read_buf + skip, len);
+        size -= len;
+    }
+    /* output newline sign */
+    elog_flash_port_output(ELOG_NEWLINE_SIGN, strlen(ELOG_NEWLINE_SIGN));
+}
+
 /**
  * Read and output all log which saved in flash.
  */
 void elog_flash_output_all(void) {
-    elog_flash_output(0, ef_log_get_used_size());
+    ELOG_ASSERT(init_ok);
+    log_buf_lock();
+    flash_flush();
+    flash_output(0, stats.used_size);
+    log_buf_unlock();
 }
 
 /**
@@ -138,35 +501,75 @@ void elog_flash_output_all(void) {
  * @param size recent log size
  */
 void elog_flash_output_recent(size_t size) {
-    size_t max_size = ef_log_get_used_size();
+    size_t max_size;
 
     if (size == 0) {
         return;
     }
 
+    ELOG_ASSERT(init_ok);
+    log_buf_lock();
+    flash_flush();
+    max_size = stats.used_size;
     if (size > max_size) {
+        log_buf_unlock();
         log_i("The output size is out of bound. The max size is %d.", max_size);
-    } else {
-        elog_flash_output(max_size - size, size);
+        return;
     }
+    flash_output(max_size - size, size);
+    log_buf_unlock();
 }
 
 /**
- * Write log to flash. The flash write use buffer mode.
+ * Read and output log saved since a timestamp.
+ * Timestamps restart at each boot, the newest sector started at or before the timestamp
+ * is found in RAM index, then its records are read until the first one not older.
+ *
+ * @param time timestamp of elog_port_get_timestamp
+ */
+void elog_flash_output_since(uint32_t time) {
+    record_iter iter;
+    record_info info;
+    size_t i, sector;
+    bool found = false;
+
+    ELOG_ASSERT(init_ok);
+    log_buf_lock();
+    flash_flush();
+    if (!record_first(&iter)) {
+        log_buf_unlock();
+        return;
+    }
+    for (i = 0; i < dev->sector_num; i++) {
+        sector = (cur_sector + dev->sector_num - i) % dev->sector_num;
+        if (sectors[sector].seq && sectors[sector].time <= time) {
+            iter.sector = sector;
+            break;
+        }
+    }
+    while (record_next(&iter, &info)) {
+        if (!found && info.time < time) {
+            continue;
+        }
+        found = true;
+        if (record_read(&info)) {
+            elog_flash_port_output((const char *) read_buf, info.size);
+        }
+    }
+    log_buf_unlock();
+}
+
+/**
+ * Write log to flash. Each write is saved as a record, the record is programmed when
+ * a page of the staging buffer is filled up (buffer mode) or at once.
  *
  * @param log log
  * @param size log size
  */
 void elog_flash_write(const char *log, size_t size) {
-
-#ifdef ELOG_FLASH_USING_BUF_MODE
-    size_t write_size = 0, write_index = 0;
-#else
-    size_t write_size_temp = 0;
-    EfErrCode result = EF_NO_ERR;
-    /* write some '\r' for word alignment */
-    char write_overage_c[4] = { '\r', '\r', '\r', '\r' };
-#endif
+    uint32_t hdr[RECORD_HDR_SIZE / 4], pad = 0;
+    size_t rec_size, len;
+    uint32_t time = elog_port_get_timestamp();
 
     /* must be call this function after initialize OK */
     ELOG_ASSERT(init_ok);
@@ -174,90 +577,104 @@ void elog_flash_write(const char *log, size_t size) {
     /* lock flash log buffer */
     log_buf_lock();
 
-#ifdef ELOG_FLASH_USING_BUF_MODE
-    while (true) {
-        if (cur_buf_size + size > ELOG_FLASH_BUF_SIZE) {
-            write_size = ELOG_FLASH_BUF_SIZE - cur_buf_size;
-            elog_memcpy(log_buf + cur_buf_size, log + write_index, write_size);
-            write_index += write_size;
-            size -= write_size;
-            cur_buf_size += write_size;
-            /* unlock flash log buffer */
-            log_buf_unlock();
-            /* write all buffered log to flash, cur_buf_size will reset */
-            elog_flash_flush();
-            /* lock flash log buffer */
-            log_buf_lock();
-        } else {
-            elog_memcpy(log_buf + cur_buf_size, log + write_index, size);
-            cur_buf_size += size;
-            break;
+    stats.log_bytes += size;
+    while (size) {
+        len = size < ELOG_FLASH_RECORD_MAX_SIZE ? size : ELOG_FLASH_RECORD_MAX_SIZE;
+        rec_size = RECORD_HDR_SIZE + ALIGN_UP(len, 4);
+        /* records never cross sectors, a full sector rotates to the oldest one */
+        if (!sectors[cur_sector].seq || sectors[cur_sector].end + rec_size > dev->sector_size) {
+            stage_flush();
+            if (sector_open(time) != ELOG_NO_ERR) {
+                break;
+            }
         }
+        hdr[0] = len | (~len & 0xFFFF) << 16;
+        hdr[1] = time;
+        hdr[2] = record_crc(time, log, len);
+        stage_append(hdr, sizeof(hdr));
+        stage_append(log, len);
+        stage_append(&pad, ALIGN_UP(len, 4) - len);
+        sectors[cur_sector].end += rec_size;
+        sectors[cur_sector].log_size += len;
+        stats.used_size += len;
+        log += len;
+        size -= len;
     }
-#else
-    /* calculate the word alignment write size */
-    write_size_temp = size / 4 * 4;
-    /* write log to flash */
-    result = ef_log_write((uint32_t *) log, write_size_temp);
-    /* write last word alignment data */
-    if ((result == EF_NO_ERR) && (write_size_temp != size)) {
-        elog_memcpy(write_overage_c, log + write_size_temp, size - write_size_temp);
-        ef_log_write((uint32_t *) write_overage_c, 4);
-    }
+
+#ifndef ELOG_FLASH_USING_BUF_MODE
+    stage_flush();
 #endif
 
     /* unlock flash log buffer */
     log_buf_unlock();
 }
 
+/**
+ * program all staged log, flash log buffer must be locked
+ */
+static void flash_flush(void) {
+    if (sectors[cur_sector].seq) {
+        stage_flush();
+    }
+}
+
 #ifdef ELOG_FLASH_USING_BUF_MODE
 /**
  * write all buffered log to flash
  */
 void elog_flash_flush(void) {
-    size_t write_overage_size = 0;
-
     /* must be call this function after initialize OK */
     ELOG_ASSERT(init_ok);
     /* lock flash log buffer */
     log_buf_lock();
-    /* flash write is word alignment */
-    if (cur_buf_size % 4 != 0) {
-        write_overage_size = 4 - (cur_buf_size % 4);
-    }
-    /* fill '\r' for word alignment */
-    memset(log_buf + cur_buf_size, '\r', write_overage_size);
-    /* write all buffered log to flash */
-    ef_log_write((uint32_t *) log_buf, cur_buf_size + write_overage_size);
-    /* reset position */
-    cur_buf_size = 0;
+    flash_flush();
     /* unlock flash log buffer */
     log_buf_unlock();
 }
 #endif
 
+/**
+ * get flash log statistics, write amplification is write_bytes / log_bytes
+ *
+ * @param stats statistics
+ */
+void elog_flash_get_stats(ElogFlashStats *flash_stats) {
+    ELOG_ASSERT(flash_stats);
+    log_buf_lock();
+    *flash_stats = stats;
+    log_buf_unlock();
+}
+
 /**
  * clean all log which in flash and ram buffer
  */
 void elog_flash_clean(void) {
-    EfErrCode clean_result = EF_NO_ERR;
+    ElogErrCode clean_result = ELOG_NO_ERR;
+    size_t i;
 
     /* must be call this function after initialize OK */
     ELOG_ASSERT(init_ok);
     /* lock flash log buffer */
     log_buf_lock();
-    /* clean all log which in flash */
-    clean_result = ef_log_clean();
-
-#ifdef ELOG_FLASH_USING_BUF_MODE
-    /* reset position */
-    cur_buf_size = 0;
-#endif
+    /* erase used sectors, rotation goes on from current sector */
+    for (i = 0; i < dev->sector_num; i++) {
+        if (sectors[i].seq) {
+            stats.erase_count++;
+            if (dev->erase(i * dev->sector_size) != ELOG_NO_ERR) {
+                clean_result = ELOG_FLASH_ERR;
+            }
+        }
+        sectors[i].seq = 0;
+        sectors[i].end = 0;
+        sectors[i].log_size = 0;
+    }
+    stats.used_size = 0;
+    stage_size = 0;
 
     /* unlock flash log buffer */
     log_buf_unlock();
 
-    if(clean_result == EF_NO_ERR) {
+    if(clean_result == ELOG_NO_ERR) {
         log_i("All logs which in flash is clean OK.");
     } else {
         log_e("Clean logs which in flash has an error!");
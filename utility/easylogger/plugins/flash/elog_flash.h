@@ -40,14 +40,41 @@ extern "C" {
     #error "Please configure RAM buffer size (in elog_flash_cfg.h)"
 #endif
 
+#if !defined(ELOG_FLASH_PAGE_SIZE) || (ELOG_FLASH_BUF_SIZE % ELOG_FLASH_PAGE_SIZE != 0)
+    #error "Please configure page size, RAM buffer size must be a multiple of it (in elog_flash_cfg.h)"
+#endif
+
 /* EasyLogger flash log plugin's software version number */
-#define ELOG_FLASH_SW_VERSION                "V2.0.1"
+#define ELOG_FLASH_SW_VERSION                "V3.0.0"
+
+/* flash device of the log area, addresses are offsets from the start of the area */
+typedef struct {
+    /* erase unit, the log area is rotated sector by sector */
+    size_t sector_size;
+    size_t sector_num;
+    /* program unit, power of two from 4 to 16, programmed only once between erases */
+    size_t write_gran;
+    ElogErrCode (*read)(size_t addr, void *buf, size_t size);
+    ElogErrCode (*write)(size_t addr, const void *buf, size_t size);
+    ElogErrCode (*erase)(size_t addr);
+} ElogFlashDev;
+
+/* flash log statistics since initialize */
+typedef struct {
+    size_t log_bytes;       /* log bytes given to elog_flash_write */
+    size_t write_bytes;     /* bytes programmed, record headers and padding included */
+    size_t erase_count;     /* sectors erased */
+    size_t used_size;       /* log bytes currently kept in flash */
+    size_t bad_records;     /* records skipped on read for a CRC mismatch */
+} ElogFlashStats;
 
 /* elog_flash.c */
 ElogErrCode elog_flash_init(void);
 void elog_flash_output(size_t pos, size_t size);
 void elog_flash_output_all(void);
 void elog_flash_output_recent(size_t size);
+void elog_flash_output_since(uint32_t time);
+void elog_flash_get_stats(ElogFlashStats *stats);
 void elog_flash_set_filter(uint8_t level,const char *tag,const char *keyword);
 void elog_flash_write(const char *log, size_t size);
 void elog_flash_clean(void);
@@ -59,6 +86,7 @@ void elog_flash_flush(void);
 
 /* elog_flash_port.c */
 ElogErrCode elog_flash_port_init(void);
+const ElogFlashDev *elog_flash_port_get_dev(void);
 void elog_flash_port_output(const char *log, size_t size);
 void elog_flash_port_lock(void);
 void elog_flash_port_unlock(void);
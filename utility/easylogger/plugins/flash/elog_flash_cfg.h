@@ -29,9 +29,16 @@
 #ifndef _ELOG_FLASH_CFG_H_
 #define _ELOG_FLASH_CFG_H_
 
-/* EasyLogger flash log plugin's using buffer mode */
+/* EasyLogger flash log plugin's using buffer mode, logs are programmed once a page is full
+ * instead of at each write */
 #define ELOG_FLASH_USING_BUF_MODE
-/* EasyLogger flash log plugin's RAM buffer size */
-#define ELOG_FLASH_BUF_SIZE                  /* @note you must define it for a value */
+/* size of each batch programmed to flash, multiple of the device write granularity */
+#define ELOG_FLASH_PAGE_SIZE                 256
+/* EasyLogger flash log plugin's RAM staging buffer size, multiple of ELOG_FLASH_PAGE_SIZE */
+#define ELOG_FLASH_BUF_SIZE                  (ELOG_FLASH_PAGE_SIZE * 2)
+/* max size of each record, longer writes are split */
+#define ELOG_FLASH_RECORD_MAX_SIZE           ELOG_LINE_BUF_SIZE
+/* max sector number of the flash log area */
+#define ELOG_FLASH_SECTOR_MAX_NUM            32
 
 #endif /* _ELOG_FLASH_CFG_H_ */
@@ -28,6 +28,19 @@
 
 #include "elog_flash.h"
 
+#if defined(__linux__)
+#include "elog_flash_sim.h"
+#include <stdio.h>
+
+/* simulated like the on-chip flash of STM32WB: 4K pages programmed by double word */
+#define ELOG_FLASH_SIM_FILE            "elog_flash.bin"
+#define ELOG_FLASH_SIM_SECTOR_SIZE     4096
+#define ELOG_FLASH_SIM_SECTOR_NUM      16
+#define ELOG_FLASH_SIM_WRITE_GRAN      8
+#endif
+
+static const ElogFlashDev *flash_dev = NULL;
+
 /**
  * EasyLogger flash log pulgin port initialize
  *
@@ -36,11 +49,28 @@
 ElogErrCode elog_flash_port_init(void) {
     ElogErrCode result = ELOG_NO_ERR;
     
-    /* add your code here */
+#if defined(__linux__)
+    flash_dev = elog_flash_sim_open(ELOG_FLASH_SIM_FILE, ELOG_FLASH_SIM_SECTOR_SIZE, ELOG_FLASH_SIM_SECTOR_NUM,
+            ELOG_FLASH_SIM_WRITE_GRAN);
+    if (!flash_dev) {
+        result = ELOG_FLASH_ERR;
+    }
+#else
+    /* add your code here: set flash_dev to the driver of the flash log area */
+#endif
 
     return result;
 }
 
+/**
+ * get the flash device of the flash log area
+ *
+ * @return flash device
+ */
+const ElogFlashDev *elog_flash_port_get_dev(void) {
+    return flash_dev;
+}
+
 /**
  * output flash saved log port interface
  *
@@ -49,7 +79,11 @@ ElogErrCode elog_flash_port_init(void) {
  */
 void elog_flash_port_output(const char *log, size_t size) {
     
+#if defined(__linux__)
+    fwrite(log, 1, size, stdout);
+#else
     /* add your code here */
+#endif
     
 }
 
@@ -0,0 +1,162 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: File backed flash simulator for the flash log plugin, with NOR
+ *           program rules and wear statistics, to run and measure it on host.
+ * Created on: 2026-10-19
+ */
+
+#include "elog_flash_sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* the whole area is kept in RAM and written through to the file */
+static FILE *sim_file = NULL;
+static uint8_t *sim_data = NULL;
+static size_t *sim_erase_count = NULL;
+static ElogFlashDev sim_dev;
+static ElogFlashSimStats sim_stats;
+
+static ElogErrCode sim_read(size_t addr, void *buf, size_t size) {
+    if (addr + size > sim_dev.sector_size * sim_dev.sector_num) {
+        return ELOG_FLASH_ERR;
+    }
+    memcpy(buf, sim_data + addr, size);
+    sim_stats.read_bytes += size;
+    return ELOG_NO_ERR;
+}
+
+static ElogErrCode sim_write(size_t addr, const void *buf, size_t size) {
+    const uint8_t *p = buf;
+    size_t i;
+
+    if (addr + size > sim_dev.sector_size * sim_dev.sector_num) {
+        return ELOG_FLASH_ERR;
+    }
+    if (addr % sim_dev.write_gran || size % sim_dev.write_gran) {
+        sim_stats.violations++;
+        return ELOG_FLASH_ERR;
+    }
+    /* NOR program only clears bits, a unit is programmed once between erases */
+    for (i = 0; i < size; i++) {
+        if (p[i] & ~sim_data[addr + i]) {
+            sim_stats.violations++;
+        }
+        sim_data[addr + i] &= p[i];
+    }
+    sim_stats.write_bytes += size;
+    sim_stats.write_count++;
+    fseek(sim_file, (long) addr, SEEK_SET);
+    fwrite(sim_data + addr, 1, size, sim_file);
+    fflush(sim_file);
+    return ELOG_NO_ERR;
+}
+
+static ElogErrCode sim_erase(size_t addr) {
+    size_t sector = addr / sim_dev.sector_size, i;
+
+    if (addr % sim_dev.sector_size || sector >= sim_dev.sector_num) {
+        return ELOG_FLASH_ERR;
+    }
+    memset(sim_data + addr, 0xFF, sim_dev.sector_size);
+    sim_erase_count[sector]++;
+    sim_stats.erase_count++;
+    sim_stats.erase_min = sim_stats.erase_max = sim_erase_count[0];
+    for (i = 1; i < sim_dev.sector_num; i++) {
+        if (sim_erase_count[i] < sim_stats.erase_min) {
+            sim_stats.erase_min = sim_erase_count[i];
+        }
+        if (sim_erase_count[i] > sim_stats.erase_max) {
+            sim_stats.erase_max = sim_erase_count[i];
+        }
+    }
+    fseek(sim_file, (long) addr, SEEK_SET);
+    fwrite(sim_data + addr, 1, sim_dev.sector_size, sim_file);
+    fflush(sim_file);
+    return ELOG_NO_ERR;
+}
+
+/**
+ * open flash simulator, a new or shorter file is extended with erased bytes
+ *
+ * @param path backing file, content is kept between runs
+ * @param sector_size erase unit
+ * @param sector_num sector number
+ * @param write_gran program unit
+ *
+ * @return flash device, NULL on error
+ */
+const ElogFlashDev *elog_flash_sim_open(const char *path, size_t sector_size, size_t sector_num, size_t write_gran) {
+    size_t size = sector_size * sector_num, read_size;
+
+    elog_flash_sim_close();
+    sim_data = malloc(size);
+    sim_erase_count = calloc(sector_num, sizeof(size_t));
+    sim_file = fopen(path, "r+b");
+    if (!sim_file) {
+        sim_file = fopen(path, "w+b");
+    }
+    if (!sim_data || !sim_erase_count || !sim_file) {
+        elog_flash_sim_close();
+        return NULL;
+    }
+    memset(sim_data, 0xFF, size);
+    read_size = fread(sim_data, 1, size, sim_file);
+    if (read_size < size) {
+        fseek(sim_file, (long) read_size, SEEK_SET);
+        fwrite(sim_data + read_size, 1, size - read_size, sim_file);
+        fflush(sim_file);
+    }
+
+    memset(&sim_stats, 0, sizeof(sim_stats));
+    sim_dev.sector_size = sector_size;
+    sim_dev.sector_num = sector_num;
+    sim_dev.write_gran = write_gran;
+    sim_dev.read = sim_read;
+    sim_dev.write = sim_write;
+    sim_dev.erase = sim_erase;
+    return &sim_dev;
+}
+
+/**
+ * close flash simulator
+ */
+void elog_flash_sim_close(void) {
+    if (sim_file) {
+        fclose(sim_file);
+        sim_file = NULL;
+    }
+    free(sim_data);
+    sim_data = NULL;
+    free(sim_erase_count);
+    sim_erase_count = NULL;
+}
+
+/**
+ * get flash simulator statistics
+ *
+ * @param stats statistics
+ */
+void elog_flash_sim_get_stats(ElogFlashSimStats *stats) {
+    *stats = sim_stats;
+}
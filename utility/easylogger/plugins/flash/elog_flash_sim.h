@@ -0,0 +1,58 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: File backed flash simulator for the flash log plugin, with NOR
+ *           program rules and wear statistics, to run and measure it on host.
+ * Created on: 2026-10-19
+ */
+
+#ifndef __ELOG_FLASH_SIM_H__
+#define __ELOG_FLASH_SIM_H__
+
+#include <elog_flash.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* flash simulator statistics since open */
+typedef struct {
+    size_t read_bytes;
+    size_t write_bytes;
+    size_t write_count;
+    size_t erase_count;
+    /* erase count of the least and most erased sector, their gap shows wear leveling */
+    size_t erase_min;
+    size_t erase_max;
+    /* programs that tried to set a bit or were not aligned to write granularity */
+    size_t violations;
+} ElogFlashSimStats;
+
+const ElogFlashDev *elog_flash_sim_open(const char *path, size_t sector_size, size_t sector_num, size_t write_gran);
+void elog_flash_sim_close(void);
+void elog_flash_sim_get_stats(ElogFlashSimStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ELOG_FLASH_SIM_H__ */
@@ -27,6 +27,16 @@
  */
  
 #include <elog.h>
+#include <stdio.h>
+
+#include "osal.h"
+#include "bsp_serialport_adapter.h"
+
+/* output lock, logs of different threads never interleave on the serialport */
+static void *output_lock = NULL;
+/* time strings, rotated so that threads formatting in their staging buffers do not share one */
+static char time_buf[ELOG_STAGING_BUF_NUM + 1][12] = { 0 };
+static uint32_t time_buf_index = 0;
 
 /**
  * EasyLogger port initialize
@@ -35,9 +45,15 @@
  */
 ElogErrCode elog_port_init(void) {
     ElogErrCode result = ELOG_NO_ERR;
+    S_OSAL_MUTEX_CONFIG_T mutex_config = {
+        .p_name = "elog output",
+    };
+
+    if (output_lock == NULL
+            && osal_mutex_create(&output_lock, &mutex_config) != E_OSAL_RET_STATUS_OK) {
+        result = ELOG_RES_ERR;
+    }
 
-    /* add your code here */
-    
     return result;
 }
 
@@ -46,9 +62,10 @@ ElogErrCode elog_port_init(void) {
  *
  */
 void elog_port_deinit(void) {
-
-    /* add your code here */
-
+    if (output_lock) {
+        osal_mutex_delete(output_lock);
+        output_lock = NULL;
+    }
 }
 
 /**
@@ -58,27 +75,26 @@ void elog_port_deinit(void) {
  * @param size log size
  */
 void elog_port_output(const char *log, size_t size) {
-    
-    /* add your code here */
-    
+    /* Only copies into the serialport TX ringbuffer, a full ringbuffer drops the log instead of blocking */
+    serialport_adapter_transmit((const uint8_t *)log, (uint16_t)size);
 }
 
 /**
  * output lock
  */
 void elog_port_output_lock(void) {
-    
-    /* add your code here */
-    
+    if (output_lock) {
+        osal_mutex_lock(output_lock);
+    }
 }
 
 /**
  * output unlock
  */
 void elog_port_output_unlock(void) {
-    
-    /* add your code here */
-    
+    if (output_lock) {
+        osal_mutex_unlock(output_lock);
+    }
 }
 
 /**
@@ -87,9 +103,29 @@ void elog_port_output_unlock(void) {
  * @return current time
  */
 const char *elog_port_get_time(void) {
-    
-    /* add your code here */
-    
+    char *buf = time_buf[__atomic_fetch_add(&time_buf_index, 1, __ATOMIC_RELAXED) % (ELOG_STAGING_BUF_NUM + 1)];
+
+    snprintf(buf, sizeof(time_buf[0]), "%lu", (unsigned long)osal_get_tick());
+    return buf;
+}
+
+/**
+ * get current thread interface, used to find the staging buffer of current thread
+ *
+ * @return current thread, NULL in ISR and before the kernel runs so that those callers take the shared
+ *         buffer behind the output lock instead of the staging buffer of the interrupted thread
+ */
+void *elog_port_get_thread(void) {
+    return osal_thread_self();
+}
+
+/**
+ * get current timestamp interface, used by binary output mode
+ *
+ * @return current timestamp
+ */
+uint32_t elog_port_get_timestamp(void) {
+    return osal_get_tick();
 }
 
 /**
@@ -98,9 +134,8 @@ const char *elog_port_get_time(void) {
  * @return current process name
  */
 const char *elog_port_get_p_info(void) {
-    
-    /* add your code here */
-    
+    /* single process system */
+    return "";
 }
 
 /**
@@ -109,7 +144,6 @@ const char *elog_port_get_p_info(void) {
  * @return current thread name
  */
 const char *elog_port_get_t_info(void) {
-    
-    /* add your code here */
-    
-}
\ No newline at end of file
+    const char *name = osal_thread_name_get(osal_thread_self());
+    return name ? name : "";
+}
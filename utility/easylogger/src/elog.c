@@ -26,13 +26,17 @@
  * Created on: 2015-04-28
  */
 
-#define LOG_TAG      "elog"
+#define LOG_TAG_ID   ELOG_TAG_ID_ELOG
 
 #include <elog.h>
 #include <string.h>
 #include <stdarg.h>
 #include <stdio.h>
 
+#ifdef ELOG_CRASHLOG_ENABLE
+#include <crashlog.h>
+#endif
+
 #if !defined(ELOG_OUTPUT_LVL)
     #error "Please configure static output log level (in elog_cfg.h)"
 #endif
@@ -57,6 +61,11 @@
     #error "Please configure output newline sign (in elog_cfg.h)"
 #endif
 
+/* per-thread staging buffer num, 0: all threads share one buffer behind the output lock */
+#ifndef ELOG_STAGING_BUF_NUM
+#define ELOG_STAGING_BUF_NUM                 0
+#endif
+
 /* output filter's tag level max num */
 #ifndef ELOG_FILTER_TAG_LVL_MAX_NUM
 #define ELOG_FILTER_TAG_LVL_MAX_NUM          4
@@ -116,8 +125,15 @@
 
 /* EasyLogger object */
 static EasyLogger elog;
-/* every line log's buffer */
+/* every line log's buffer, shared by the callers without a staging buffer */
 static char log_buf[ELOG_LINE_BUF_SIZE] = { 0 };
+#if ELOG_STAGING_BUF_NUM > 0
+/* per-thread staging buffer, the owner is claimed once with a CAS and never released */
+static struct {
+    void *owner;
+    char buf[ELOG_LINE_BUF_SIZE];
+} staging[ELOG_STAGING_BUF_NUM];
+#endif
 /* level output info */
 static const char *level_output_info[] = {
         [ELOG_LVL_ASSERT]  = "A/",
@@ -128,6 +144,20 @@ static const char *level_output_info[] = {
         [ELOG_LVL_VERBOSE] = "V/",
 };
 
+/* declared tag name and name length */
+const char * const elog_tag_name[ELOG_TAG_ID_NUM] = {
+#define ELOG_TAG_DEF(id, name)               [ELOG_TAG_ID_##id] = name,
+#include <elog_tag_cfg.h>
+#undef ELOG_TAG_DEF
+};
+static const uint8_t tag_name_len[ELOG_TAG_ID_NUM] = {
+#define ELOG_TAG_DEF(id, name)               [ELOG_TAG_ID_##id] = sizeof(name) - 1,
+#include <elog_tag_cfg.h>
+#undef ELOG_TAG_DEF
+};
+/* effective level of declared tags, rebuilt whenever the output or filter setting changes */
+int8_t elog_tag_lvl[ELOG_TAG_ID_NUM] = { [0 ... ELOG_TAG_ID_NUM - 1] = -1 };
+
 #ifdef ELOG_COLOR_ENABLE
 /* color output info */
 static const char *color_output_info[] = {
@@ -144,6 +174,13 @@ static bool get_fmt_enabled(uint8_t level, size_t set);
 static bool get_fmt_used_and_enabled_u32(uint8_t level, size_t set, uint32_t arg);
 static bool get_fmt_used_and_enabled_ptr(uint8_t level, size_t set, const char* arg);
 static void elog_set_filter_tag_lvl_default(void);
+static uint8_t filter_tag_lvl_find(const char *tag);
+static void tag_lvl_update(void);
+static void output_va(uint8_t level, const char *tag, size_t tag_len, const char *file, const char *func,
+        const long line, const char *format, va_list args);
+static char *staging_buf_get(void);
+void elog_output_lock(void);
+void elog_output_unlock(void);
 
 /* EasyLogger assert hook */
 void (*elog_assert_hook)(const char* expr, const char* func, size_t line);
@@ -276,7 +313,10 @@ void elog_stop(void) {
 void elog_set_output_enabled(bool enabled) {
     ELOG_ASSERT((enabled == false) || (enabled == true));
 
+    elog_output_lock();
     elog.output_enabled = enabled;
+    tag_lvl_update();
+    elog_output_unlock();
 }
 
 #ifdef ELOG_COLOR_ENABLE
@@ -310,6 +350,15 @@ bool elog_get_output_enabled(void) {
     return elog.output_enabled;
 }
 
+/**
+ * get output filter's level
+ *
+ * @return level
+ */
+uint8_t elog_get_filter_lvl(void) {
+    return elog.filter.level;
+}
+
 /**
  * set log output format. only enable or disable
  *
@@ -345,7 +394,10 @@ void elog_set_filter(uint8_t level, const char *tag, const char *keyword) {
 void elog_set_filter_lvl(uint8_t level) {
     ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
 
+    elog_output_lock();
     elog.filter.level = level;
+    tag_lvl_update();
+    elog_output_unlock();
 }
 
 /**
@@ -354,7 +406,10 @@ void elog_set_filter_lvl(uint8_t level) {
  * @param tag tag
  */
 void elog_set_filter_tag(const char *tag) {
+    elog_output_lock();
     strncpy(elog.filter.tag, tag, ELOG_FILTER_TAG_MAX_LEN);
+    tag_lvl_update();
+    elog_output_unlock();
 }
 
 /**
@@ -464,6 +519,7 @@ void elog_set_filter_tag_lvl(const char *tag, uint8_t level)
             }
         }
     }
+    tag_lvl_update();
     elog_output_unlock();
 }
 
@@ -478,7 +534,6 @@ void elog_set_filter_tag_lvl(const char *tag, uint8_t level)
 uint8_t elog_get_filter_tag_lvl(const char *tag)
 {
     ELOG_ASSERT(tag != ((void *)0));
-    uint8_t i = 0;
     uint8_t level = ELOG_FILTER_LVL_ALL;
 
     if (!elog.init_ok) {
@@ -486,17 +541,49 @@ uint8_t elog_get_filter_tag_lvl(const char *tag)
     }
 
     elog_output_lock();
+    level = filter_tag_lvl_find(tag);
+    elog_output_unlock();
+
+    return level;
+}
+
+/**
+ * find the level on tag's level filer, the caller holds the output lock
+ *
+ * @param tag tag
+ *
+ * @return level, the lowest level when tag was not found
+ */
+static uint8_t filter_tag_lvl_find(const char *tag) {
+    uint8_t i = 0;
+
     /* find the tag in arr */
     for (i =0; i< ELOG_FILTER_TAG_LVL_MAX_NUM; i++){
         if (elog.filter.tag_lvl[i].tag_use_flag == true &&
             !strncmp(tag, elog.filter.tag_lvl[i].tag,ELOG_FILTER_TAG_MAX_LEN)){
-            level = elog.filter.tag_lvl[i].level;
-            break;
+            return elog.filter.tag_lvl[i].level;
         }
     }
-    elog_output_unlock();
 
-    return level;
+    return ELOG_FILTER_LVL_ALL;
+}
+
+/**
+ * rebuild the effective level of declared tags from output enabled, filter level,
+ * filter tag and tag's level filter, so that the log call only checks one table entry.
+ * Callers hold the output lock, the filter state is not read half updated.
+ */
+static void tag_lvl_update(void) {
+    size_t i;
+
+    for (i = 0; i < ELOG_TAG_ID_NUM; i++) {
+        int8_t level = -1;
+        if (elog.output_enabled && strstr(elog_tag_name[i], elog.filter.tag)) {
+            uint8_t tag_level = filter_tag_lvl_find(elog_tag_name[i]);
+            level = (int8_t)(tag_level < elog.filter.level ? tag_level : elog.filter.level);
+        }
+        elog_tag_lvl[i] = level;
+    }
 }
 
 /**
@@ -561,15 +648,7 @@ void elog_raw_output(const char *format, ...) {
  */
 void elog_output(uint8_t level, const char *tag, const char *file, const char *func,
         const long line, const char *format, ...) {
-    extern const char *elog_port_get_time(void);
-    extern const char *elog_port_get_p_info(void);
-    extern const char *elog_port_get_t_info(void);
-
-    size_t tag_len = strlen(tag), log_len = 0, newline_len = strlen(ELOG_NEWLINE_SIGN);
-    char line_num[ELOG_LINE_NUM_MAX_LEN + 1] = { 0 };
-    char tag_sapce[ELOG_FILTER_TAG_MAX_LEN / 2 + 1] = { 0 };
     va_list args;
-    int fmt_result;
 
     ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
 
@@ -585,87 +664,149 @@ void elog_output(uint8_t level, const char *tag, const char *file, const char *f
     }
     /* args point to the first variable parameter */
     va_start(args, format);
-    /* lock output */
-    elog_output_lock();
+    output_va(level, tag, strlen(tag), file, func, line, format, args);
+    va_end(args);
+}
+
+/**
+ * output the log of a declared tag, the tag filters are already resolved in elog_tag_lvl
+ *
+ * @param level level
+ * @param tag_id declared tag ID
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param format output format
+ * @param ... args
+ *
+ */
+void elog_output_id(uint8_t level, ElogTagId tag_id, const char *file, const char *func,
+        const long line, const char *format, ...) {
+    va_list args;
+
+    ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
+    ELOG_ASSERT(tag_id < ELOG_TAG_ID_NUM);
+
+    /* output enabled, level and tag filter */
+    if ((int8_t)level > elog_tag_lvl[tag_id]) {
+        return;
+    }
+    /* args point to the first variable parameter */
+    va_start(args, format);
+    output_va(level, elog_tag_name[tag_id], tag_name_len[tag_id], file, func, line, format, args);
+    va_end(args);
+}
+
+/**
+ * format and output the log after it passed the filters
+ *
+ * @param level level
+ * @param tag tag
+ * @param tag_len tag length
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param format output format
+ * @param args args
+ *
+ */
+static void output_va(uint8_t level, const char *tag, size_t tag_len, const char *file, const char *func,
+        const long line, const char *format, va_list args) {
+    extern const char *elog_port_get_time(void);
+    extern const char *elog_port_get_p_info(void);
+    extern const char *elog_port_get_t_info(void);
+
+    size_t log_len = 0, newline_len = strlen(ELOG_NEWLINE_SIGN);
+    char line_num[ELOG_LINE_NUM_MAX_LEN + 1] = { 0 };
+    char tag_sapce[ELOG_FILTER_TAG_MAX_LEN / 2 + 1] = { 0 };
+    int fmt_result;
+    /* every thread formats in its own staging buffer, NULL without a current thread (ISR) or when all are taken */
+    char *buf = staging_buf_get();
+    bool staged = (buf != NULL);
+
+    /* lock output, the shared buffer is used by one thread at a time */
+    if (!staged) {
+        elog_output_lock();
+        buf = log_buf;
+    }
 
 #ifdef ELOG_COLOR_ENABLE
     /* add CSI start sign and color info */
     if (elog.text_color_enabled) {
-        log_len += elog_strcpy(log_len, log_buf + log_len, CSI_START);
-        log_len += elog_strcpy(log_len, log_buf + log_len, color_output_info[level]);
+        log_len += elog_strcpy(log_len, buf + log_len, CSI_START);
+        log_len += elog_strcpy(log_len, buf + log_len, color_output_info[level]);
     }
 #endif
 
     /* package level info */
     if (get_fmt_enabled(level, ELOG_FMT_LVL)) {
-        log_len += elog_strcpy(log_len, log_buf + log_len, level_output_info[level]);
+        log_len += elog_strcpy(log_len, buf + log_len, level_output_info[level]);
     }
     /* package tag info */
     if (get_fmt_enabled(level, ELOG_FMT_TAG)) {
-        log_len += elog_strcpy(log_len, log_buf + log_len, tag);
+        log_len += elog_strcpy(log_len, buf + log_len, tag);
         /* if the tag length is less than 50% ELOG_FILTER_TAG_MAX_LEN, then fill space */
         if (tag_len <= ELOG_FILTER_TAG_MAX_LEN / 2) {
             memset(tag_sapce, ' ', ELOG_FILTER_TAG_MAX_LEN / 2 - tag_len);
-            log_len += elog_strcpy(log_len, log_buf + log_len, tag_sapce);
+            log_len += elog_strcpy(log_len, buf + log_len, tag_sapce);
         }
-        log_len += elog_strcpy(log_len, log_buf + log_len, " ");
+        log_len += elog_strcpy(log_len, buf + log_len, " ");
     }
     /* package time, process and thread info */
     if (get_fmt_enabled(level, ELOG_FMT_TIME | ELOG_FMT_P_INFO | ELOG_FMT_T_INFO)) {
-        log_len += elog_strcpy(log_len, log_buf + log_len, "[");
+        log_len += elog_strcpy(log_len, buf + log_len, "[");
         /* package time info */
         if (get_fmt_enabled(level, ELOG_FMT_TIME)) {
-            log_len += elog_strcpy(log_len, log_buf + log_len, elog_port_get_time());
+            log_len += elog_strcpy(log_len, buf + log_len, elog_port_get_time());
             if (get_fmt_enabled(level, ELOG_FMT_P_INFO | ELOG_FMT_T_INFO)) {
-                log_len += elog_strcpy(log_len, log_buf + log_len, " ");
+                log_len += elog_strcpy(log_len, buf + log_len, " ");
             }
         }
         /* package process info */
         if (get_fmt_enabled(level, ELOG_FMT_P_INFO)) {
-            log_len += elog_strcpy(log_len, log_buf + log_len, elog_port_get_p_info());
+            log_len += elog_strcpy(log_len, buf + log_len, elog_port_get_p_info());
             if (get_fmt_enabled(level, ELOG_FMT_T_INFO)) {
-                log_len += elog_strcpy(log_len, log_buf + log_len, " ");
+                log_len += elog_strcpy(log_len, buf + log_len, " ");
             }
         }
         /* package thread info */
         if (get_fmt_enabled(level, ELOG_FMT_T_INFO)) {
-            log_len += elog_strcpy(log_len, log_buf + log_len, elog_port_get_t_info());
+            log_len += elog_strcpy(log_len, buf + log_len, elog_port_get_t_info());
         }
-        log_len += elog_strcpy(log_len, log_buf + log_len, "] ");
+        log_len += elog_strcpy(log_len, buf + log_len, "] ");
     }
     /* package file directory and name, function name and line number info */
     if (get_fmt_used_and_enabled_ptr(level, ELOG_FMT_DIR, file) ||
             get_fmt_used_and_enabled_ptr(level, ELOG_FMT_FUNC, func) ||
             get_fmt_used_and_enabled_u32(level, ELOG_FMT_LINE, line)) {
-        log_len += elog_strcpy(log_len, log_buf + log_len, "(");
+        log_len += elog_strcpy(log_len, buf + log_len, "(");
         /* package file info */
         if (get_fmt_used_and_enabled_ptr(level, ELOG_FMT_DIR, file)) {
-            log_len += elog_strcpy(log_len, log_buf + log_len, file);
+            log_len += elog_strcpy(log_len, buf + log_len, file);
             if (get_fmt_used_and_enabled_ptr(level, ELOG_FMT_FUNC, func)) {
-                log_len += elog_strcpy(log_len, log_buf + log_len, ":");
+                log_len += elog_strcpy(log_len, buf + log_len, ":");
             } else if (get_fmt_used_and_enabled_u32(level, ELOG_FMT_LINE, line)) {
-                log_len += elog_strcpy(log_len, log_buf + log_len, " ");
+                log_len += elog_strcpy(log_len, buf + log_len, " ");
             }
         }
         /* package line info */
         if (get_fmt_used_and_enabled_u32(level, ELOG_FMT_LINE, line)) {
             snprintf(line_num, ELOG_LINE_NUM_MAX_LEN, "%ld", line);
-            log_len += elog_strcpy(log_len, log_buf + log_len, line_num);
+            log_len += elog_strcpy(log_len, buf + log_len, line_num);
             if (get_fmt_used_and_enabled_ptr(level, ELOG_FMT_FUNC, func)) {
-                log_len += elog_strcpy(log_len, log_buf + log_len, " ");
+                log_len += elog_strcpy(log_len, buf + log_len, " ");
             }
         }
         /* package func info */
         if (get_fmt_used_and_enabled_ptr(level, ELOG_FMT_FUNC, func)) {
-            log_len += elog_strcpy(log_len, log_buf + log_len, func);
+            log_len += elog_strcpy(log_len, buf + log_len, func);
             
         }
-        log_len += elog_strcpy(log_len, log_buf + log_len, ")");
+        log_len += elog_strcpy(log_len, buf + log_len, ")");
     }
     /* package other log data to buffer. '\0' must be added in the end by vsnprintf. */
-    fmt_result = vsnprintf(log_buf + log_len, ELOG_LINE_BUF_SIZE - log_len, format, args);
+    fmt_result = vsnprintf(buf + log_len, ELOG_LINE_BUF_SIZE - log_len, format, args);
 
-    va_end(args);
     /* calculate log length */
     if ((log_len + fmt_result <= ELOG_LINE_BUF_SIZE) && (fmt_result > -1)) {
         log_len += fmt_result;
@@ -691,11 +832,13 @@ void elog_output(uint8_t level, const char *tag, const char *file, const char *f
     /* keyword filter */
     if (elog.filter.keyword[0] != '\0') {
         /* add string end sign */
-        log_buf[log_len] = '\0';
+        buf[log_len] = '\0';
         /* find the keyword */
-        if (!strstr(log_buf, elog.filter.keyword)) {
+        if (!strstr(buf, elog.filter.keyword)) {
             /* unlock output */
-            elog_output_unlock();
+            if (!staged) {
+                elog_output_unlock();
+            }
             return;
         }
     }
@@ -703,26 +846,71 @@ void elog_output(uint8_t level, const char *tag, const char *file, const char *f
 #ifdef ELOG_COLOR_ENABLE
     /* add CSI end sign */
     if (elog.text_color_enabled) {
-        log_len += elog_strcpy(log_len, log_buf + log_len, CSI_END);
+        log_len += elog_strcpy(log_len, buf + log_len, CSI_END);
     }
 #endif
 
     /* package newline sign */
-    log_len += elog_strcpy(log_len, log_buf + log_len, ELOG_NEWLINE_SIGN);
+    log_len += elog_strcpy(log_len, buf + log_len, ELOG_NEWLINE_SIGN);
+#ifdef ELOG_CRASHLOG_ENABLE
+    /* kept before output, so the logs still waiting in the async buffer survive a fault too */
+    crashlog_write(buf, log_len);
+#endif
     /* output log */
 #if defined(ELOG_ASYNC_OUTPUT_ENABLE)
+    extern bool elog_async_output_try(uint8_t level, const char *log, size_t size);
     extern void elog_async_output(uint8_t level, const char *log, size_t size);
-    elog_async_output(level, log_buf, log_len);
+    /* staged log is published into the async ring buffer without the output lock */
+    if (staged && elog_async_output_try(level, buf, log_len)) {
+        return;
+    }
+#endif
+    if (staged) {
+        elog_output_lock();
+    }
+#if defined(ELOG_ASYNC_OUTPUT_ENABLE)
+    elog_async_output(level, buf, log_len);
 #elif defined(ELOG_BUF_OUTPUT_ENABLE)
     extern void elog_buf_output(const char *log, size_t size);
-    elog_buf_output(log_buf, log_len);
+    elog_buf_output(buf, log_len);
 #else
-    elog_port_output(log_buf, log_len);
+    elog_port_output(buf, log_len);
 #endif
     /* unlock output */
     elog_output_unlock();
 }
 
+/**
+ * get the staging buffer of current thread
+ *
+ * @return staging buffer, NULL when the port reports no current thread (ISR, before the kernel runs)
+ *         or when all staging buffers are taken by other threads
+ */
+static char *staging_buf_get(void) {
+#if ELOG_STAGING_BUF_NUM > 0
+    extern void *elog_port_get_thread(void);
+    void *self = elog_port_get_thread();
+    size_t i;
+
+    if (self == NULL) {
+        return NULL;
+    }
+    for (i = 0; i < ELOG_STAGING_BUF_NUM; i++) {
+        if (__atomic_load_n(&staging[i].owner, __ATOMIC_ACQUIRE) == self) {
+            return staging[i].buf;
+        }
+    }
+    for (i = 0; i < ELOG_STAGING_BUF_NUM; i++) {
+        void *expected = NULL;
+        if (__atomic_compare_exchange_n(&staging[i].owner, &expected, self, false,
+                __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            return staging[i].buf;
+        }
+    }
+#endif
+    return NULL;
+}
+
 /**
  * get format enabled
  *
@@ -64,6 +64,33 @@ static sem_t output_notice;
 static pthread_t async_output_thread;
 #endif /* ELOG_ASYNC_OUTPUT_USING_PTHREAD */
 
+#ifdef ELOG_ASYNC_OUTPUT_USING_OSAL
+#include "osal.h"
+/* thread default stack size */
+#ifndef ELOG_ASYNC_OUTPUT_OSAL_STACK_SIZE
+#define ELOG_ASYNC_OUTPUT_OSAL_STACK_SIZE        1024
+#endif
+/* thread default priority */
+#ifndef ELOG_ASYNC_OUTPUT_OSAL_PRIORITY
+#define ELOG_ASYNC_OUTPUT_OSAL_PRIORITY          E_OSAL_THREAD_PRIORITY_BACKGROUND
+#endif
+/* output thread poll get log buffer size  */
+#ifndef ELOG_ASYNC_LINE_OUTPUT
+#ifndef ELOG_ASYNC_POLL_GET_LOG_BUF_SIZE
+#define ELOG_ASYNC_POLL_GET_LOG_BUF_SIZE         (ELOG_ASYNC_OUTPUT_BUF_SIZE - 4)
+#endif
+#else
+#ifndef ELOG_ASYNC_POLL_GET_LOG_BUF_SIZE
+#define ELOG_ASYNC_POLL_GET_LOG_BUF_SIZE         (ELOG_LINE_BUF_SIZE - 4)
+#endif
+#endif
+
+/* asynchronous output log notice, binary semaphore so the notices of a burst are merged */
+static void *output_notice = NULL;
+/* asynchronous output OSAL thread */
+static void *async_output_thread = NULL;
+#endif /* ELOG_ASYNC_OUTPUT_USING_OSAL */
+
 /* the highest output level for async mode, other level will sync output */
 #ifdef ELOG_ASYNC_OUTPUT_LVL
 #define OUTPUT_LVL                               ELOG_ASYNC_OUTPUT_LVL
@@ -75,7 +102,7 @@ static pthread_t async_output_thread;
 #ifdef ELOG_ASYNC_OUTPUT_BUF_SIZE
 #define OUTPUT_BUF_SIZE                          ELOG_ASYNC_OUTPUT_BUF_SIZE
 #else
-#define OUTPUT_BUF_SIZE                          (ELOG_LINE_BUF_SIZE * 10)
+#define OUTPUT_BUF_SIZE                          (ELOG_LINE_BUF_SIZE * 16)
 #endif /* ELOG_ASYNC_OUTPUT_BUF_SIZE */
 
 /* Initialize OK flag */
@@ -86,143 +113,157 @@ static bool thread_running = false;
 #endif
 /* asynchronous output mode enabled flag */
 static bool is_enabled = false;
-/* asynchronous output mode's ring buffer */
-static char log_buf[OUTPUT_BUF_SIZE] = { 0 };
-/* log ring buffer write index */
-static size_t write_index = 0;
-/* log ring buffer read index */
-static size_t read_index = 0;
-/* log ring buffer full flag */
-static bool buf_is_full = false;
-/* log ring buffer empty flag */
-static bool buf_is_empty = true;
+
+/* the ring buffer indexes run freely and wrap with the buffer size */
+#if (OUTPUT_BUF_SIZE & (OUTPUT_BUF_SIZE - 1)) != 0 || OUTPUT_BUF_SIZE < 64
+#error "ELOG_ASYNC_OUTPUT_BUF_SIZE must be a power of two"
+#endif
+
+/* every log is one record: HEADER(4) | LOG | PADDING to 4 bytes, HEADER is COMMIT | log size */
+#define RECORD_HEAD_SIZE                         4
+#define RECORD_COMMIT                            0x80000000UL
+#define RECORD_SIZE(size)                        (RECORD_HEAD_SIZE + (((size) + 3) & ~3UL))
+
+/**
+ * asynchronous output mode's ring buffer
+ * producers reserve a record with a CAS on reserve_index and commit it by
+ * writing its header, so loggers never wait on each other. The output thread
+ * is the only consumer, it stops at the first record not committed yet and
+ * zeroes consumed space, so a header in free space always reads uncommitted.
+ */
+static uint32_t log_buf[OUTPUT_BUF_SIZE / 4] = { 0 };
+/* log ring buffer reserve index, shared by producers */
+static uint32_t reserve_index = 0;
+/* log ring buffer read index, only written by consumer */
+static uint32_t read_index = 0;
+/* read offset in the current record, only used by consumer */
+static size_t read_offset = 0;
+/* dropped log count, the ring buffer was full */
+static uint32_t drop_count = 0;
 
 extern void elog_port_output(const char *log, size_t size);
 extern void elog_output_lock(void);
 extern void elog_output_unlock(void);
 
 /**
- * asynchronous output ring buffer used size
+ * copy data into the ring buffer, wraps at the end of the buffer
  *
- * @return used size
+ * @param index ring buffer byte index
+ * @param data data
+ * @param size data size
  */
-static size_t elog_async_get_buf_used(void) {
-    if (write_index > read_index) {
-        return write_index - read_index;
-    } else {
-        if (!buf_is_full && !buf_is_empty) {
-            return OUTPUT_BUF_SIZE - (read_index - write_index);
-        } else if (buf_is_full) {
-            return OUTPUT_BUF_SIZE;
-        } else {
-            return 0;
-        }
-    }
+static void async_buf_write(uint32_t index, const char *data, size_t size) {
+    char *buf = (char *)log_buf;
+    size_t offset = index & (OUTPUT_BUF_SIZE - 1);
+    size_t first = (size < OUTPUT_BUF_SIZE - offset) ? size : OUTPUT_BUF_SIZE - offset;
+
+    memcpy(buf + offset, data, first);
+    memcpy(buf, data + first, size - first);
+}
+
+/**
+ * copy data out of the ring buffer, wraps at the end of the buffer
+ *
+ * @param index ring buffer byte index
+ * @param data data
+ * @param size data size
+ */
+static void async_buf_read(uint32_t index, char *data, size_t size) {
+    const char *buf = (const char *)log_buf;
+    size_t offset = index & (OUTPUT_BUF_SIZE - 1);
+    size_t first = (size < OUTPUT_BUF_SIZE - offset) ? size : OUTPUT_BUF_SIZE - offset;
+
+    memcpy(data, buf + offset, first);
+    memcpy(data + first, buf, size - first);
 }
 
 /**
- * asynchronous output ring buffer remain space
+ * zero the consumed space of the ring buffer
  *
- * @return remain space
+ * @param index ring buffer byte index
+ * @param size space size, multiple of 4
  */
-static size_t async_get_buf_space(void) {
-    return OUTPUT_BUF_SIZE - elog_async_get_buf_used();
+static void async_buf_clear(uint32_t index, size_t size) {
+    char *buf = (char *)log_buf;
+    size_t offset = index & (OUTPUT_BUF_SIZE - 1);
+    size_t first = (size < OUTPUT_BUF_SIZE - offset) ? size : OUTPUT_BUF_SIZE - offset;
+
+    memset(buf + offset, 0, first);
+    memset(buf, 0, size - first);
 }
 
 /**
- * put log to asynchronous output ring buffer
+ * put log to asynchronous output ring buffer, lock-free and safe for any number of producers
  *
  * @param log put log buffer
  * @param size log size
  *
- * @return put log size, the log which beyond ring buffer space will be dropped
+ * @return put log size, 0 when the ring buffer has no space and the log is dropped
  */
 static size_t async_put_log(const char *log, size_t size) {
-    size_t space = 0;
-
-    space = async_get_buf_space();
-    /* no space */
-    if (!space) {
-        size = 0;
-        goto __exit;
-    }
-    /* drop some log */
-    if (space <= size) {
-        size = space;
-        buf_is_full = true;
-    }
+    uint32_t need = RECORD_SIZE(size);
+    uint32_t index = __atomic_load_n(&reserve_index, __ATOMIC_RELAXED);
 
-    if (write_index + size < OUTPUT_BUF_SIZE) {
-        memcpy(log_buf + write_index, log, size);
-        write_index += size;
-    } else {
-        memcpy(log_buf + write_index, log, OUTPUT_BUF_SIZE - write_index);
-        memcpy(log_buf, log + OUTPUT_BUF_SIZE - write_index,
-                size - (OUTPUT_BUF_SIZE - write_index));
-        write_index += size - OUTPUT_BUF_SIZE;
+    if (!size || need > OUTPUT_BUF_SIZE) {
+        return 0;
     }
+    /* reserve */
+    do {
+        if (index + need - __atomic_load_n(&read_index, __ATOMIC_ACQUIRE) > OUTPUT_BUF_SIZE) {
+            __atomic_fetch_add(&drop_count, 1, __ATOMIC_RELAXED);
+            return 0;
+        }
+    } while (!__atomic_compare_exchange_n(&reserve_index, &index, index + need, true,
+            __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
 
-    buf_is_empty = false;
-
-__exit:
+    /* copy and commit */
+    async_buf_write(index + RECORD_HEAD_SIZE, log, size);
+    __atomic_store_n(&log_buf[(index & (OUTPUT_BUF_SIZE - 1)) / 4], RECORD_COMMIT | size, __ATOMIC_RELEASE);
 
     return size;
 }
 
-#ifdef ELOG_ASYNC_LINE_OUTPUT
 /**
- * Get line log from asynchronous output ring buffer.
- * It will copy all log when the newline sign isn't find.
+ * Get one log from asynchronous output ring buffer, a log larger than the
+ * buffer is returned by several calls. Only called by the output thread.
  *
  * @param log get line log buffer
  * @param size line log size
  *
- * @return get line log size, the log size is less than ring buffer used size
+ * @return get line log size, 0 when no committed log
  */
 size_t elog_async_get_line_log(char *log, size_t size) {
-    size_t used = 0, cpy_log_size = 0;
-    /* lock output */
-    elog_output_lock();
-    used = elog_async_get_buf_used();
-
-    /* no log */
-    if (!used || !size) {
-        goto __exit;
-    }
-    /* less log */
-    if (used <= size) {
-        size = used;
-    }
+    uint32_t index = read_index;
+    uint32_t head, log_size, cpy_log_size;
 
-    if (read_index + size < OUTPUT_BUF_SIZE) {
-        cpy_log_size = elog_cpyln(log, log_buf + read_index, size);
-        read_index += cpy_log_size;
-    } else {
-        cpy_log_size = elog_cpyln(log, log_buf + read_index, OUTPUT_BUF_SIZE - read_index);
-        if (cpy_log_size == OUTPUT_BUF_SIZE - read_index) {
-            cpy_log_size += elog_cpyln(log + cpy_log_size, log_buf, size - cpy_log_size);
-            read_index += cpy_log_size - OUTPUT_BUF_SIZE;
-        } else {
-            read_index += cpy_log_size;
-        }
+    if (!size || index == __atomic_load_n(&reserve_index, __ATOMIC_ACQUIRE)) {
+        return 0;
+    }
+    head = __atomic_load_n(&log_buf[(index & (OUTPUT_BUF_SIZE - 1)) / 4], __ATOMIC_ACQUIRE);
+    /* reserved but not committed yet, its producer notifies again after commit */
+    if (!(head & RECORD_COMMIT)) {
+        return 0;
     }
 
-    if (used == cpy_log_size) {
-        buf_is_empty = true;
+    log_size = head & ~RECORD_COMMIT;
+    cpy_log_size = log_size - read_offset;
+    if (cpy_log_size > size) {
+        cpy_log_size = size;
     }
+    async_buf_read(index + RECORD_HEAD_SIZE + read_offset, log, cpy_log_size);
+    read_offset += cpy_log_size;
 
-    if (cpy_log_size) {
-        buf_is_full = false;
+    if (read_offset == log_size) {
+        read_offset = 0;
+        async_buf_clear(index, RECORD_SIZE(log_size));
+        __atomic_store_n(&read_index, index + RECORD_SIZE(log_size), __ATOMIC_RELEASE);
     }
 
-__exit:
-    /* lock output */
-    elog_output_unlock();
     return cpy_log_size;
 }
-#else
+
 /**
- * get log from asynchronous output ring buffer
+ * get log from asynchronous output ring buffer. Only called by the output thread.
  *
  * @param log get log buffer
  * @param size log size
@@ -230,56 +271,50 @@ __exit:
  * @return get log size, the log size is less than ring buffer used size
  */
 size_t elog_async_get_log(char *log, size_t size) {
-    size_t used = 0;
-    /* lock output */
-    elog_output_lock();
-    used = elog_async_get_buf_used();
-    /* no log */
-    if (!used || !size) {
-        size = 0;
-        goto __exit;
-    }
-    /* less log */
-    if (used <= size) {
-        size = used;
-        buf_is_empty = true;
-    }
+    size_t get_size = 0, line_size;
 
-    if (read_index + size < OUTPUT_BUF_SIZE) {
-        memcpy(log, log_buf + read_index, size);
-        read_index += size;
-    } else {
-        memcpy(log, log_buf + read_index, OUTPUT_BUF_SIZE - read_index);
-        memcpy(log + OUTPUT_BUF_SIZE - read_index, log_buf,
-                size - (OUTPUT_BUF_SIZE - read_index));
-        read_index += size - OUTPUT_BUF_SIZE;
+    while (get_size < size && (line_size = elog_async_get_line_log(log + get_size, size - get_size))) {
+        get_size += line_size;
     }
 
-    buf_is_full = false;
+    return get_size;
+}
 
-__exit:
-    /* lock output */
-    elog_output_unlock();
-    return size;
+/**
+ * get the count of logs dropped because the ring buffer was full
+ *
+ * @return dropped log count
+ */
+uint32_t elog_async_get_drop_count(void) {
+    return __atomic_load_n(&drop_count, __ATOMIC_RELAXED);
 }
-#endif /* ELOG_ASYNC_LINE_OUTPUT */
 
-void elog_async_output(uint8_t level, const char *log, size_t size) {
+/**
+ * put log to asynchronous output ring buffer if the level is output asynchronously
+ * it does not need the output lock
+ *
+ * @param level level
+ * @param log log
+ * @param size log size
+ *
+ * @return true: the log is handled (put or dropped), false: the caller must output it synchronously
+ */
+bool elog_async_output_try(uint8_t level, const char *log, size_t size) {
     /* this function must be implement by user when ELOG_ASYNC_OUTPUT_USING_PTHREAD is not defined */
     extern void elog_async_output_notice(void);
-    size_t put_size;
-
-    if (is_enabled) {
-        if (level >= OUTPUT_LVL) {
-            put_size = async_put_log(log, size);
-            /* notify output log thread */
-            if (put_size > 0) {
-                elog_async_output_notice();
-            }
-        } else {
-            elog_port_output(log, size);
-        }
-    } else {
+
+    if (!is_enabled || level < OUTPUT_LVL) {
+        return false;
+    }
+    /* notify output log thread */
+    if (async_put_log(log, size) > 0) {
+        elog_async_output_notice();
+    }
+    return true;
+}
+
+void elog_async_output(uint8_t level, const char *log, size_t size) {
+    if (!elog_async_output_try(level, log, size)) {
         elog_port_output(log, size);
     }
 }
@@ -316,6 +351,40 @@ static void *async_output(void *arg) {
 }
 #endif
 
+#ifdef ELOG_ASYNC_OUTPUT_USING_OSAL
+void elog_async_output_notice(void) {
+    osal_semaphore_release(output_notice);
+}
+
+static void async_output(void *arg) {
+    size_t get_log_size = 0;
+    static char poll_get_buf[ELOG_ASYNC_POLL_GET_LOG_BUF_SIZE];
+
+    /* OSAL threads can not be joined, the thread lives on across deinit and init */
+    while(true) {
+        /* waiting log */
+        if (osal_semaphore_acquire(output_notice, D_OSAL_CORE_TIMEOUT_FOREVER) != E_OSAL_RET_STATUS_OK) {
+            continue;
+        }
+        /* polling gets and outputs the log */
+        while(true) {
+
+#ifdef ELOG_ASYNC_LINE_OUTPUT
+            get_log_size = elog_async_get_line_log(poll_get_buf, ELOG_ASYNC_POLL_GET_LOG_BUF_SIZE);
+#else
+            get_log_size = elog_async_get_log(poll_get_buf, ELOG_ASYNC_POLL_GET_LOG_BUF_SIZE);
+#endif
+
+            if (get_log_size) {
+                elog_port_output(poll_get_buf, get_log_size);
+            } else {
+                break;
+            }
+        }
+    }
+}
+#endif
+
 /**
  * enable or disable asynchronous output mode
  * the log will be output directly when mode is disabled
@@ -356,6 +425,28 @@ ElogErrCode elog_async_init(void) {
     pthread_attr_destroy(&thread_attr);
 #endif
 
+#ifdef ELOG_ASYNC_OUTPUT_USING_OSAL
+    S_OSAL_SEMAPHORE_CONFIG_T semaphore_config = {
+        .p_name = "elog async",
+    };
+    S_OSAL_THREAD_CONFIG_T thread_config = {
+        .p_name = "elog async",
+        .p_entry = async_output,
+        .p_arg = NULL,
+        .stack_size = ELOG_ASYNC_OUTPUT_OSAL_STACK_SIZE,
+        .priority = ELOG_ASYNC_OUTPUT_OSAL_PRIORITY,
+    };
+
+    if (output_notice == NULL
+            && osal_semaphore_create(&output_notice, &semaphore_config, 1, 0) != E_OSAL_RET_STATUS_OK) {
+        return ELOG_RES_ERR;
+    }
+    if (async_output_thread == NULL
+            && osal_thread_create(&async_output_thread, &thread_config) != E_OSAL_RET_STATUS_OK) {
+        return ELOG_RES_ERR;
+    }
+#endif
+
     init_ok = true;
 
     return result;
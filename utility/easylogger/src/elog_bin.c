@@ -0,0 +1,247 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Binary output mode. The format string is not rendered on target,
+ *           only its address and the raw arguments are recorded, a host tool
+ *           renders the text with the strings taken from the ELF file.
+ * Created on: 2026-10-19
+ */
+
+#include <elog.h>
+#include <string.h>
+#include <stdarg.h>
+
+#ifdef ELOG_BIN_OUTPUT_ENABLE
+
+/* frame max size, the arguments beyond it are dropped and the frame is marked truncated */
+#ifndef ELOG_BIN_FRAME_MAX_SIZE
+#define ELOG_BIN_FRAME_MAX_SIZE                  64
+#endif
+/* max length of each string argument copied into the frame */
+#ifndef ELOG_BIN_STR_MAX_LEN
+#define ELOG_BIN_STR_MAX_LEN                     24
+#endif
+
+/* frame layout, multi-byte fields are little endian
+ * SYNC(1) | LEN(1) | LVL(1) | TICK(4) | TAG(4) | FMT(4) | ARGS | CHK(1)
+ * LEN is the size of LVL ... ARGS, CHK is the XOR of the same bytes */
+#define HEAD_SIZE                                2
+#define BODY_FIXED_SIZE                          13
+#define CHK_SIZE                                 1
+#define ARGS_MAX_SIZE                            (ELOG_BIN_FRAME_MAX_SIZE - HEAD_SIZE - BODY_FIXED_SIZE - CHK_SIZE)
+
+#if ELOG_BIN_FRAME_MAX_SIZE > (255 + HEAD_SIZE + CHK_SIZE) || ARGS_MAX_SIZE < 8
+#error "ELOG_BIN_FRAME_MAX_SIZE is out of range"
+#endif
+
+extern void elog_port_output(const char *log, size_t size);
+extern void elog_output_lock(void);
+extern void elog_output_unlock(void);
+extern uint32_t elog_port_get_timestamp(void);
+
+/**
+ * put a little endian integer
+ *
+ * @param buf destination
+ * @param value value
+ * @param size value size in byte
+ */
+static void bin_put(uint8_t *buf, uint64_t value, size_t size) {
+    while (size--) {
+        *buf++ = (uint8_t)value;
+        value >>= 8;
+    }
+}
+
+/**
+ * pack the arguments by walking the format string, only the conversion
+ * types are parsed, nothing is rendered
+ *
+ * @param buf arguments buffer
+ * @param size arguments buffer size
+ * @param format format string
+ * @param args arguments
+ * @param truncated set when the arguments do not fit in the buffer
+ *
+ * @return packed size
+ */
+static size_t bin_pack_args(uint8_t *buf, size_t size, const char *format, va_list *args, bool *truncated) {
+    size_t len = 0;
+
+    while (*format) {
+        uint8_t length = 0; /* 0: int, 1: long/size_t, 2: long long/intmax_t */
+        uint64_t value;
+        size_t value_size = 4;
+
+        if (*format++ != '%') {
+            continue;
+        }
+        if (*format == '%') {
+            format++;
+            continue;
+        }
+        /* flags, width and precision, '*' takes an int argument */
+        while (*format && strchr("-+ #0123456789.*", *format)) {
+            if (*format == '*') {
+                if (len + 4 > size) {
+                    goto __truncated;
+                }
+                bin_put(buf + len, (uint32_t)va_arg(*args, int), 4);
+                len += 4;
+            }
+            format++;
+        }
+        /* length modifier, 'h' and 'hh' are promoted to int */
+        if (*format == 'l') {
+            length = (*++format == 'l') ? 2 : 1;
+            format += (length == 2);
+        } else if (*format == 'j') {
+            length = 2;
+            format++;
+        } else if (*format && strchr("hLzt", *format)) {
+            length = (*format == 'z' || *format == 't') ? 1 : 0;
+            while (*format == 'h' || *format == 'L' || *format == 'z' || *format == 't') {
+                format++;
+            }
+        }
+        switch (*format) {
+        case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c':
+            if (length == 2) {
+                value = va_arg(*args, unsigned long long);
+                value_size = 8;
+            } else if (length == 1) {
+                value = va_arg(*args, unsigned long);
+            } else {
+                value = va_arg(*args, unsigned int);
+            }
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': {
+            double d = va_arg(*args, double);
+            memcpy(&value, &d, sizeof(value));
+            value_size = 8;
+            break;
+        }
+        case 'p':
+            value = (uintptr_t)va_arg(*args, void *);
+            break;
+        case 's': {
+            const char *str = va_arg(*args, const char *);
+            size_t str_len = str ? strlen(str) : 0;
+            if (str_len > ELOG_BIN_STR_MAX_LEN) {
+                str_len = ELOG_BIN_STR_MAX_LEN;
+            }
+            if (len + 1 + str_len > size) {
+                goto __truncated;
+            }
+            buf[len++] = (uint8_t)str_len;
+            memcpy(buf + len, str, str_len);
+            len += str_len;
+            format++;
+            continue;
+        }
+        default:
+            /* '%n' or unknown conversion, no argument is recorded */
+            if (*format) {
+                format++;
+            }
+            continue;
+        }
+        if (len + value_size > size) {
+            goto __truncated;
+        }
+        bin_put(buf + len, value, value_size);
+        len += value_size;
+        format++;
+    }
+    return len;
+
+__truncated:
+    *truncated = true;
+    return len;
+}
+
+/**
+ * output the log in binary mode
+ *
+ * @param level level
+ * @param tag tag, must be a string literal so that the host tool can find it in the ELF file
+ * @param format output format, must be a string literal too
+ * @param ... args
+ */
+void elog_bin_output(uint8_t level, const char *tag, const char *format, ...) {
+    uint8_t frame[ELOG_BIN_FRAME_MAX_SIZE];
+    uint8_t *body = frame + HEAD_SIZE;
+    size_t args_len, body_len, i;
+    bool truncated = false;
+    uint8_t chk = 0;
+    va_list args;
+
+    ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
+
+    /* check output enabled and level filter, tag and keyword filters need the rendered text and are not applied */
+    if (!elog_get_output_enabled()) {
+        return;
+    }
+    if (level > elog_get_filter_lvl() || level > elog_get_filter_tag_lvl(tag)) {
+        return;
+    }
+
+    /* the frame is built on the caller's stack, no lock is needed until it is published */
+    va_start(args, format);
+    args_len = bin_pack_args(body + BODY_FIXED_SIZE, ARGS_MAX_SIZE, format, &args, &truncated);
+    va_end(args);
+
+    body_len = BODY_FIXED_SIZE + args_len;
+    frame[0] = ELOG_BIN_SYNC;
+    frame[1] = (uint8_t)body_len;
+    body[0] = level | (truncated ? ELOG_BIN_LVL_TRUNCATED : 0);
+    bin_put(body + 1, elog_port_get_timestamp(), 4);
+    bin_put(body + 5, (uintptr_t)tag, 4);
+    bin_put(body + 9, (uintptr_t)format, 4);
+    for (i = 0; i < body_len; i++) {
+        chk ^= body[i];
+    }
+    body[body_len] = chk;
+
+#if defined(ELOG_ASYNC_OUTPUT_ENABLE)
+    extern bool elog_async_output_try(uint8_t level, const char *log, size_t size);
+    /* published into the async ring buffer without the output lock */
+    if (elog_async_output_try(level, (const char *)frame, HEAD_SIZE + body_len + CHK_SIZE)) {
+        return;
+    }
+#endif
+    /* lock output */
+    elog_output_lock();
+#if defined(ELOG_ASYNC_OUTPUT_ENABLE)
+    extern void elog_async_output(uint8_t level, const char *log, size_t size);
+    elog_async_output(level, (const char *)frame, HEAD_SIZE + body_len + CHK_SIZE);
+#elif defined(ELOG_BUF_OUTPUT_ENABLE)
+    extern void elog_buf_output(const char *log, size_t size);
+    elog_buf_output((const char *)frame, HEAD_SIZE + body_len + CHK_SIZE);
+#else
+    elog_port_output((const char *)frame, HEAD_SIZE + body_len + CHK_SIZE);
+#endif
+    /* unlock output */
+    elog_output_unlock();
+}
+
+#endif /* ELOG_BIN_OUTPUT_ENABLE */
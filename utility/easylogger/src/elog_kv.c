@@ -0,0 +1,382 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Structured key-value logs. A record is an event ID and typed
+ *           fields keyed by field ID, CBOR encoded on the caller's stack:
+ *           [event, level, tag, tick, {field: value, ...}]. It is published
+ *           as one frame, or rendered as a text line when binary output of
+ *           key-value logs is disabled.
+ * Created on: 2026-10-19
+ */
+
+#include <elog.h>
+#include <string.h>
+#include <stdio.h>
+
+#ifdef ELOG_KV_ENABLE
+
+#if ELOG_KV_FRAME_MAX_SIZE > 255 || ELOG_KV_FRAME_MAX_SIZE < 32
+#error "ELOG_KV_FRAME_MAX_SIZE is out of range"
+#endif
+
+/* frame layout: SYNC(1) | LEN(1) | CBOR record | CHK(1), LEN is the CBOR size, CHK the XOR of its bytes */
+#define HEAD_SIZE                                2
+#define CHK_SIZE                                 1
+/* event and level are encoded in the 2 bytes form, so the level is at a fixed place for the truncated flag */
+#define LVL_POS                                  (HEAD_SIZE + 4)
+/* map size is encoded in the 1 byte form */
+#define FIELD_MAX_NUM                            23
+
+/* CBOR major types */
+#define CBOR_UINT                                0x00
+#define CBOR_NINT                                0x20
+#define CBOR_TEXT                                0x60
+#define CBOR_ARRAY                               0x80
+#define CBOR_MAP                                 0xA0
+#define CBOR_FALSE                               0xF4
+#define CBOR_TRUE                                0xF5
+#define CBOR_FLOAT32                             0xFA
+
+extern void elog_port_output(const char *log, size_t size);
+extern void elog_output_lock(void);
+extern void elog_output_unlock(void);
+extern uint32_t elog_port_get_timestamp(void);
+
+#ifndef ELOG_KV_OUTPUT_BIN
+static const char * const event_name[ELOG_KV_EVENT_ID_NUM] = {
+#define ELOG_KV_EVENT_DEF(id, name)          [ELOG_KV_EVENT_ID_##id] = name,
+#define ELOG_KV_FIELD_DEF(id, name)
+#include <elog_kv_cfg.h>
+#undef ELOG_KV_EVENT_DEF
+#undef ELOG_KV_FIELD_DEF
+};
+static const char * const field_name[ELOG_KV_FIELD_ID_NUM] = {
+#define ELOG_KV_EVENT_DEF(id, name)
+#define ELOG_KV_FIELD_DEF(id, name)          [ELOG_KV_FIELD_ID_##id] = name,
+#include <elog_kv_cfg.h>
+#undef ELOG_KV_EVENT_DEF
+#undef ELOG_KV_FIELD_DEF
+};
+#endif /* ELOG_KV_OUTPUT_BIN */
+
+/**
+ * size of a CBOR head with the value
+ */
+static size_t cbor_head_size(uint32_t value) {
+    return value < 24 ? 1 : value <= 0xFF ? 2 : value <= 0xFFFF ? 3 : 5;
+}
+
+/**
+ * put a CBOR head, the argument is big endian
+ *
+ * @param buf destination
+ * @param major major type
+ * @param value argument
+ *
+ * @return head size
+ */
+static size_t cbor_head(uint8_t *buf, uint8_t major, uint32_t value) {
+    size_t size = cbor_head_size(value), i;
+
+    if (size == 1) {
+        buf[0] = major | (uint8_t)value;
+        return 1;
+    }
+    buf[0] = major | (size == 2 ? 24 : size == 3 ? 25 : 26);
+    for (i = size - 1; i > 0; i--) {
+        buf[i] = (uint8_t)value;
+        value >>= 8;
+    }
+    return size;
+}
+
+/**
+ * reserve room for a field, the key is put
+ *
+ * @param kv record
+ * @param field_id field ID
+ * @param value_size encoded value size
+ *
+ * @return where the value goes, NULL when the record is disabled or full
+ */
+static uint8_t *field_reserve(ElogKv *kv, ElogKvFieldId field_id, size_t value_size) {
+    size_t key_size = cbor_head_size(field_id);
+
+    if (kv->len == 0) {
+        return NULL;
+    }
+    if (kv->field_num >= FIELD_MAX_NUM || kv->len + key_size + value_size + CHK_SIZE > ELOG_KV_FRAME_MAX_SIZE) {
+        kv->truncated = true;
+        return NULL;
+    }
+    kv->len += cbor_head(kv->frame + kv->len, CBOR_UINT, field_id);
+    kv->field_num++;
+    kv->len += value_size;
+    return kv->frame + kv->len - value_size;
+}
+
+/**
+ * start a key-value log record
+ *
+ * @param kv record, usually on the caller's stack
+ * @param level level
+ * @param tag_id declared tag ID
+ * @param event_id declared event ID
+ *
+ * @return false when the level is filtered out, the fields and end are ignored then
+ */
+bool elog_kv_begin(ElogKv *kv, uint8_t level, ElogTagId tag_id, ElogKvEventId event_id) {
+    uint8_t *p = kv->frame + HEAD_SIZE;
+
+    ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
+    ELOG_ASSERT(tag_id < ELOG_TAG_ID_NUM && event_id < ELOG_KV_EVENT_ID_NUM);
+
+    kv->len = 0;
+    if (!elog_get_output_enabled() || level > ELOG_OUTPUT_LVL || (int8_t)level > elog_tag_lvl[tag_id]) {
+        return false;
+    }
+    kv->level = level;
+    kv->tag_id = tag_id;
+    kv->field_num = 0;
+    kv->truncated = false;
+
+    /* [event, level, tag, tick, {fields}], map size is set at the end */
+    *p++ = CBOR_ARRAY | 5;
+    *p++ = CBOR_UINT | 24;
+    *p++ = event_id;
+    *p++ = CBOR_UINT | 24;
+    *p++ = level;
+    p += cbor_head(p, CBOR_UINT, tag_id);
+    p += cbor_head(p, CBOR_UINT, elog_port_get_timestamp());
+    kv->map_pos = (uint8_t)(p - kv->frame);
+    *p++ = CBOR_MAP;
+    kv->len = (uint8_t)(p - kv->frame);
+
+    return true;
+}
+
+void elog_kv_uint(ElogKv *kv, ElogKvFieldId field_id, uint32_t value) {
+    uint8_t *p = field_reserve(kv, field_id, cbor_head_size(value));
+
+    if (p) {
+        cbor_head(p, CBOR_UINT, value);
+    }
+}
+
+void elog_kv_int(ElogKv *kv, ElogKvFieldId field_id, int32_t value) {
+    /* CBOR negative integer n is encoded as -1 - n */
+    uint32_t arg = value < 0 ? (uint32_t)(-1 - value) : (uint32_t)value;
+    uint8_t *p = field_reserve(kv, field_id, cbor_head_size(arg));
+
+    if (p) {
+        cbor_head(p, value < 0 ? CBOR_NINT : CBOR_UINT, arg);
+    }
+}
+
+void elog_kv_bool(ElogKv *kv, ElogKvFieldId field_id, bool value) {
+    uint8_t *p = field_reserve(kv, field_id, 1);
+
+    if (p) {
+        *p = value ? CBOR_TRUE : CBOR_FALSE;
+    }
+}
+
+void elog_kv_float(ElogKv *kv, ElogKvFieldId field_id, float value) {
+    uint8_t *p = field_reserve(kv, field_id, 5);
+    uint32_t bits;
+
+    if (p) {
+        memcpy(&bits, &value, sizeof(bits));
+        p[0] = CBOR_FLOAT32;
+        p[1] = (uint8_t)(bits >> 24);
+        p[2] = (uint8_t)(bits >> 16);
+        p[3] = (uint8_t)(bits >> 8);
+        p[4] = (uint8_t)bits;
+    }
+}
+
+/**
+ * add a string field, a string longer than the room left is cut and the record is marked truncated
+ */
+void elog_kv_str(ElogKv *kv, ElogKvFieldId field_id, const char *value) {
+    size_t len = strlen(value), room;
+    uint8_t *p;
+
+    if (kv->len == 0) {
+        return;
+    }
+    /* at least the string head and one character */
+    if (kv->len + cbor_head_size(field_id) + 1 + 1 + CHK_SIZE > ELOG_KV_FRAME_MAX_SIZE) {
+        kv->truncated = true;
+        return;
+    }
+    room = ELOG_KV_FRAME_MAX_SIZE - CHK_SIZE - kv->len - cbor_head_size(field_id);
+    if (cbor_head_size(len) + len > room) {
+        /* a cut length of 24 or more takes the 2 bytes head */
+        len = room - (room > 24 ? 2 : 1);
+        kv->truncated = true;
+    }
+    p = field_reserve(kv, field_id, cbor_head_size(len) + len);
+    if (p) {
+        p += cbor_head(p, CBOR_TEXT, len);
+        memcpy(p, value, len);
+    }
+}
+
+#ifndef ELOG_KV_OUTPUT_BIN
+/**
+ * read a CBOR head
+ *
+ * @param p position, moved behind the head
+ * @param major major type
+ *
+ * @return argument
+ */
+static uint32_t cbor_get(const uint8_t **p, uint8_t *major) {
+    uint8_t info = **p & 0x1F;
+    uint32_t value = 0;
+    size_t size = info < 24 ? 0 : info == 24 ? 1 : info == 25 ? 2 : 4;
+
+    *major = **p & 0xE0;
+    (*p)++;
+    if (size == 0) {
+        return info;
+    }
+    while (size--) {
+        value = value << 8 | *(*p)++;
+    }
+    return value;
+}
+
+/**
+ * append a string to the text line, one byte is always left for the terminator
+ */
+static size_t kv_text_cat(char *text, size_t len, const char *src) {
+    while (*src != '\0' && len < ELOG_LINE_BUF_SIZE - 1) {
+        text[len++] = *src++;
+    }
+    return len;
+}
+
+/**
+ * render the record as a text line: event field=value ...
+ */
+static void kv_render(const ElogKv *kv) {
+    char text[ELOG_LINE_BUF_SIZE];
+    const uint8_t *p = kv->frame + HEAD_SIZE + 1, *end = kv->frame + kv->len;
+    size_t len = 0, n;
+    uint32_t value, event, field, bits;
+    uint8_t major;
+    float f;
+
+    event = cbor_get(&p, &major);
+    /* level, tag and tick are printed by the text format */
+    cbor_get(&p, &major);
+    cbor_get(&p, &major);
+    cbor_get(&p, &major);
+    cbor_get(&p, &major);
+    /* len stays below sizeof(text) all along, snprintf results are cut to the room left */
+    len = kv_text_cat(text, len, event_name[event]);
+    while (p < end && len < sizeof(text) - 1) {
+        field = cbor_get(&p, &major);
+        len = kv_text_cat(text, len, " ");
+        len = kv_text_cat(text, len, field_name[field]);
+        len = kv_text_cat(text, len, "=");
+        if (*p == CBOR_FALSE || *p == CBOR_TRUE) {
+            len = kv_text_cat(text, len, *p++ == CBOR_TRUE ? "true" : "false");
+            continue;
+        }
+        if (*p == CBOR_FLOAT32) {
+            bits = (uint32_t)p[1] << 24 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 8 | p[4];
+            memcpy(&f, &bits, sizeof(f));
+            p += 5;
+            n = snprintf(text + len, sizeof(text) - len, "%g", (double)f);
+            len = n < sizeof(text) - len ? len + n : sizeof(text) - 1;
+            continue;
+        }
+        value = cbor_get(&p, &major);
+        if (major == CBOR_TEXT) {
+            n = snprintf(text + len, sizeof(text) - len, "\"%.*s\"", (int)value, (const char *)p);
+            p += value;
+        } else {
+            n = snprintf(text + len, sizeof(text) - len, major == CBOR_NINT ? "-%lu" : "%lu",
+                    (unsigned long)value + (major == CBOR_NINT ? 1 : 0));
+        }
+        len = n < sizeof(text) - len ? len + n : sizeof(text) - 1;
+    }
+    text[len] = '\0';
+    elog_output_id(kv->level, (ElogTagId)kv->tag_id, "", "", 0, kv->truncated ? "%s ..." : "%s", text);
+}
+#endif /* ELOG_KV_OUTPUT_BIN */
+
+/**
+ * finish and output a key-value log record
+ *
+ * @param kv record
+ */
+void elog_kv_end(ElogKv *kv) {
+#ifdef ELOG_KV_OUTPUT_BIN
+    size_t body_len, i;
+    uint8_t chk = 0;
+#endif
+
+    if (kv->len == 0) {
+        return;
+    }
+    kv->frame[kv->map_pos] = CBOR_MAP | kv->field_num;
+    kv->frame[LVL_POS] = kv->level | (kv->truncated ? ELOG_BIN_LVL_TRUNCATED : 0);
+
+#ifndef ELOG_KV_OUTPUT_BIN
+    kv_render(kv);
+#else
+    body_len = kv->len - HEAD_SIZE;
+    kv->frame[0] = ELOG_KV_SYNC;
+    kv->frame[1] = (uint8_t)body_len;
+    for (i = HEAD_SIZE; i < kv->len; i++) {
+        chk ^= kv->frame[i];
+    }
+    kv->frame[kv->len] = chk;
+
+#if defined(ELOG_ASYNC_OUTPUT_ENABLE)
+    extern bool elog_async_output_try(uint8_t level, const char *log, size_t size);
+    /* published into the async ring buffer without the output lock */
+    if (elog_async_output_try(kv->level, (const char *)kv->frame, kv->len + CHK_SIZE)) {
+        return;
+    }
+#endif
+    /* lock output */
+    elog_output_lock();
+#if defined(ELOG_ASYNC_OUTPUT_ENABLE)
+    extern void elog_async_output(uint8_t level, const char *log, size_t size);
+    elog_async_output(kv->level, (const char *)kv->frame, kv->len + CHK_SIZE);
+#elif defined(ELOG_BUF_OUTPUT_ENABLE)
+    extern void elog_buf_output(const char *log, size_t size);
+    elog_buf_output((const char *)kv->frame, kv->len + CHK_SIZE);
+#else
+    elog_port_output((const char *)kv->frame, kv->len + CHK_SIZE);
+#endif
+    /* unlock output */
+    elog_output_unlock();
+#endif /* ELOG_KV_OUTPUT_BIN */
+}
+
+#endif /* ELOG_KV_ENABLE */
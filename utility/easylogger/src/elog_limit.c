@@ -0,0 +1,117 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Per-callsite rate limit: token bucket, suppressed count report
+ *           and 1-in-N sampling, so a flapping condition can not flood the
+ *           output link.
+ * Created on: 2026-10-19
+ */
+
+#include <elog.h>
+
+#ifdef ELOG_LIMIT_ENABLE
+
+#if ELOG_LIMIT_RATE < 1 || ELOG_LIMIT_BURST < 1 || ELOG_LIMIT_SAMPLE_RATE < 1
+#error "ELOG_LIMIT_RATE, ELOG_LIMIT_BURST and ELOG_LIMIT_SAMPLE_RATE must be at least 1"
+#endif
+
+/* one token in the bucket */
+#define TOKEN                                    1000UL
+#define TOKENS_MAX                               (ELOG_LIMIT_BURST * TOKEN)
+
+/* logs dropped by rate limit and sampling */
+static uint32_t drop_count = 0;
+
+extern uint32_t elog_port_get_timestamp(void);
+
+/**
+ * check the rate limit of a callsite, the callsite state is not locked,
+ * concurrent callers of one callsite can only make the counts a bit off
+ *
+ * @param limit callsite state
+ * @param level level
+ * @param tag_id declared tag ID, used to report the suppressed count
+ *
+ * @return true: output the log, false: drop it
+ */
+bool elog_limit_pass(ElogLimit *limit, uint8_t level, ElogTagId tag_id) {
+    uint32_t now, elapsed, tokens;
+    uint16_t suppressed;
+
+    /* assert log is never limited */
+    if (level == ELOG_LVL_ASSERT) {
+        return true;
+    }
+
+    /* 1-in-N sampling, the first log of each N passes */
+    if (ELOG_LIMIT_SAMPLE_RATE > 1 && level >= ELOG_LIMIT_SAMPLE_LVL) {
+        if (limit->sample) {
+            if (++limit->sample >= ELOG_LIMIT_SAMPLE_RATE) {
+                limit->sample = 0;
+            }
+            __atomic_fetch_add(&drop_count, 1, __ATOMIC_RELAXED);
+            return false;
+        }
+        limit->sample = 1;
+    }
+
+    /* refill the token bucket, the tick is in ms */
+    now = elog_port_get_timestamp();
+    elapsed = now - limit->last_tick;
+    limit->last_tick = now;
+    if (elapsed > TOKENS_MAX) {
+        elapsed = TOKENS_MAX;
+    }
+    tokens = limit->tokens + elapsed * ELOG_LIMIT_RATE;
+    if (tokens > TOKENS_MAX) {
+        tokens = TOKENS_MAX;
+    }
+    if (tokens < TOKEN) {
+        limit->tokens = tokens;
+        if (limit->suppressed < UINT16_MAX) {
+            limit->suppressed++;
+        }
+        __atomic_fetch_add(&drop_count, 1, __ATOMIC_RELAXED);
+        return false;
+    }
+    limit->tokens = tokens - TOKEN;
+
+    /* report what was suppressed before this log goes out */
+    suppressed = limit->suppressed;
+    if (suppressed) {
+        limit->suppressed = 0;
+        elog_output_id(level, tag_id, NULL, NULL, 0, "last message repeated %u times", (unsigned int)suppressed);
+    }
+
+    return true;
+}
+
+/**
+ * get the count of logs dropped by rate limit and sampling
+ *
+ * @return dropped log count
+ */
+uint32_t elog_limit_get_drop_count(void) {
+    return __atomic_load_n(&drop_count, __ATOMIC_RELAXED);
+}
+
+#endif /* ELOG_LIMIT_ENABLE */
@@ -0,0 +1,299 @@
+#!/usr/bin/env python3
+"""
+EasyLogger binary output mode decoder.
+
+The target only records the format string address and the raw arguments
+(see elog_bin.c), this tool takes the strings from the ELF file of the same
+build and renders the text. Key-value frames (see elog_kv.c) carry a CBOR
+record [event, level, tag, tick, {field: value}], event and field names are
+taken from elog_kv_cfg.h, --json prints them as one JSON object per line.
+Bytes outside valid frames (text logs, shell output) are passed through
+unchanged.
+
+Usage:
+    elog_bin_decode.py firmware.elf capture.bin
+    stty -F /dev/ttyACM0 115200 raw && elog_bin_decode.py firmware.elf /dev/ttyACM0
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+SYNC = 0xEB
+KV_SYNC = 0xEC
+LVL_TRUNCATED = 0x80
+BODY_FIXED_SIZE = 13
+LEVEL_INFO = ["A/", "E/", "W/", "I/", "D/", "V/"]
+KV_CFG = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "inc", "elog_kv_cfg.h")
+
+# %[flags][width][.precision][length]conversion, same subset as elog_bin.c
+CONVERSION = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|j|z|t|L)?([diuoxXcfFeEgGaApsn%])")
+
+
+class Elf:
+    """Minimal ELF reader, only resolves strings in allocated sections."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF":
+            raise ValueError("%s is not an ELF file" % path)
+        is64 = self.data[4] == 2
+        endian = "<" if self.data[5] == 1 else ">"
+        if is64:
+            shoff, = struct.unpack_from(endian + "Q", self.data, 0x28)
+            shentsize, shnum = struct.unpack_from(endian + "HH", self.data, 0x3A)
+            fmt = endian + "IIQQQQ"
+        else:
+            shoff, = struct.unpack_from(endian + "I", self.data, 0x20)
+            shentsize, shnum = struct.unpack_from(endian + "HH", self.data, 0x2E)
+            fmt = endian + "IIIIII"
+        self.sections = []
+        for i in range(shnum):
+            _, sh_type, flags, addr, offset, size = struct.unpack_from(fmt, self.data, shoff + i * shentsize)
+            # SHF_ALLOC and not SHT_NOBITS
+            if flags & 0x2 and sh_type != 8 and size:
+                self.sections.append((addr, offset, size))
+        self.cache = {}
+
+    def string(self, address):
+        if address in self.cache:
+            return self.cache[address]
+        text = None
+        for addr, offset, size in self.sections:
+            # Addresses are recorded as 32 bit on target
+            if addr & 0xFFFFFFFF <= address < (addr & 0xFFFFFFFF) + size:
+                start = offset + address - (addr & 0xFFFFFFFF)
+                end = self.data.find(b"\0", start, offset + size)
+                text = self.data[start:end if end >= 0 else offset + size].decode("utf-8", "replace")
+                break
+        self.cache[address] = text
+        return text
+
+
+class KvNames:
+    """Names declared in elog_kv_cfg.h and elog_tag_cfg.h, IDs follow the order of declaration."""
+
+    def __init__(self, path):
+        self.events, self.fields, self.tags = [], [], []
+        for cfg in (path, os.path.join(os.path.dirname(path), "elog_tag_cfg.h")):
+            if not os.path.exists(cfg):
+                continue
+            with open(cfg) as f:
+                text = re.sub(r"/\*.*?\*/", "", f.read(), flags=re.S)
+            for kind, name in re.findall(r"ELOG_(KV_EVENT|KV_FIELD|TAG)_DEF\s*\(\s*\w+\s*,\s*\"([^\"]*)\"\s*\)", text):
+                {"KV_EVENT": self.events, "KV_FIELD": self.fields, "TAG": self.tags}[kind].append(name)
+
+    @staticmethod
+    def name(names, index, prefix):
+        return names[index] if index < len(names) else "%s%u" % (prefix, index)
+
+
+def cbor_item(data, pos):
+    """Decode the CBOR subset written by elog_kv.c, returns (value, next position)."""
+    major, info = data[pos] >> 5, data[pos] & 0x1F
+    pos += 1
+    if major == 7:
+        if info in (20, 21):
+            return info == 21, pos
+        if info == 26:
+            return struct.unpack_from(">f", data, pos)[0], pos + 4
+        raise ValueError("unsupported simple value %u" % info)
+    if info < 24:
+        arg = info
+    elif info <= 27:
+        size = 1 << (info - 24)
+        if pos + size > len(data):
+            raise ValueError("short item")
+        arg = int.from_bytes(data[pos:pos + size], "big")
+        pos += size
+    else:
+        raise ValueError("unsupported argument %u" % info)
+    if major == 0:
+        return arg, pos
+    if major == 1:
+        return -1 - arg, pos
+    if major == 3:
+        if pos + arg > len(data):
+            raise ValueError("short string")
+        return data[pos:pos + arg].decode("utf-8", "replace"), pos + arg
+    if major == 4:
+        items = []
+        for _ in range(arg):
+            item, pos = cbor_item(data, pos)
+            items.append(item)
+        return items, pos
+    if major == 5:
+        items = []
+        for _ in range(arg):
+            key, pos = cbor_item(data, pos)
+            value, pos = cbor_item(data, pos)
+            items.append((key, value))
+        return items, pos
+    raise ValueError("unsupported major type %u" % major)
+
+
+def render_kv(body, names, as_json):
+    """Render a key-value record, returns None if the body is not one."""
+    try:
+        record, end = cbor_item(body, 0)
+        event, level, tag, tick, fields = record
+    except (ValueError, TypeError, IndexError, struct.error):
+        return None
+    if end != len(body):
+        return None
+    event_str = names.name(names.events, event, "event")
+    if as_json:
+        obj = {"event": event_str, "level": level & 0x7, "tag": names.name(names.tags, tag, "tag"), "tick": tick}
+        for key, value in fields:
+            obj[names.name(names.fields, key, "field")] = value
+        if level & LVL_TRUNCATED:
+            obj["truncated"] = True
+        return json.dumps(obj) + "\n"
+    items = [event_str]
+    for key, value in fields:
+        if isinstance(value, bool):
+            value = "true" if value else "false"
+        elif isinstance(value, str):
+            value = json.dumps(value)
+        elif isinstance(value, float):
+            value = "%g" % value
+        items.append("%s=%s" % (names.name(names.fields, key, "field"), value))
+    text = " ".join(items) + (" ..." if level & LVL_TRUNCATED else "")
+    lvl = LEVEL_INFO[level & 0x7] if (level & 0x7) < len(LEVEL_INFO) else "?/"
+    return "%s%s [%u] %s\n" % (lvl, names.name(names.tags, tag, "tag"), tick, text)
+
+
+def render(fmt, args):
+    """Render the format with the packed arguments, returns (text, complete)."""
+    out = []
+    pos = 0
+    for m in CONVERSION.finditer(fmt):
+        out.append(fmt[pos:m.start()])
+        pos = m.end()
+        flags, width, precision, length, conv = m.groups()
+        if conv == "%":
+            out.append("%")
+            continue
+        if conv == "n":
+            continue
+        spec = "%" + flags
+        try:
+            for prefix, field in (("", width), (".", precision)):
+                if field == "*":
+                    value, = struct.unpack_from("<i", args)
+                    args = args[4:]
+                    spec += prefix + str(value)
+                elif field:
+                    spec += prefix + field
+            if conv == "s":
+                n = args[0]
+                value = args[1:1 + n].decode("utf-8", "replace")
+                if len(args) < 1 + n:
+                    raise struct.error
+                args = args[1 + n:]
+                out.append((spec + "s") % value)
+            elif conv in "fFeEgGaA":
+                value, = struct.unpack_from("<d", args)
+                args = args[8:]
+                out.append(float.hex(value) if conv in "aA" else (spec + conv) % value)
+            else:
+                size = 8 if length in ("ll", "j") else 4
+                value = int.from_bytes(args[:size], "little")
+                if len(args) < size:
+                    raise struct.error
+                args = args[size:]
+                if conv in "di":
+                    value -= (1 << (size * 8)) if value >> (size * 8 - 1) else 0
+                    out.append((spec + "d") % value)
+                elif conv == "u":
+                    out.append((spec + "d") % value)
+                elif conv == "p":
+                    out.append("0x%08x" % value)
+                elif conv == "c":
+                    out.append((spec + "c") % (value & 0xFF))
+                else:
+                    out.append((spec + conv) % value)
+        except (struct.error, IndexError, ValueError, TypeError):
+            out.append("<?>")
+            return "".join(out), False
+    out.append(fmt[pos:])
+    return "".join(out), True
+
+
+def decode(elf, stream, write, names=None, as_json=False):
+    buf = bytearray()
+    while True:
+        chunk = stream.read1(256) if hasattr(stream, "read1") else stream.read(256)
+        if not chunk:
+            break
+        buf += chunk
+        while buf:
+            start = next((i for i, b in enumerate(buf) if b in (SYNC, KV_SYNC)), -1)
+            if start < 0:
+                write(buf.decode("utf-8", "replace"))
+                buf.clear()
+                break
+            if start:
+                write(buf[:start].decode("utf-8", "replace"))
+                del buf[:start]
+            if len(buf) < 2 or len(buf) < 2 + buf[1] + 1:
+                break
+            body_len = buf[1]
+            body = bytes(buf[2:2 + body_len])
+            chk = 0
+            for b in body:
+                chk ^= b
+            if buf[0] == KV_SYNC:
+                text = render_kv(body, names, as_json) if chk == buf[2 + body_len] and names else None
+                if text is None:
+                    write(chr(buf[0]))
+                    del buf[:1]
+                else:
+                    del buf[:2 + body_len + 1]
+                    write(text)
+                continue
+            if body_len < BODY_FIXED_SIZE or chk != buf[2 + body_len]:
+                # Not a frame, pass the sync byte through as text
+                write(chr(buf[0]))
+                del buf[:1]
+                continue
+            del buf[:2 + body_len + 1]
+            level, tick, tag, fmt = struct.unpack_from("<BIII", body)
+            tag_str = elf.string(tag) or "0x%08x" % tag
+            fmt_str = elf.string(fmt)
+            if fmt_str is None:
+                text = "<unknown format 0x%08x>" % fmt
+            else:
+                text, complete = render(fmt_str, body[BODY_FIXED_SIZE:])
+                if level & LVL_TRUNCATED or not complete:
+                    text += " ..."
+            lvl = LEVEL_INFO[level & 0x7] if (level & 0x7) < len(LEVEL_INFO) else "?/"
+            write("%s%s [%u] %s\n" % (lvl, tag_str, tick, text))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode EasyLogger binary output")
+    parser.add_argument("elf", help="ELF file of the running firmware")
+    parser.add_argument("input", nargs="?", default="-", help="capture file or tty, default stdin")
+    parser.add_argument("--kv-cfg", default=KV_CFG, help="key-value declarations, default ../inc/elog_kv_cfg.h")
+    parser.add_argument("--json", action="store_true", help="print key-value records as JSON lines")
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+    names = KvNames(args.kv_cfg)
+    stream = sys.stdin.buffer if args.input == "-" else open(args.input, "rb", buffering=0)
+    try:
+        decode(elf, stream, lambda s: (sys.stdout.write(s), sys.stdout.flush()), names, args.json)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if stream is not sys.stdin.buffer:
+            stream.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,101 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Function: Host bench of the flash log plugin on the file backed simulator
+ *           of elog_flash_port.c (16 x 4 KB sectors, 8 byte granularity).
+ *           Writes log lines of 46 bytes on average and reports the write
+ *           amplification, programs, erases per sector and throughput.
+ *           The simulator counts NOR rule violations, any of them fails it.
+ *
+ * Build and run on host:
+ *   gcc -O2 -std=gnu11 -I../inc -I../plugins/flash ../plugins/flash/elog_flash.c \
+ *       ../plugins/flash/elog_flash_port.c ../plugins/flash/elog_flash_sim.c \
+ *       elog_flash_bench.c -o elog_flash_bench
+ *   rm -f elog_flash.bin && ./elog_flash_bench [lines]
+ *
+ * The unbuffered mode is measured by commenting ELOG_FLASH_USING_BUF_MODE out
+ * in elog_flash_cfg.h and building again.
+ *
+ * Created on: 2026-10-19
+ */
+
+#include <elog.h>
+#include <elog_flash.h>
+#include <elog_flash_sim.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LINE_NUM_DEFAULT                         5000
+
+static const char padding[] = "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx";
+static uint32_t timestamp = 0;
+
+/* elog.c is not linked, the plugin only needs these from it */
+void (*elog_assert_hook)(const char* expr, const char* func, size_t line) = NULL;
+
+uint32_t elog_port_get_timestamp(void) {
+    return timestamp;
+}
+
+void elog_output(uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const char *format, ...) {
+    (void)level;
+    (void)file;
+    (void)func;
+    (void)line;
+    printf("%s: %s\n", tag, format);
+}
+
+int main(int argc, char *argv[]) {
+    int line_num = argc > 1 ? atoi(argv[1]) : LINE_NUM_DEFAULT;
+    char line[ELOG_LINE_BUF_SIZE];
+    size_t total = 0;
+    ElogFlashStats stats;
+    ElogFlashSimStats sim_stats;
+    clock_t start;
+    double secs;
+
+    if (elog_flash_init() != ELOG_NO_ERR) {
+        printf("flash init failed\n");
+        return 1;
+    }
+
+    start = clock();
+    for (int i = 0; i < line_num; i++) {
+        int len;
+
+        timestamp = 1000 + i * 10;
+        len = snprintf(line, sizeof(line), "I/test [%lu] line %d %.*s\r\n", (unsigned long)timestamp, i,
+                i % (int)(sizeof(padding) - 1), padding);
+        elog_flash_write(line, len);
+        total += len;
+    }
+#ifdef ELOG_FLASH_USING_BUF_MODE
+    elog_flash_flush();
+#endif
+    secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    elog_flash_get_stats(&stats);
+    elog_flash_sim_get_stats(&sim_stats);
+#ifdef ELOG_FLASH_USING_BUF_MODE
+    printf("buffer mode, %d lines, %zu bytes\n", line_num, total);
+#else
+    printf("unbuffered mode, %d lines, %zu bytes\n", line_num, total);
+#endif
+    printf("  write amplification: %.2f (%zu programmed / %zu logged)\n",
+            (double)stats.write_bytes / (stats.log_bytes ? stats.log_bytes : 1), stats.write_bytes, stats.log_bytes);
+    printf("  programs:            %zu\n", sim_stats.write_count);
+    printf("  erases:              %zu, %zu to %zu per sector\n", sim_stats.erase_count, sim_stats.erase_min,
+            sim_stats.erase_max);
+    printf("  kept in flash:       %zu bytes, %zu bad records\n", stats.used_size, stats.bad_records);
+    printf("  throughput:          %.0f KB/s\n", secs > 0 ? total / 1024.0 / secs : 0);
+    elog_flash_sim_close();
+
+    if (sim_stats.violations) {
+        printf("FAIL %zu program(s) broke the NOR rules\n", sim_stats.violations);
+        return 1;
+    }
+    return 0;
+}
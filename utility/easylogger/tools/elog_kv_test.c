@@ -0,0 +1,132 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Function: Host test of key-value string fields cut to the room left in
+ *           the frame, around the point where the CBOR string head grows
+ *           from 1 to 2 bytes.
+ *
+ * Build and run on host:
+ *   gcc -O2 -std=gnu11 -I../inc ../src/elog_kv.c elog_kv_test.c -o elog_kv_test
+ *   ./elog_kv_test
+ *
+ * Created on: 2026-10-19
+ */
+
+#include <elog.h>
+#include <stdio.h>
+#include <string.h>
+
+/* frame length that leaves the given room for a string value behind a 1 byte key and the check byte */
+#define ROOM_TO_LEN(room)                        (ELOG_KV_FRAME_MAX_SIZE - 1 - 1 - (room))
+
+static const char long_value[] = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJ";
+static unsigned int failed = 0;
+
+/* elog.c is not linked, the record only needs its filter state */
+int8_t elog_tag_lvl[ELOG_TAG_ID_NUM] = { [0 ... ELOG_TAG_ID_NUM - 1] = ELOG_LVL_VERBOSE };
+void (*elog_assert_hook)(const char* expr, const char* func, size_t line) = NULL;
+
+bool elog_get_output_enabled(void) {
+    return true;
+}
+
+uint32_t elog_port_get_timestamp(void) {
+    return 0;
+}
+
+void elog_output(uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const char *format, ...) {
+    (void)level;
+    printf("%s:%ld %s: %s\n", file, line, func, tag);
+    (void)format;
+}
+
+bool elog_async_output_try(uint8_t level, const char *log, size_t size) {
+    (void)level;
+    (void)log;
+    (void)size;
+    return true;
+}
+
+void elog_async_output(uint8_t level, const char *log, size_t size) {
+    (void)level;
+    (void)log;
+    (void)size;
+}
+
+void elog_output_lock(void) {
+}
+
+void elog_output_unlock(void) {
+}
+
+void elog_port_output(const char *log, size_t size) {
+    (void)log;
+    (void)size;
+}
+
+static void expect(const char *name, int condition, const char *what) {
+    if (!condition) {
+        printf("FAIL %s: %s\n", name, what);
+        failed++;
+    }
+}
+
+/**
+ * fill the record with uint fields up to the given length, fields take 2, 3, 4 or 6 bytes
+ */
+static void kv_fill(ElogKv *kv, uint8_t len) {
+    static const uint32_t value_by_size[] = { 0, 0, 0, 0xFF, 0xFFFF, 0, 0xFFFFFFFF };
+    size_t left;
+
+    while ((left = len - kv->len) != 0) {
+        /* never leave a single byte, no field is that small */
+        size_t size = left >= 8 || left == 6 ? 6 : left == 7 ? 4 : left;
+        elog_kv_uint(kv, ELOG_KV_FIELD_ID_SIZE, value_by_size[size]);
+    }
+}
+
+/**
+ * cut a long string at the given room and check the field is kept with the expected length
+ */
+static void check_room(const char *name, uint8_t room, uint8_t expect_len, uint8_t expect_head_size) {
+    ElogKv kv;
+    uint8_t field_num, pos;
+    size_t len;
+
+    elog_kv_begin(&kv, ELOG_LVL_INFO, ELOG_TAG_ID_ELOG, ELOG_KV_EVENT_ID_PREV_RUN);
+    kv_fill(&kv, ROOM_TO_LEN(room));
+    expect(name, kv.len == ROOM_TO_LEN(room) && !kv.truncated, "fill missed the room");
+
+    field_num = kv.field_num;
+    pos = kv.len + 1;
+    elog_kv_str(&kv, ELOG_KV_FIELD_ID_REASON, long_value);
+
+    expect(name, kv.truncated, "cut string not marked truncated");
+    expect(name, kv.field_num == field_num + 1, "string field dropped");
+    if (kv.field_num != field_num + 1) {
+        return;
+    }
+    len = expect_head_size == 1 ? (kv.frame[pos] & 0x1F) : kv.frame[pos + 1];
+    expect(name, (kv.frame[pos] & 0xE0) == 0x60, "not a text string");
+    expect(name, len == expect_len, "wrong cut length");
+    expect(name, kv.len == pos + expect_head_size + expect_len, "wrong field size");
+    expect(name, kv.len + 1 <= ELOG_KV_FRAME_MAX_SIZE, "no room for the check byte");
+    expect(name, memcmp(&kv.frame[pos + expect_head_size], long_value, expect_len) == 0, "wrong content");
+}
+
+int main(void) {
+    /* 23 characters with a 1 byte head is the longest that fits the 1 byte form */
+    check_room("room 24", 24, 23, 1);
+    /* 24 characters would need a 2 byte head, 26 bytes, so 23 with a 1 byte head */
+    check_room("room 25", 25, 23, 1);
+    check_room("room 26", 26, 24, 2);
+    check_room("room 40", 40, 38, 2);
+
+    if (failed) {
+        printf("%u check(s) failed\n", failed);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
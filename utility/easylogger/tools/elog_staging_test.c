@@ -0,0 +1,217 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Function: Host test of the per-thread staging buffers and the lock-free
+ *           async ring. Threads log concurrently, callers without a current
+ *           thread (as the port reports in ISR) take the shared buffer, and
+ *           every line must come out whole, in order per thread, with
+ *           written + dropped == logged.
+ *
+ * Build and run on host, host/elog_cfg.h replaces the target configure:
+ *   gcc -O2 -std=gnu11 -pthread -Ihost -I../inc ../src/elog.c ../src/elog_async.c \
+ *       ../src/elog_utils.c elog_staging_test.c -o elog_staging_test
+ *   ./elog_staging_test
+ *
+ * Created on: 2026-10-19
+ */
+
+#define LOG_TAG "staging"
+
+#include <elog.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* threads with their own staging buffer, more than ELOG_STAGING_BUF_NUM so some share log_buf */
+#define THREAD_NUM                               8
+#define THREAD_LINE_NUM                          20000
+/* callers without a current thread, like ISR */
+#define ISR_NUM                                  2
+#define ISR_LINE_NUM                             5000
+#define WRITER_NUM                               (THREAD_NUM + ISR_NUM + 1)
+/* writer of the nested case, an ISR logs while its thread is formatting */
+#define NESTED_WRITER                            (THREAD_NUM + ISR_NUM)
+#define NESTED_ISR_WRITER                        (NESTED_WRITER + 1)
+#define OUTPUT_SIZE                              (16 * 1024 * 1024)
+
+static const char payload[] = "the quick brown fox jumps over the lazy dog";
+
+static pthread_mutex_t output_mutex = PTHREAD_MUTEX_INITIALIZER;
+static char *output = NULL;
+static size_t output_len = 0;
+static bool output_overflow = false;
+static unsigned long logged = 0;
+static unsigned int failed = 0;
+
+/* set by a caller playing an ISR, the port then reports no current thread */
+static __thread bool in_isr = false;
+/* set to log from an ISR in the middle of the next line's formatting */
+static __thread bool isr_pending = false;
+
+static void expect(const char *name, int condition, const char *what) {
+    if (!condition) {
+        printf("FAIL %s: %s\n", name, what);
+        failed++;
+    }
+}
+
+ElogErrCode elog_port_init(void) {
+    return ELOG_NO_ERR;
+}
+
+void elog_port_deinit(void) {
+}
+
+void elog_port_output(const char *log, size_t size) {
+    pthread_mutex_lock(&output_mutex);
+    if (output_len + size <= OUTPUT_SIZE) {
+        memcpy(output + output_len, log, size);
+        output_len += size;
+    } else {
+        output_overflow = true;
+    }
+    pthread_mutex_unlock(&output_mutex);
+}
+
+void elog_port_output_lock(void) {
+    pthread_mutex_lock(&output_mutex);
+}
+
+void elog_port_output_unlock(void) {
+    pthread_mutex_unlock(&output_mutex);
+}
+
+const char *elog_port_get_time(void) {
+    /* called while the line is being formatted, the ISR hits here */
+    if (isr_pending) {
+        isr_pending = false;
+        in_isr = true;
+        /* another level, a line formatted over the thread's one shows in its head */
+        log_w("w%d seq %d %s", NESTED_ISR_WRITER, 0, payload);
+        __atomic_fetch_add(&logged, 1, __ATOMIC_RELAXED);
+        in_isr = false;
+    }
+    return "1";
+}
+
+const char *elog_port_get_p_info(void) {
+    return "";
+}
+
+const char *elog_port_get_t_info(void) {
+    return "";
+}
+
+void *elog_port_get_thread(void) {
+    return in_isr ? NULL : (void *)pthread_self();
+}
+
+static void *writer(void *arg) {
+    long id = (long)arg;
+    int num = (id < THREAD_NUM) ? THREAD_LINE_NUM : ISR_LINE_NUM;
+
+    in_isr = (id >= THREAD_NUM);
+    for (int i = 0; i < num; i++) {
+        log_i("w%ld seq %d %s", id, i, payload);
+        __atomic_fetch_add(&logged, 1, __ATOMIC_RELAXED);
+        /* let the output thread drain now and then so not everything is dropped */
+        if (i % 64 == 0) {
+            usleep(50);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * an ISR logging while its thread formats into the staging buffer must not touch that buffer
+ */
+static void nested_log(void) {
+    isr_pending = true;
+    log_i("w%d seq %d %s", NESTED_WRITER, 0, payload);
+    __atomic_fetch_add(&logged, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * check every line is whole and the lines of each writer are in order
+ */
+static void output_check(void) {
+    int last_seq[WRITER_NUM + 1];
+    unsigned long lines = 0;
+    char *line = output;
+    char *end = output + output_len;
+    char expected[ELOG_LINE_BUF_SIZE];
+
+    for (int i = 0; i < WRITER_NUM + 1; i++) {
+        last_seq[i] = -1;
+    }
+    while (line < end) {
+        char *newline = memchr(line, '\n', end - line);
+        char level = 0;
+        int id = -1, seq = -1;
+
+        if (newline == NULL) {
+            expect("output", false, "last line not terminated");
+            break;
+        }
+        lines++;
+        if (sscanf(line, "%c/" LOG_TAG " [1] w%d seq %d ", &level, &id, &seq) != 3 || id < 0 || id > WRITER_NUM
+                || seq <= last_seq[id]) {
+            printf("bad line: %.*s\n", (int)(newline - line), line);
+            expect("output", false, "torn or reordered line");
+        } else {
+            int len = snprintf(expected, sizeof(expected), "%c/%-*s [1] w%d seq %d %s\r\n",
+                    (id == NESTED_ISR_WRITER) ? 'W' : 'I', ELOG_FILTER_TAG_MAX_LEN / 2, LOG_TAG, id, seq, payload);
+            if ((size_t)len != (size_t)(newline + 1 - line) || memcmp(expected, line, len) != 0) {
+                printf("bad line: %.*s\n", (int)(newline - line), line);
+                expect("output", false, "line content corrupted");
+            }
+            last_seq[id] = seq;
+        }
+        line = newline + 1;
+    }
+
+    expect("output", !output_overflow, "output capture overflow");
+    expect("output", last_seq[NESTED_WRITER] == 0, "line of the interrupted thread lost");
+    expect("output", last_seq[NESTED_ISR_WRITER] == 0, "line of the ISR lost");
+    expect("output", lines + elog_async_get_drop_count() == logged, "written + dropped != logged");
+    printf("logged %lu, written %lu, dropped %u\n", logged, lines, elog_async_get_drop_count());
+}
+
+int main(void) {
+    pthread_t thread[THREAD_NUM + ISR_NUM];
+
+    output = malloc(OUTPUT_SIZE);
+    if (output == NULL) {
+        return 1;
+    }
+    elog_init();
+    elog_set_fmt(ELOG_LVL_INFO, ELOG_FMT_LVL | ELOG_FMT_TAG | ELOG_FMT_TIME);
+    elog_set_fmt(ELOG_LVL_WARN, ELOG_FMT_LVL | ELOG_FMT_TAG | ELOG_FMT_TIME);
+    elog_start();
+    /* the start message is not part of the check */
+    usleep(10000);
+    pthread_mutex_lock(&output_mutex);
+    output_len = 0;
+    pthread_mutex_unlock(&output_mutex);
+
+    nested_log();
+    for (long i = 0; i < THREAD_NUM + ISR_NUM; i++) {
+        pthread_create(&thread[i], NULL, writer, (void *)i);
+    }
+    for (int i = 0; i < THREAD_NUM + ISR_NUM; i++) {
+        pthread_join(thread[i], NULL);
+    }
+    /* the output thread drains the ring before it exits */
+    elog_deinit();
+
+    output_check();
+    free(output);
+    if (failed) {
+        printf("%u check(s) failed\n", failed);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
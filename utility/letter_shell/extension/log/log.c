@@ -12,6 +12,9 @@
 #include "stdio.h"
 #include "stdarg.h"
 #include "shell.h"
+#if LOG_USING_CRASHLOG == 1
+#include "crashlog.h"
+#endif /** LOG_USING_CRASHLOG == 1 */
 
 #if LOG_USING_COLOR == 1
 #define memPrintHead CSI(31) \
@@ -26,6 +29,9 @@
 
 Log *logList[LOG_MAX_NUMBER] = {0};
 static char logBuffer[LOG_BUFFER_SIZE];
+#if LOG_USING_LIMIT == 1
+static unsigned int logDropped = 0;
+#endif /** LOG_USING_LIMIT == 1 */
 
 #if LOG_USING_LOCK == 1
 /**
@@ -154,6 +160,8 @@ logSetLevel, logSetLevel, set log level\r\n logSetLevel [log] [level]);
  */
 static void logWriteBuffer(Log *log, LogLevel level, char *buffer, short len)
 {
+    unsigned char written = 0;
+
 #if LOG_USING_LOCK == 1
     logLock(log);
 #endif /* LOG_USING_LOCK == 1 */
@@ -166,13 +174,24 @@ static void logWriteBuffer(Log *log, LogLevel level, char *buffer, short len)
                 && logList[i]->level >= level)
             {
                 logList[i]->write(logBuffer, len);
+                written = 1;
             }
         }
     }
     else if (log && log->active && log->level >= level)
     {
         log->write(logBuffer, len);
+        written = 1;
+    }
+#if LOG_USING_CRASHLOG == 1
+    /* 输出到多个log对象时只记录一次 */
+    if (written)
+    {
+        crashlog_write(logBuffer, len);
     }
+#else
+    (void)written;
+#endif /** LOG_USING_CRASHLOG == 1 */
 #if LOG_USING_LOCK == 1
     logUnlock(log);
 #endif /* LOG_USING_LOCK == 1 */
@@ -209,6 +228,95 @@ void logWrite(Log *log, LogLevel level, const char *fmt, ...)
 #endif /* LOG_USING_LOCK == 1 */
 }
 
+#if LOG_USING_LIMIT == 1
+/**
+ * @brief log调用点限流检查
+ *        令牌桶限制每个调用点的输出速率, 低级别log按1/N采样输出
+ *        调用点状态不加锁, 多个任务同时使用同一调用点时计数可能略有偏差
+ * 
+ * @param limit 调用点状态
+ * @param level log级别
+ * 
+ * @return int -1 丢弃本条log 0 输出 >0 输出, 且需先输出被抑制的数量
+ */
+int logLimitCheck(LogLimit *limit, LogLevel level)
+{
+    unsigned int tick, elapsed, tokens;
+    int suppressed;
+    char enabled = 0;
+
+    /* 没有log对象接收该级别时不计入限流 */
+    for (short i = 0; i < LOG_MAX_NUMBER; i++)
+    {
+        if (logList[i] && logList[i]->active && logList[i]->level >= level)
+        {
+            enabled = 1;
+            break;
+        }
+    }
+    if (!enabled)
+    {
+        return -1;
+    }
+
+    if (LOG_SAMPLE_RATE > 1 && level >= LOG_SAMPLE_LEVEL)
+    {
+        if (limit->sample)
+        {
+            if (++limit->sample >= LOG_SAMPLE_RATE)
+            {
+                limit->sample = 0;
+            }
+            logDropped++;
+            return -1;
+        }
+        limit->sample = 1;
+    }
+
+    tick = LOG_GET_TICK();
+    elapsed = tick - limit->lastTick;
+    limit->lastTick = tick;
+    if (elapsed > LOG_LIMIT_BURST * 1000)
+    {
+        elapsed = LOG_LIMIT_BURST * 1000;
+    }
+    tokens = limit->tokens + elapsed * LOG_LIMIT_RATE;
+    if (tokens > LOG_LIMIT_BURST * 1000)
+    {
+        tokens = LOG_LIMIT_BURST * 1000;
+    }
+    if (tokens < 1000)
+    {
+        limit->tokens = tokens;
+        if (limit->suppressed < 0xFFFF)
+        {
+            limit->suppressed++;
+        }
+        logDropped++;
+        return -1;
+    }
+    limit->tokens = tokens - 1000;
+
+    suppressed = limit->suppressed;
+    limit->suppressed = 0;
+    return suppressed;
+}
+
+
+/**
+ * @brief 获取被限流丢弃的log数量
+ * 
+ * @return unsigned int 丢弃数量
+ */
+unsigned int logGetDropped(void)
+{
+    return logDropped;
+}
+SHELL_EXPORT_CMD(
+SHELL_CMD_PERMISSION(0)|SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC),
+logDropped, logGetDropped, get count of logs dropped by rate limit);
+#endif /** LOG_USING_LIMIT == 1 */
+
 /**
  * @brief 16进制输出
  * 
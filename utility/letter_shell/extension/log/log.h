@@ -28,6 +28,13 @@ extern "C" {
 #define     LOG_AUTO_TAG       1                /**< 是否自动添加TAG */
 #define     LOG_END            "\r\n"           /**< log信息结尾 */
 #define     LOG_TIME_STAMP     0                /**< 设置获取系统时间戳 */
+#define     LOG_USING_LIMIT    1                /**< 是否对每个调用点限流(令牌桶, 采样) */
+#define     LOG_LIMIT_RATE     10               /**< 每个调用点每秒允许输出的log数量 */
+#define     LOG_LIMIT_BURST    20               /**< 每个调用点允许突发输出的log数量 */
+#define     LOG_SAMPLE_LEVEL   LOG_VERBOSE      /**< 该级别及更低级别的log采样输出 */
+#define     LOG_SAMPLE_RATE    10               /**< 采样率, 每N条输出1条, 1为不采样 */
+#define     LOG_GET_TICK()     SHELL_GET_TICK() /**< 获取系统时间(ms), 用于令牌桶 */
+#define     LOG_USING_CRASHLOG 1                /**< 是否同时写入复位后保留的crashlog */
 
 #ifndef LOG_TAG
     #define LOG_TAG            __FUNCTION__     /**< 自定添加的TAG */
@@ -104,6 +111,27 @@ typedef enum
 } LogLevel;
 
 
+/**
+ * @brief log调用点限流状态, 每个调用点一个
+ * 
+ */
+typedef struct
+{
+    unsigned int lastTick;                          /**< 上次补充令牌的时间 */
+    unsigned int tokens;                            /**< 令牌数(1/1000个) */
+    unsigned short suppressed;                      /**< 上次输出后被抑制的log数量 */
+    unsigned short sample;                          /**< 采样计数 */
+} LogLimit;
+
+#if LOG_USING_LIMIT == 1
+#define     LOG_LIMIT_DEFINE(name)      static LogLimit name = {0, LOG_LIMIT_BURST * 1000, 0, 0}
+#define     LOG_LIMIT_CHECK(limit, level)   logLimitCheck(limit, level)
+#else
+#define     LOG_LIMIT_DEFINE(name)
+#define     LOG_LIMIT_CHECK(limit, level)   0
+#endif /** LOG_USING_LIMIT == 1 */
+
+
 /**
  * @brief log对象定义
  * 
@@ -142,8 +170,14 @@ typedef struct log_def
  */
 #define logFormat(text, level, fmt, ...) \
         if (LOG_ENABLE) {\
-            logWrite(LOG_ALL_OBJ, level, text " " fmt "" LOG_END, \
-                LOG_TIME_STAMP, LOG_TAG, ##__VA_ARGS__); }
+            LOG_LIMIT_DEFINE(logLimit); \
+            int logSuppressed = LOG_LIMIT_CHECK(&logLimit, level); \
+            if (logSuppressed > 0) { \
+                logWrite(LOG_ALL_OBJ, level, text " last message repeated %d times" LOG_END, \
+                    LOG_TIME_STAMP, LOG_TAG, logSuppressed); } \
+            if (logSuppressed >= 0) { \
+                logWrite(LOG_ALL_OBJ, level, text " " fmt "" LOG_END, \
+                    LOG_TIME_STAMP, LOG_TAG, ##__VA_ARGS__); } }
 
 /**
  * @brief 错误log输出
@@ -216,6 +250,8 @@ void logUnRegister(Log *log);
 void logSetLevel(Log *log, LogLevel level);
 void logWrite(Log *log, LogLevel level, const char *fmt, ...);
 void logHexDump(Log *log, LogLevel level, void *base, unsigned int length);
+int logLimitCheck(LogLimit *limit, LogLevel level);
+unsigned int logGetDropped(void);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,466 @@
+/**
+ * @file shell_rpc.c
+ * @brief shell binary rpc mode
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ */
+#include "shell_rpc.h"
+#include "shell_ext.h"
+#include "string.h"
+#include "stdio.h"
+
+extern ShellCommand* shellSeekCommand(Shell *shell,
+                                      const char *cmd,
+                                      ShellCommand *base,
+                                      unsigned short compareLength);
+extern int shellGetVarValue(Shell *shell, ShellCommand *command);
+extern int shellSetVarValue(Shell *shell, ShellCommand *command, int value);
+
+#define     SHELL_RPC_HEAD_SIZE         3       /**< SOF + LEN */
+#define     SHELL_RPC_RESULT_SIZE       6       /**< SEQ + STATUS + RET */
+#define     SHELL_RPC_CRC_SIZE          2       /**< CRC16 */
+#define     SHELL_RPC_NUMBER_SIZE       16      /**< 数字参数转换为字符串的最大长度 */
+
+/**
+ * @brief rpc 帧接收状态
+ */
+typedef enum
+{
+    SHELL_RPC_RX_SOF = 0,                       /**< 等待帧起始 */
+    SHELL_RPC_RX_LEN_L,                         /**< 接收长度低字节 */
+    SHELL_RPC_RX_LEN_H,                         /**< 接收长度高字节 */
+    SHELL_RPC_RX_PAYLOAD,                       /**< 接收负载 */
+    SHELL_RPC_RX_CRC_L,                         /**< 接收校验低字节 */
+    SHELL_RPC_RX_CRC_H,                         /**< 接收校验高字节 */
+} ShellRpcRxState;
+
+/**
+ * @brief rpc 上下文, 同一时间只有一个 shell 处于 rpc 模式
+ */
+static struct
+{
+    ShellRpcRxState state;                                      /**< 帧接收状态 */
+    unsigned short length;                                      /**< 负载长度 */
+    unsigned short index;                                       /**< 已接收负载长度 */
+    unsigned short crc;                                         /**< 接收到的校验值 */
+    unsigned char payload[SHELL_RPC_FRAME_SIZE];                /**< 请求负载 */
+    char pool[SHELL_RPC_FRAME_SIZE
+              + SHELL_PARAMETER_MAX_NUMBER * SHELL_RPC_NUMBER_SIZE]; /**< 命令名和参数字符串 */
+    unsigned short poolLength;                                  /**< 已使用的字符串空间 */
+    unsigned char response[SHELL_RPC_HEAD_SIZE + SHELL_RPC_RESULT_SIZE
+                           + SHELL_RPC_TEXT_SIZE + SHELL_RPC_CRC_SIZE]; /**< 响应帧 */
+    unsigned short textLength;                                  /**< 响应文本长度 */
+    signed short (*write)(char *, unsigned short);              /**< shell原写函数 */
+    unsigned char isBusy;                                       /**< rpc 模式运行中 */
+} shellRpcContext;
+
+
+/**
+ * @brief 计算 CRC-16/CCITT-FALSE
+ *
+ * @param crc 初始值
+ * @param data 数据
+ * @param len 数据长度
+ *
+ * @return unsigned short 校验值
+ */
+static unsigned short shellRpcCrc16(unsigned short crc, const unsigned char *data, unsigned short len)
+{
+    for (unsigned short i = 0; i < len; i++)
+    {
+        crc ^= (unsigned short)data[i] << 8;
+        for (unsigned char bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x8000) ? (unsigned short)((crc << 1) ^ 0x1021) : (unsigned short)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+
+/**
+ * @brief rpc 模式下的 shell 写函数, 将命令文本输出保存到响应中
+ *
+ * @param data 数据
+ * @param len 数据长度
+ *
+ * @return signed short 写入长度
+ */
+static signed short shellRpcWrite(char *data, unsigned short len)
+{
+    unsigned short size = SHELL_RPC_TEXT_SIZE - shellRpcContext.textLength;
+    if (size > len)
+    {
+        size = len;
+    }
+    memcpy(shellRpcContext.response + SHELL_RPC_HEAD_SIZE + SHELL_RPC_RESULT_SIZE
+           + shellRpcContext.textLength, data, size);
+    shellRpcContext.textLength += size;
+    return len;
+}
+
+
+/**
+ * @brief 在字符串空间中保存字符串
+ *
+ * @param data 字符串数据(不含结束符)
+ * @param len 字符串长度
+ *
+ * @return char* 保存后的字符串, 空间不足时返回 NULL
+ */
+static char *shellRpcPoolAdd(const void *data, unsigned short len)
+{
+    char *string;
+    if ((size_t)shellRpcContext.poolLength + len + 1 > sizeof(shellRpcContext.pool))
+    {
+        return NULL;
+    }
+    string = shellRpcContext.pool + shellRpcContext.poolLength;
+    memcpy(string, data, len);
+    string[len] = 0;
+    shellRpcContext.poolLength += len + 1;
+    return string;
+}
+
+
+/**
+ * @brief 接收一个字节
+ *
+ * @param data 字节数据
+ *
+ * @return int 1 接收到完整帧 0 帧未结束
+ */
+static int shellRpcReceive(unsigned char data)
+{
+    switch (shellRpcContext.state)
+    {
+    case SHELL_RPC_RX_SOF:
+        if (data == SHELL_RPC_SOF)
+        {
+            shellRpcContext.state = SHELL_RPC_RX_LEN_L;
+        }
+        break;
+    case SHELL_RPC_RX_LEN_L:
+        shellRpcContext.length = data;
+        shellRpcContext.state = SHELL_RPC_RX_LEN_H;
+        break;
+    case SHELL_RPC_RX_LEN_H:
+        shellRpcContext.length |= (unsigned short)data << 8;
+        shellRpcContext.index = 0;
+        if (shellRpcContext.length == 0 || shellRpcContext.length > SHELL_RPC_FRAME_SIZE)
+        {
+            shellRpcContext.state = SHELL_RPC_RX_SOF;
+        }
+        else
+        {
+            shellRpcContext.state = SHELL_RPC_RX_PAYLOAD;
+        }
+        break;
+    case SHELL_RPC_RX_PAYLOAD:
+        shellRpcContext.payload[shellRpcContext.index++] = data;
+        if (shellRpcContext.index >= shellRpcContext.length)
+        {
+            shellRpcContext.state = SHELL_RPC_RX_CRC_L;
+        }
+        break;
+    case SHELL_RPC_RX_CRC_L:
+        shellRpcContext.crc = data;
+        shellRpcContext.state = SHELL_RPC_RX_CRC_H;
+        break;
+    case SHELL_RPC_RX_CRC_H:
+        shellRpcContext.crc |= (unsigned short)data << 8;
+        shellRpcContext.state = SHELL_RPC_RX_SOF;
+        return 1;
+    default:
+        shellRpcContext.state = SHELL_RPC_RX_SOF;
+        break;
+    }
+    return 0;
+}
+
+
+/**
+ * @brief 发送响应帧
+ *
+ * @param seq 请求序号
+ * @param status 响应状态
+ * @param ret 返回值
+ */
+static void shellRpcRespond(unsigned char seq, ShellRpcStatus status, int ret)
+{
+    unsigned char *frame = shellRpcContext.response;
+    unsigned short length = SHELL_RPC_RESULT_SIZE + shellRpcContext.textLength;
+    unsigned short crc;
+
+    frame[0] = SHELL_RPC_SOF;
+    frame[1] = length & 0xFF;
+    frame[2] = (length >> 8) & 0xFF;
+    frame[3] = seq;
+    frame[4] = status;
+    frame[5] = ret & 0xFF;
+    frame[6] = (ret >> 8) & 0xFF;
+    frame[7] = (ret >> 16) & 0xFF;
+    frame[8] = (ret >> 24) & 0xFF;
+    crc = shellRpcCrc16(0xFFFF, frame + 1, length + 2);
+    frame[SHELL_RPC_HEAD_SIZE + length] = crc & 0xFF;
+    frame[SHELL_RPC_HEAD_SIZE + length + 1] = (crc >> 8) & 0xFF;
+
+    shellRpcContext.write((char *)frame, SHELL_RPC_HEAD_SIZE + length + SHELL_RPC_CRC_SIZE);
+    shellRpcContext.textLength = 0;
+}
+
+
+/**
+ * @brief 解析请求参数并执行命令
+ *
+ * @param shell shell对象
+ * @param ret 返回值
+ *
+ * @return ShellRpcStatus 执行状态
+ */
+static ShellRpcStatus shellRpcExec(Shell *shell, int *ret)
+{
+    unsigned char *p = shellRpcContext.payload + 1;
+    unsigned char *end = shellRpcContext.payload + shellRpcContext.length;
+    size_t params[SHELL_PARAMETER_MAX_NUMBER] = {0};
+    char *argv[SHELL_PARAMETER_MAX_NUMBER] = {0};
+    char number[SHELL_RPC_NUMBER_SIZE];
+    unsigned char argc;
+    unsigned char type;
+    unsigned char len;
+    int value = 0;
+
+    shellRpcContext.poolLength = 0;
+
+    /* 命令名 */
+    len = *p++;
+    if (p + len + 1 > end)
+    {
+        return SHELL_RPC_STATUS_FRAME_ERROR;
+    }
+    argv[0] = shellRpcPoolAdd(p, len);
+    p += len;
+
+    argc = *p++;
+    if (argc > SHELL_PARAMETER_MAX_NUMBER - 1)
+    {
+        return SHELL_RPC_STATUS_PARAM_ERROR;
+    }
+
+    ShellCommand *command = shellSeekCommand(shell, argv[0], shell->commandList.base, 0);
+    if (command == NULL)
+    {
+        return SHELL_RPC_STATUS_NOT_FOUND;
+    }
+
+    /* 参数直接按类型解码, main 形式命令同时生成字符串参数 */
+    for (unsigned char i = 0; i < argc; i++)
+    {
+        if (p + 2 > end)
+        {
+            return SHELL_RPC_STATUS_FRAME_ERROR;
+        }
+        type = *p++;
+        len = *p++;
+        if (p + len > end)
+        {
+            return SHELL_RPC_STATUS_FRAME_ERROR;
+        }
+        switch (type)
+        {
+        case SHELL_RPC_TYPE_INT:
+            if (len == 1)
+            {
+                value = (signed char)p[0];
+            }
+            else if (len == 2)
+            {
+                value = (signed short)(p[0] | (p[1] << 8));
+            }
+            else if (len == 4)
+            {
+                value = (int)((unsigned int)p[0] | ((unsigned int)p[1] << 8)
+                              | ((unsigned int)p[2] << 16) | ((unsigned int)p[3] << 24));
+            }
+            else
+            {
+                return SHELL_RPC_STATUS_PARAM_ERROR;
+            }
+            params[i] = (size_t)value;
+            argv[i + 1] = shellRpcPoolAdd(number, snprintf(number, sizeof(number), "%d", value));
+            break;
+        case SHELL_RPC_TYPE_FLOAT:
+        {
+            float valueFloat;
+            if (len != sizeof(float))
+            {
+                return SHELL_RPC_STATUS_PARAM_ERROR;
+            }
+            memcpy(&valueFloat, p, sizeof(float));
+            memcpy(&params[i], &valueFloat, sizeof(float));
+            /* %f 输出大数时超过数字缓冲长度, 使用 %g 并拒绝被截断的结果 */
+            int size = snprintf(number, sizeof(number), "%g", (double)valueFloat);
+            if (size < 0 || size >= (int)sizeof(number))
+            {
+                return SHELL_RPC_STATUS_PARAM_ERROR;
+            }
+            argv[i + 1] = shellRpcPoolAdd(number, size);
+            break;
+        }
+        case SHELL_RPC_TYPE_STRING:
+            argv[i + 1] = shellRpcPoolAdd(p, len);
+            params[i] = (size_t)argv[i + 1];
+            break;
+        case SHELL_RPC_TYPE_BYTES:
+            argv[i + 1] = shellRpcPoolAdd(p, len);
+            params[i] = (size_t)p;
+            break;
+        default:
+            return SHELL_RPC_STATUS_PARAM_ERROR;
+        }
+        if (argv[i + 1] == NULL)
+        {
+            return SHELL_RPC_STATUS_PARAM_ERROR;
+        }
+        p += len;
+    }
+
+    switch (command->attr.attrs.type)
+    {
+    case SHELL_TYPE_CMD_MAIN:
+    {
+        int (*func)(int, char **) = command->data.cmd.function;
+        *ret = func(argc + 1, argv);
+        break;
+    }
+    case SHELL_TYPE_CMD_FUNC:
+        *ret = shellExtCall(command, argc, params);
+        break;
+    case SHELL_TYPE_VAR_INT:
+    case SHELL_TYPE_VAR_SHORT:
+    case SHELL_TYPE_VAR_CHAR:
+    case SHELL_TYPE_VAR_STRING:
+    case SHELL_TYPE_VAR_POINT:
+    case SHELL_TYPE_VAR_NODE:
+        if (argc == 0)
+        {
+            *ret = shellGetVarValue(shell, command);
+        }
+        else if (argc == 1)
+        {
+            *ret = shellSetVarValue(shell, command, (int)params[0]);
+        }
+        else
+        {
+            return SHELL_RPC_STATUS_PARAM_ERROR;
+        }
+        break;
+    default:
+        return SHELL_RPC_STATUS_PARAM_ERROR;
+    }
+    return SHELL_RPC_STATUS_OK;
+}
+
+
+/**
+ * @brief shell rpc 模式
+ *        阻塞读取 rpc 请求帧并执行, 直到收到退出请求
+ *        与 rpc 命令同一批输入的数据按请求帧处理, 退出请求之后的数据交还 shell
+ *        调用者持有 shell 锁, 阻塞等待主机数据时释放, 日志等输出只在处理请求帧时等待
+ *
+ * @param shell shell对象
+ *
+ * @return int 0 正常退出 -1 无法进入 rpc 模式
+ */
+int shellRpc(Shell *shell)
+{
+    char data[32];
+    signed short len;
+    unsigned char fromBatch;
+
+    SHELL_ASSERT(shell && shell->write, return -1);
+    if (shellRpcContext.isBusy)
+    {
+        return -1;
+    }
+    shellRpcContext.isBusy = 1;
+    shellRpcContext.state = SHELL_RPC_RX_SOF;
+    shellRpcContext.textLength = 0;
+    shellRpcContext.write = shell->write;
+    shellFlush(shell);
+
+    while (1)
+    {
+        fromBatch = shell->parser.restLength > 0;
+        if (fromBatch)
+        {
+            len = shellRead(shell, data, sizeof(data));
+        }
+        else
+        {
+            shellFlush(shell);
+            SHELL_UNLOCK(shell);
+            len = shell->read ? shell->read(data, sizeof(data)) : 0;
+            SHELL_LOCK(shell);
+        }
+        for (signed short i = 0; i < len; i++)
+        {
+            if (!shellRpcReceive((unsigned char)data[i]))
+            {
+                continue;
+            }
+
+            unsigned char seq = shellRpcContext.payload[0];
+            unsigned char length[2] = {shellRpcContext.length & 0xFF, (shellRpcContext.length >> 8) & 0xFF};
+            unsigned short crc = shellRpcCrc16(0xFFFF, length, 2);
+            crc = shellRpcCrc16(crc, shellRpcContext.payload, shellRpcContext.length);
+            if (crc != shellRpcContext.crc || shellRpcContext.length < 2)
+            {
+                shellRpcRespond(seq, SHELL_RPC_STATUS_FRAME_ERROR, 0);
+                continue;
+            }
+
+            /* 命令名为空, 退出 rpc 模式 */
+            if (shellRpcContext.payload[1] == 0)
+            {
+                shellRpcRespond(seq, SHELL_RPC_STATUS_OK, 0);
+                shellRpcContext.isBusy = 0;
+                /* 同一批输入中退出请求之后的数据交还 shell 处理 */
+                if (fromBatch)
+                {
+                    shell->parser.rest -= len - i - 1;
+                    shell->parser.restLength += len - i - 1;
+                }
+                return 0;
+            }
+
+            /* 命令执行期间的文本输出保存到响应中 */
+            int ret = 0;
+            shell->write = shellRpcWrite;
+            ShellRpcStatus status = shellRpcExec(shell, &ret);
+            shellFlush(shell);
+            shell->write = shellRpcContext.write;
+            shellRpcRespond(seq, status, ret);
+        }
+    }
+}
+
+
+/**
+ * @brief shell rpc 命令(shell调用)
+ *
+ * @param argc 参数个数
+ * @param argv 参数
+ *
+ * @return int 返回值
+ */
+int shellRpcCmd(int argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+    return shellRpc(shellGetCurrent());
+}
+SHELL_EXPORT_CMD(
+SHELL_CMD_PERMISSION(0)|SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN)|SHELL_CMD_DISABLE_RETURN|SHELL_CMD_READ_INPUT,
+rpc, shellRpcCmd, enter binary rpc mode);
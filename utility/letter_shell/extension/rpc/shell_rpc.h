@@ -0,0 +1,65 @@
+/**
+ * @file shell_rpc.h
+ * @brief shell binary rpc mode
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ */
+#ifndef __SHELL_RPC_H__
+#define __SHELL_RPC_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif /**< defined __cplusplus */
+
+#include "shell.h"
+
+#define     SHELL_RPC_VERSION               "1.0.0"
+
+#define     SHELL_RPC_FRAME_SIZE            256     /**< 请求帧负载最大长度 */
+#define     SHELL_RPC_TEXT_SIZE             128     /**< 响应中附带的命令文本输出最大长度 */
+#define     SHELL_RPC_SOF                   0xA5    /**< 帧起始字节 */
+
+/**
+ * @brief rpc 帧格式(多字节数据均为小端)
+ *
+ *        帧:     SOF(1) | LEN(2) | PAYLOAD(LEN) | CRC16(2)
+ *                CRC16 为 CRC-16/CCITT-FALSE, 校验范围为 LEN 和 PAYLOAD
+ *
+ *        请求:   SEQ(1) | NAME_LEN(1) | NAME | ARGC(1) | { TYPE(1) | LEN(1) | DATA } * ARGC
+ *                NAME_LEN 为 0 时退出 rpc 模式
+ *
+ *        响应:   SEQ(1) | STATUS(1) | RET(4) | TEXT
+ *                TEXT 为命令执行期间的文本输出, 超出`SHELL_RPC_TEXT_SIZE`部分丢弃
+ */
+
+/**
+ * @brief rpc 参数类型
+ */
+typedef enum
+{
+    SHELL_RPC_TYPE_INT = 'i',                       /**< 有符号整型, 1/2/4 字节 */
+    SHELL_RPC_TYPE_FLOAT = 'f',                     /**< 单精度浮点, 4 字节 */
+    SHELL_RPC_TYPE_STRING = 's',                    /**< 字符串, 不含结束符 */
+    SHELL_RPC_TYPE_BYTES = 'b',                     /**< 字节数组, 以指针传递 */
+} ShellRpcType;
+
+/**
+ * @brief rpc 响应状态
+ */
+typedef enum
+{
+    SHELL_RPC_STATUS_OK = 0,                        /**< 执行成功 */
+    SHELL_RPC_STATUS_NOT_FOUND,                     /**< 命令未找到或无权限 */
+    SHELL_RPC_STATUS_PARAM_ERROR,                   /**< 参数错误 */
+    SHELL_RPC_STATUS_FRAME_ERROR,                   /**< 帧格式错误 */
+} ShellRpcStatus;
+
+int shellRpc(Shell *shell);
+int shellRpcCmd(int argc, char *argv[]);
+
+#ifdef __cplusplus
+}
+#endif /**< defined __cplusplus */
+
+#endif
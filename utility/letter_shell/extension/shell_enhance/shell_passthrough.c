@@ -36,7 +36,7 @@ unsigned int shellPassthrough(Shell *shell, const char *prompt, ShellPassthrough
         shellWriteString(shell, prompt);
         while (1)
         {
-            if (shell->read && shell->read(&data, 1) == 1)
+            if (shellRead(shell, &data, 1) == 1)
             {
                 if (data == '\r' || data == '\n')
                 {
@@ -0,0 +1,212 @@
+/**
+ * @file shell_watch.c
+ * @brief shell periodic watch
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ */
+#include "shell_watch.h"
+#include "shell_ext.h"
+#include "osal.h"
+#include "string.h"
+#include "stdio.h"
+
+#if SHELL_ASYNC_EXEC != 1
+#error "shell watch runs until Ctrl-C, SHELL_ASYNC_EXEC must be enabled"
+#endif /** SHELL_ASYNC_EXEC != 1 */
+
+extern ShellCommand* shellSeekCommand(Shell *shell,
+                                      const char *cmd,
+                                      ShellCommand *base,
+                                      unsigned short compareLength);
+extern int shellGetVarValue(Shell *shell, ShellCommand *command);
+
+
+/**
+ * @brief watch 定时器回调
+ *        运行在定时器服务任务中, 只通知 watch 所在任务
+ *
+ * @param param 信号量
+ */
+static void shellWatchTimerCallback(void *param)
+{
+    osal_semaphore_release(param);
+}
+
+
+/**
+ * @brief watch 输出一次结果
+ *
+ * @param shell shell对象
+ * @param command 监视的命令或变量
+ * @param argc 命令参数个数(含命令名)
+ * @param argv 命令参数
+ * @param dropped 上次输出后跳过的刷新次数
+ */
+static void shellWatchShow(Shell *shell, ShellCommand *command,
+                           int argc, char *argv[], unsigned int dropped)
+{
+    char line[SHELL_WATCH_LINE_SIZE];
+    int length;
+    int value = 0;
+    unsigned char hasValue = 1;
+
+    switch (command->attr.attrs.type)
+    {
+    case SHELL_TYPE_CMD_MAIN:
+    {
+        int (*func)(int, char **) = command->data.cmd.function;
+        value = func(argc, argv);
+        hasValue = !command->attr.attrs.disableReturn;
+        break;
+    }
+    case SHELL_TYPE_CMD_FUNC:
+        value = shellExtRun(shell, command, argc, argv);
+        hasValue = !command->attr.attrs.disableReturn;
+        break;
+    default:
+        value = shellGetVarValue(shell, command);
+        break;
+    }
+
+    /* 命令与变量的名称位于data的不同成员 */
+    length = snprintf(line, sizeof(line), "[%lu] %s",
+                      (unsigned long)SHELL_GET_TICK(),
+                      (command->attr.attrs.type <= SHELL_TYPE_CMD_FUNC)
+                          ? command->data.cmd.name : command->data.var.name);
+    if (hasValue && length < (int)sizeof(line))
+    {
+        length += (command->attr.attrs.type == SHELL_TYPE_VAR_STRING)
+            ? snprintf(line + length, sizeof(line) - length, "=\"%s\"", (char *)(size_t)value)
+            : snprintf(line + length, sizeof(line) - length, "=%d", value);
+    }
+    if (dropped && length < (int)sizeof(line))
+    {
+        snprintf(line + length, sizeof(line) - length, " (+%u dropped)", dropped);
+    }
+    shellWriteString(shell, line);
+    shellWriteString(shell, "\r\n");
+    shellFlush(shell);
+}
+
+
+/**
+ * @brief shell watch
+ *        按周期重复执行命令或读取变量并输出结果, 直到命令被取消
+ *        等待期间释放shell锁, 其他任务的日志等输出不受影响
+ *
+ * @param shell shell对象
+ * @param period 刷新周期(ms)
+ * @param argc 参数个数, argv[0]为命令或变量名
+ * @param argv 参数
+ *
+ * @return int 0 被取消退出 -1 参数错误或资源不足
+ */
+int shellWatch(Shell *shell, unsigned int period, int argc, char *argv[])
+{
+    void *semaphore = NULL;
+    void *timer = NULL;
+    unsigned int dropped = 0;
+    int ret = -1;
+
+    SHELL_ASSERT(shell && argc > 0 && argv, return -1);
+    if (period < SHELL_WATCH_PERIOD_MIN)
+    {
+        period = SHELL_WATCH_PERIOD_MIN;
+    }
+
+    ShellCommand *command = shellSeekCommand(shell, argv[0], shell->commandList.base, 0);
+    if (command == NULL
+        || command->attr.attrs.type == SHELL_TYPE_USER
+        || command->attr.attrs.type == SHELL_TYPE_KEY
+        || (command->attr.attrs.type > SHELL_TYPE_CMD_FUNC && argc > 1))
+    {
+        shellWriteString(shell, "watch: command or var not found\r\n");
+        return -1;
+    }
+
+    S_OSAL_SEMAPHORE_CONFIG_T semaphoreConfig = {
+        .p_name = "shell watch",
+    };
+    S_OSAL_TIMER_CONFIG_T timerConfig = {
+        .p_name = "shell watch",
+        .p_callback = shellWatchTimerCallback,
+        .p_arg = NULL,
+        .type = E_OSAL_TIMER_TYPE_PERIODIC,
+    };
+    /* 二值信号量, 刷新慢于周期时多余的定时通知被合并 */
+    if (osal_semaphore_create(&semaphore, &semaphoreConfig, 1, 1) != E_OSAL_RET_STATUS_OK)
+    {
+        goto cleanup_and_exit;
+    }
+    timerConfig.p_arg = semaphore;
+    if (osal_timer_create(&timer, &timerConfig) != E_OSAL_RET_STATUS_OK
+        || osal_timer_start(timer, period) != E_OSAL_RET_STATUS_OK)
+    {
+        goto cleanup_and_exit;
+    }
+
+    while (!shellIsCancelled(shell))
+    {
+        SHELL_UNLOCK(shell);
+        E_OSAL_RET_STATUS_T status = osal_semaphore_acquire(semaphore, SHELL_WATCH_POLL_PERIOD);
+        SHELL_LOCK(shell);
+        if (status != E_OSAL_RET_STATUS_OK)
+        {
+            continue;
+        }
+
+        /* 输出空间不足时跳过本次刷新, 不阻塞在发送上 */
+        if (shell->writeSpace && shell->writeSpace() < SHELL_WATCH_LINE_SIZE)
+        {
+            dropped++;
+            continue;
+        }
+        shellWatchShow(shell, command, argc, argv, dropped);
+        dropped = 0;
+    }
+    ret = 0;
+
+cleanup_and_exit:
+    if (timer)
+    {
+        osal_timer_stop(timer);
+        osal_timer_delete(timer);
+    }
+    if (semaphore)
+    {
+        osal_semaphore_delete(semaphore);
+    }
+    if (ret != 0)
+    {
+        shellWriteString(shell, "watch: no timer resource\r\n");
+    }
+    return ret;
+}
+
+
+/**
+ * @brief shell watch 命令(shell调用)
+ *        watch <period_ms> <cmd|var> [args...]
+ *
+ * @param argc 参数个数
+ * @param argv 参数
+ *
+ * @return int 返回值
+ */
+int shellWatchCmd(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    size_t period;
+
+    SHELL_ASSERT(shell, return -1);
+    if (argc < 3 || shellExtParsePara(shell, argv[1], NULL, &period) != 0)
+    {
+        shellWriteString(shell, "usage: watch <period_ms> <cmd|var> [args...]\r\n");
+        return -1;
+    }
+    return shellWatch(shell, (unsigned int)period, argc - 2, &argv[2]);
+}
+SHELL_EXPORT_CMD(
+SHELL_CMD_PERMISSION(0)|SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN)|SHELL_CMD_DISABLE_RETURN,
+watch, shellWatchCmd, watch command or var periodically);
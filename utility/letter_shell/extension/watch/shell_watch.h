@@ -0,0 +1,40 @@
+/**
+ * @file shell_watch.h
+ * @brief shell periodic watch
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ */
+#ifndef __SHELL_WATCH_H__
+#define __SHELL_WATCH_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif /**< defined __cplusplus */
+
+#include "shell.h"
+
+#define     SHELL_WATCH_VERSION             "1.0.0"
+
+#define     SHELL_WATCH_PERIOD_MIN          10      /**< 最小刷新周期(ms) */
+#define     SHELL_WATCH_POLL_PERIOD         100     /**< 等待刷新时检查取消的周期(ms) */
+#define     SHELL_WATCH_LINE_SIZE           64      /**< 单行结果最大长度 */
+
+/**
+ * @brief watch 输出格式
+ *
+ *        变量:   [tick] name=value
+ *        命令:   命令自身输出, 然后 [tick] name=ret (禁用返回值的命令只输出 [tick] name)
+ *
+ *        输出可写空间(`Shell.writeSpace`)不足`SHELL_WATCH_LINE_SIZE`时跳过本次刷新,
+ *        下一次输出的结果行末尾附加 (+N dropped)
+ */
+
+int shellWatch(Shell *shell, unsigned int period, int argc, char *argv[]);
+int shellWatchCmd(int argc, char *argv[]);
+
+#ifdef __cplusplus
+}
+#endif /**< defined __cplusplus */
+
+#endif
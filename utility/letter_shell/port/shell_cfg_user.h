@@ -37,6 +37,45 @@
  */
 #define     SHELL_SUPPORT_END_LINE      1
 
+/**
+ * @brief 使用命令索引
+ *        命令查找为二分查找，索引按命令表大小分配
+ */
+#define     SHELL_USING_CMD_INDEX       1
+
+/**
+ * @brief shell输出缓冲大小
+ *        一次命令的输出合并为尽量少的串口发送
+ */
+#define     SHELL_WRITE_BUFFER          256
+
+/**
+ * @brief shell输出缓冲数据的最长保留时间(ms)
+ *        长时间运行的命令的输出保留超过此时间后输出，及时显示进度
+ */
+#define     SHELL_WRITE_FLUSH_TIME      50
+
+/**
+ * @brief 是否支持批量执行(`;`分隔的多命令行和`run`脚本)
+ */
+#define     SHELL_SUPPORT_BATCH         1
+
+/**
+ * @brief 是否使用二进制rpc模式
+ */
+#define     SHELL_USING_RPC             1
+
+/**
+ * @brief 是否使用异步命令执行
+ *        命令在shell工作任务中执行，输入任务继续接收数据，Ctrl-C取消命令
+ */
+#define     SHELL_ASYNC_EXEC            1
+
+/**
+ * @brief 是否使用watch命令
+ */
+#define     SHELL_USING_WATCH           1
+
 /**
  * @brief 获取系统时间(ms)
  *        定义此宏为获取系统Tick，如`HAL_GetTick()`
@@ -44,6 +83,12 @@
  */
 #define     SHELL_GET_TICK()            osal_get_tick()
 
+/**
+ * @brief 获取当前任务标识
+ *        多个shell会话同时执行命令时，`shellGetCurrent()`按任务区分会话
+ */
+#define     SHELL_GET_THREAD()          osal_thread_self()
+
 /**
  * @brief 使用锁
  * @note 使用shell锁时，需要对加锁和解锁进行实现
@@ -163,6 +163,19 @@ unsigned char pairedChars[][2] = {
 static Shell *shellList[SHELL_MAX_NUMBER] = {NULL};
 
 
+#if SHELL_USING_CMD_INDEX == 1
+/**
+ * @brief 命令索引(按命令名排序的命令表下标)，所有shell共享
+ */
+static struct
+{
+    const void *base;                                   /**< 建立索引的命令表基址 */
+    unsigned short count;                               /**< 索引数量 */
+    unsigned short *item;                               /**< 命令表下标，按命令表大小分配 */
+} shellCmdIndex = {NULL, 0, NULL};
+#endif /** SHELL_USING_CMD_INDEX == 1 */
+
+
 static void shellAdd(Shell *shell);
 static void shellWritePrompt(Shell *shell, unsigned char newline);
 static void shellWriteReturnValue(Shell *shell, int value);
@@ -173,6 +186,12 @@ ShellCommand* shellSeekCommand(Shell *shell,
                                ShellCommand *base,
                                unsigned short compareLength);
 static void shellWriteCommandHelp(Shell *shell, char *cmd);
+static void shellInitKeyHead(Shell *shell);
+#if SHELL_USING_CMD_INDEX == 1
+static void shellInitCommandIndex(Shell *shell);
+static unsigned short shellCommandIndexLowerBound(ShellCommand *base, const char *cmd);
+#endif /** SHELL_USING_CMD_INDEX == 1 */
+static const char* shellGetCommandName(ShellCommand *command);
 
 /**
  * @brief shell 初始化
@@ -183,8 +202,21 @@ void shellInit(Shell *shell, char *buffer, unsigned short size)
 {
     shell->parser.length = 0;
     shell->parser.cursor = 0;
+    shell->parser.rest = NULL;
+    shell->parser.restLength = 0;
     shell->info.user = NULL;
+    shell->info.writeCount = 0;
+    shell->info.thread = NULL;
     shell->status.isChecked = 1;
+    shell->status.isBatch = 0;
+#if SHELL_WRITE_BUFFER > 0
+    shell->output.length = 0;
+#endif /** SHELL_WRITE_BUFFER > 0 */
+#if SHELL_ASYNC_EXEC == 1
+    shell->exec.command = NULL;
+    shell->exec.isBusy = 0;
+    shell->exec.isCancelled = 0;
+#endif /** SHELL_ASYNC_EXEC == 1 */
 
     shell->parser.buffer = buffer;
     shell->parser.bufferSize = size / (SHELL_HISTORY_MAX_NUMBER + 1);
@@ -224,6 +256,10 @@ void shellInit(Shell *shell, char *buffer, unsigned short size)
     shell->commandList.count = shellCommandCount;
 #endif
 
+    shellInitKeyHead(shell);
+#if SHELL_USING_CMD_INDEX == 1
+    shellInitCommandIndex(shell);
+#endif /** SHELL_USING_CMD_INDEX == 1 */
     shellAdd(shell);
 
     shellSetUser(shell, shellSeekCommand(shell,
@@ -231,9 +267,133 @@ void shellInit(Shell *shell, char *buffer, unsigned short size)
                                          shell->commandList.base,
                                          0));
     shellWritePrompt(shell, 1);
+    shellFlush(shell);
+}
+
+
+/**
+ * @brief shell 设置命令表
+ *        替换`shellInit`使用的命令表，如应用层在`shellCommandList`之后追加自身命令的命令表，
+ *        重建按键位图和命令索引，当前用户不变，命令表在shell使用期间需要保持有效
+ * 
+ * @param shell shell对象
+ * @param base 命令表
+ * @param count 命令数量
+ */
+void shellSetCommandList(Shell *shell, const ShellCommand *base, unsigned short count)
+{
+    SHELL_ASSERT(shell && base, return);
+    shell->commandList.base = (ShellCommand *)base;
+    shell->commandList.count = count;
+    shellInitKeyHead(shell);
+#if SHELL_USING_CMD_INDEX == 1
+    shellInitCommandIndex(shell);
+#endif /** SHELL_USING_CMD_INDEX == 1 */
+}
+
+
+/**
+ * @brief 初始化按键首字节位图
+ *        用于批量输入时快速判断字节是否可能是按键的起始字节
+ * 
+ * @param shell shell对象
+ */
+static void shellInitKeyHead(Shell *shell)
+{
+    ShellCommand *base = (ShellCommand *)shell->commandList.base;
+    memset(shell->parser.keyHead, 0, sizeof(shell->parser.keyHead));
+    for (short i = 0; i < shell->commandList.count; i++)
+    {
+        if (base[i].attr.attrs.type == SHELL_TYPE_KEY)
+        {
+            unsigned char head = (base[i].data.key.value >> 24) & 0xFF;
+            shell->parser.keyHead[head >> 3] |= 1 << (head & 0x07);
+        }
+    }
+}
+
+
+#if SHELL_USING_CMD_INDEX == 1
+/**
+ * @brief 初始化命令索引
+ *        按命令名对命令表下标进行稳定排序，同名命令保持命令表中的先后顺序
+ *        按键不参与索引，索引空间按命令表大小分配，分配失败时不建立索引
+ * 
+ * @param shell shell对象
+ */
+static void shellInitCommandIndex(Shell *shell)
+{
+    ShellCommand *base = (ShellCommand *)shell->commandList.base;
+    unsigned short count = 0;
+
+    if (shellCmdIndex.base == shell->commandList.base)
+    {
+        return;
+    }
+
+    shellCmdIndex.base = NULL;
+    if (shellCmdIndex.item)
+    {
+        SHELL_FREE(shellCmdIndex.item);
+    }
+    shellCmdIndex.item = SHELL_MALLOC(shell->commandList.count * sizeof(unsigned short));
+    if (!shellCmdIndex.item)
+    {
+        return;
+    }
+    for (unsigned short i = 0; i < shell->commandList.count; i++)
+    {
+        if (base[i].attr.attrs.type == SHELL_TYPE_KEY)
+        {
+            continue;
+        }
+        /* 插入排序 */
+        const char *name = shellGetCommandName(&base[i]);
+        unsigned short j = count;
+        while (j > 0
+               && strcmp(shellGetCommandName(&base[shellCmdIndex.item[j - 1]]), name) > 0)
+        {
+            shellCmdIndex.item[j] = shellCmdIndex.item[j - 1];
+            j--;
+        }
+        shellCmdIndex.item[j] = i;
+        count++;
+    }
+    shellCmdIndex.count = count;
+    shellCmdIndex.base = shell->commandList.base;
 }
 
 
+/**
+ * @brief 在命令索引中查找第一个不小于指定字符串的位置
+ *        以指定字符串为前缀的命令在索引中连续排列，从此位置开始
+ * 
+ * @param base 命令表基址
+ * @param cmd 字符串
+ * 
+ * @return unsigned short 索引位置
+ */
+static unsigned short shellCommandIndexLowerBound(ShellCommand *base, const char *cmd)
+{
+    unsigned short low = 0;
+    unsigned short high = shellCmdIndex.count;
+    while (low < high)
+    {
+        unsigned short mid = low + ((high - low) >> 1);
+        if (strcmp(shellGetCommandName(&base[shellCmdIndex.item[mid]]), cmd) < 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low;
+}
+#endif /** SHELL_USING_CMD_INDEX == 1 */
+
+
 /**
  * @brief 添加shell
  * 
@@ -271,14 +431,17 @@ void shellRemove(Shell *shell)
 
 /**
  * @brief 获取当前活动shell
+ *        多个shell同时执行命令时，返回在调用任务中执行命令的shell
  * 
  * @return Shell* 当前活动shell对象
  */
 Shell* shellGetCurrent(void)
 {
+    void *thread = (void *)SHELL_GET_THREAD();
     for (short i = 0; i < SHELL_MAX_NUMBER; i++)
     {
-        if (shellList[i] && shellList[i]->status.isActive)
+        if (shellList[i] && shellList[i]->status.isActive
+            && shellList[i]->info.thread == thread)
         {
             return shellList[i];
         }
@@ -287,6 +450,81 @@ Shell* shellGetCurrent(void)
 }
 
 
+/**
+ * @brief shell 写数据
+ *        使用输出缓冲时写入缓冲，缓冲满或缓冲数据保留超过`SHELL_WRITE_FLUSH_TIME`时输出
+ * 
+ * @param shell shell对象
+ * @param data 数据
+ * @param len 数据长度
+ * 
+ * @return unsigned short 写入数据的长度
+ */
+static unsigned short shellWrite(Shell *shell, const char *data, unsigned short len)
+{
+#if SHELL_WRITE_BUFFER > 0
+    unsigned short count = 0;
+    unsigned short size;
+
+    /* 缓冲为空且数据不小于缓冲大小时直接输出 */
+    if (shell->output.length == 0 && len >= SHELL_WRITE_BUFFER)
+    {
+        shell->info.writeCount++;
+        return shell->write((char *)data, len);
+    }
+    while (count < len)
+    {
+        if (shell->output.length == 0)
+        {
+            shell->output.tick = SHELL_GET_TICK();
+        }
+        size = SHELL_WRITE_BUFFER - shell->output.length;
+        if (size > len - count)
+        {
+            size = len - count;
+        }
+        memcpy(shell->output.buffer + shell->output.length, data + count, size);
+        shell->output.length += size;
+        count += size;
+        if (shell->output.length >= SHELL_WRITE_BUFFER)
+        {
+            shellFlush(shell);
+        }
+    }
+#if SHELL_WRITE_FLUSH_TIME > 0
+    /* 命令长时间运行时，不等命令结束输出已缓冲的数据 */
+    if (shell->output.length > 0
+        && (unsigned int)(SHELL_GET_TICK() - shell->output.tick) >= SHELL_WRITE_FLUSH_TIME)
+    {
+        shellFlush(shell);
+    }
+#endif /** SHELL_WRITE_FLUSH_TIME > 0 */
+    return len;
+#else
+    shell->info.writeCount++;
+    return shell->write((char *)data, len);
+#endif /** SHELL_WRITE_BUFFER > 0 */
+}
+
+
+/**
+ * @brief shell 输出缓冲中的数据
+ * 
+ * @param shell shell对象
+ */
+void shellFlush(Shell *shell)
+{
+#if SHELL_WRITE_BUFFER > 0
+    if (shell->output.length > 0)
+    {
+        shell->info.writeCount++;
+        shell->write(shell->output.buffer, shell->output.length);
+        shell->output.length = 0;
+    }
+#endif /** SHELL_WRITE_BUFFER > 0 */
+}
+
+
 /**
  * @brief shell写字符
  * 
@@ -295,7 +533,7 @@ Shell* shellGetCurrent(void)
  */
 static void shellWriteByte(Shell *shell, char data)
 {
-    shell->write(&data, 1);
+    shellWrite(shell, &data, 1);
 }
 
 
@@ -316,7 +554,7 @@ unsigned short shellWriteString(Shell *shell, const char *string)
     {
         count ++;
     }
-    return shell->write((char *)string, count);
+    return shellWrite(shell, string, count);
 }
 
 
@@ -341,12 +579,12 @@ static unsigned short shellWriteCommandDesc(Shell *shell, const char *string)
     
     if (count > 36)
     {
-        shell->write((char *)string, 36);
-        shell->write("...", 3);
+        shellWrite(shell, string, 36);
+        shellWrite(shell, "...", 3);
     }
     else
     {
-        shell->write((char *)string, count);
+        shellWrite(shell, string, count);
     }
     return count > 36 ? 36 : 39;
 }
@@ -402,7 +640,7 @@ void shellPrint(Shell *shell, const char *fmt, ...)
     {
         len = SHELL_PRINT_BUFFER;
     }
-    shell->write(buffer, len);
+    shellWrite(shell, buffer, len);
 }
 #endif
 
@@ -426,9 +664,10 @@ void shellScan(Shell *shell, char *fmt, ...)
     if (shell->read)
     {
         do {
-            if (shell->read(&buffer[index], 1) == 1)
+            if (shellRead(shell, &buffer[index], 1) == 1)
             {
-                shell->write(&buffer[index], 1);
+                shellWrite(shell, &buffer[index], 1);
+                shellFlush(shell);
                 index++;
             }
         } while (buffer[index -1] != '\r' && buffer[index -1] != '\n' && index < SHELL_SCAN_BUFFER);
@@ -1030,6 +1269,28 @@ ShellCommand* shellSeekCommand(Shell *shell,
     const char *name;
     unsigned short count = shell->commandList.count -
         ((size_t)base - (size_t)shell->commandList.base) / sizeof(ShellCommand);
+#if SHELL_USING_CMD_INDEX == 1
+    /* 从命令表起始位置完整匹配时，使用命令索引二分查找 */
+    if (!compareLength
+        && base == shell->commandList.base
+        && shellCmdIndex.base == shell->commandList.base)
+    {
+        unsigned short low = shellCommandIndexLowerBound(base, cmd);
+        for (; low < shellCmdIndex.count; low++)
+        {
+            ShellCommand *command = &base[shellCmdIndex.item[low]];
+            if (strcmp(shellGetCommandName(command), cmd) != 0)
+            {
+                break;
+            }
+            if (shellCheckPermission(shell, command) == 0)
+            {
+                return command;
+            }
+        }
+        return NULL;
+    }
+#endif /** SHELL_USING_CMD_INDEX == 1 */
     for (unsigned short i = 0; i < count; i++)
     {
         if (base[i].attr.attrs.type == SHELL_TYPE_KEY
@@ -1241,13 +1502,14 @@ setVar, shellSetVar, set var);
 unsigned int shellRunCommand(Shell *shell, ShellCommand *command)
 {
     int returnValue = 0;
+    shell->info.thread = (void *)SHELL_GET_THREAD();
     shell->status.isActive = 1;
     if (command->attr.attrs.type == SHELL_TYPE_CMD_MAIN)
     {
         shellRemoveParamQuotes(shell);
         int (*func)(int, char **) = command->data.cmd.function;
         returnValue = func(shell->parser.paramCount, shell->parser.param);
-        if (!command->attr.attrs.disableReturn)
+        if (!command->attr.attrs.disableReturn && !shell->status.isBatch)
         {
             shellWriteReturnValue(shell, returnValue);
         }
@@ -1258,7 +1520,7 @@ unsigned int shellRunCommand(Shell *shell, ShellCommand *command)
                                   command,
                                   shell->parser.paramCount,
                                   shell->parser.param);
-        if (!command->attr.attrs.disableReturn)
+        if (!command->attr.attrs.disableReturn && !shell->status.isBatch)
         {
             shellWriteReturnValue(shell, returnValue);
         }
@@ -1449,14 +1711,359 @@ void shellNormalInput(Shell *shell, char data)
 }
 
 
+#if SHELL_SUPPORT_BATCH == 1
 /**
- * @brief shell运行命令
+ * @brief shell 查找批处理中下一条命令的结束位置
+ *        `;`和换行为命令分隔符，引号内和转义的分隔符不计
+ * 
+ * @param script 脚本
+ * @param length 脚本长度
+ * 
+ * @return unsigned short 第一条命令的长度，没有分隔符时等于脚本长度
+ */
+static unsigned short shellBatchNext(const char *script, unsigned short length)
+{
+    unsigned char quoted = 0;
+
+    for (unsigned short i = 0; i < length; i++)
+    {
+        if (script[i] == '\\' && i + 1 < length)
+        {
+            i++;
+        }
+        else if (script[i] == '\"')
+        {
+            quoted = !quoted;
+        }
+        else if (!quoted
+                 && (script[i] == ';' || script[i] == '\r' || script[i] == '\n'))
+        {
+            return i;
+        }
+    }
+    return length;
+}
+
+
+/**
+ * @brief shell 批量执行命令
+ *        依次执行脚本中的命令，不输出提示符和返回值，每条命令输出一行状态：
+ *        [序号] 命令: ok (返回值) / failed (返回值) / not found
+ *        空行和`#`开头的行忽略
  * 
  * @param shell shell对象
+ * @param script 脚本, 执行时会被修改, 缓冲需要至少`length + 1`字节
+ * @param length 脚本长度
+ * @param stopOnError 命令未找到或返回负值时停止执行
+ * 
+ * @return int 0 全部成功 -1 存在失败的命令
  */
-void shellExec(Shell *shell)
+int shellRunBatch(Shell *shell, char *script, unsigned short length, unsigned char stopOnError)
 {
-    
+    unsigned short index = 0;
+    unsigned short number = 0;
+    unsigned short failed = 0;
+    unsigned char active;
+    unsigned char batch;
+    char buffer[12];
+
+    SHELL_ASSERT(shell && script, return -1);
+    active = shell->status.isActive;
+    batch = shell->status.isBatch;
+    shell->status.isBatch = 1;
+
+    while (index < length)
+    {
+    #if SHELL_ASYNC_EXEC == 1
+        if (shellIsCancelled(shell))
+        {
+            break;
+        }
+    #endif /** SHELL_ASYNC_EXEC == 1 */
+        char *line = script + index;
+        unsigned short lineLength = shellBatchNext(line, length - index);
+        line[lineLength] = 0;
+        index += lineLength + 1;
+        while (*line == ' ' || *line == '\t')
+        {
+            line++;
+        }
+        if (*line == 0 || *line == '#')
+        {
+            continue;
+        }
+
+        shell->parser.paramCount = shellSplit(line, strlen(line), shell->parser.param,
+                                              ' ', SHELL_PARAMETER_MAX_NUMBER);
+        if (shell->parser.paramCount == 0)
+        {
+            continue;
+        }
+        number++;
+        ShellCommand *command = shellSeekCommand(shell,
+                                                 shell->parser.param[0],
+                                                 shell->commandList.base,
+                                                 0);
+        int ret = 0;
+        unsigned char hasReturn = 0;
+        if (command != NULL)
+        {
+            ret = (int)shellRunCommand(shell, command);
+            shell->status.isActive = active;
+            hasReturn = command->attr.attrs.type <= SHELL_TYPE_CMD_FUNC
+                        && !command->attr.attrs.disableReturn;
+        }
+
+        /* 状态行跟在命令自身的输出之后 */
+        shellWriteString(shell, "[");
+        shellWriteString(shell, &buffer[11 - shellToDec(number, buffer)]);
+        shellWriteString(shell, "] ");
+        shellWriteString(shell, command ? shellGetCommandName(command) : shell->parser.param[0]);
+        if (command == NULL)
+        {
+            shellWriteString(shell, ": not found\r\n");
+            failed++;
+        }
+        else
+        {
+            if (hasReturn && ret < 0)
+            {
+                failed++;
+            }
+            shellWriteString(shell, (hasReturn && ret < 0) ? ": failed" : ": ok");
+            if (hasReturn)
+            {
+                shellWriteString(shell, " (");
+                shellWriteString(shell, &buffer[11 - shellToDec(ret, buffer)]);
+                shellWriteString(shell, ")");
+            }
+            shellWriteString(shell, "\r\n");
+        }
+        if (failed && stopOnError)
+        {
+            shellWriteString(shell, "batch stopped on error\r\n");
+            break;
+        }
+    }
+
+    shell->status.isBatch = batch;
+    return failed ? -1 : 0;
+}
+
+
+/**
+ * @brief shell 执行输入缓冲中的多命令行(内部命令)
+ * 
+ * @param argc 参数个数
+ * @param argv 参数
+ * 
+ * @return int 0 全部成功 -1 存在失败的命令
+ */
+static int shellBatchLine(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    (void)argc;
+    (void)argv;
+    SHELL_ASSERT(shell, return -1);
+    return shellRunBatch(shell, shell->parser.buffer, strlen(shell->parser.buffer), 1);
+}
+
+static ShellCommand shellBatchCommand =
+{
+    .attr.value = SHELL_CMD_PERMISSION(0)|SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN)|SHELL_CMD_DISABLE_RETURN,
+    .data.cmd.name = ";",
+    .data.cmd.function = (int (*)())shellBatchLine,
+    .data.cmd.desc = "run multi command line",
+};
+
+
+/**
+ * @brief shell 执行脚本(shell调用)
+ *        run [-k]
+ *        读取随后输入的脚本(包括与命令同一批输入的数据)，以单独一行`.`或Ctrl-D结束，脚本输入不回显，
+ *        读取完成后批量执行，`-k`表示出错后继续执行
+ * 
+ * @param argc 参数个数
+ * @param argv 参数
+ * 
+ * @return int 0 全部成功 -1 存在失败的命令或脚本过长
+ */
+int shellRunScript(int argc, char *argv[])
+{
+    Shell *shell = shellGetCurrent();
+    unsigned short length = 0;
+    unsigned short lineStart = 0;
+    unsigned char overflow = 0;
+    int ret = -1;
+    char data;
+
+    SHELL_ASSERT(shell, return -1);
+    char *script = SHELL_MALLOC(SHELL_SCRIPT_BUFFER);
+    if (script == NULL)
+    {
+        shellWriteString(shell, "run: no memory\r\n");
+        return -1;
+    }
+
+    while (1)
+    {
+        if (shellRead(shell, &data, 1) != 1)
+        {
+            continue;
+        }
+        if (data == 0x04)
+        {
+            break;
+        }
+        if (data == '\r' || data == '\n')
+        {
+            if (length == lineStart + 1 && script[lineStart] == '.')
+            {
+                length = lineStart;
+                break;
+            }
+            lineStart = length + 1;
+        }
+        if (length < SHELL_SCRIPT_BUFFER - 1)
+        {
+            script[length++] = data;
+        }
+        else
+        {
+            overflow = 1;
+        }
+    }
+
+    if (overflow)
+    {
+        shellWriteString(shell, "run: script too long\r\n");
+    }
+    else
+    {
+        ret = shellRunBatch(shell, script, length,
+                            !(argc > 1 && strcmp(argv[1], "-k") == 0));
+    }
+    SHELL_FREE(script);
+    return ret;
+}
+SHELL_EXPORT_CMD(
+SHELL_CMD_PERMISSION(0)|SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN)|SHELL_CMD_READ_INPUT,
+run, shellRunScript, run script block ended by '.' line);
+#endif /** SHELL_SUPPORT_BATCH == 1 */
+
+
+#if SHELL_ASYNC_EXEC == 1
+/**
+ * @brief shell派发命令
+ *        派发函数接受后，命令由工作任务调用`shellExecAsync()`执行，
+ *        在此之前输入缓冲中的参数不能被修改，自行读取输入的命令不派发
+ * 
+ * @param shell shell对象
+ * @param command 命令
+ * 
+ * @return int 0 派发成功 -1 未派发, 需要直接执行
+ */
+static int shellDispatch(Shell *shell, ShellCommand *command)
+{
+    if (!shell->dispatch || shell->exec.isBusy || command->attr.attrs.readInput)
+    {
+        return -1;
+    }
+    shell->exec.command = command;
+    shell->exec.isCancelled = 0;
+    shell->exec.isBusy = 1;
+    if (shell->dispatch(shell, command) != 0)
+    {
+        shell->exec.command = NULL;
+        shell->exec.isBusy = 0;
+        return -1;
+    }
+    return 0;
+}
+
+
+/**
+ * @brief shell 异步执行命令(工作任务调用)
+ *        执行已派发的命令，结束后输出提示符
+ * 
+ * @param shell shell对象
+ */
+void shellExecAsync(Shell *shell)
+{
+    SHELL_ASSERT(shell && shell->exec.isBusy && shell->exec.command, return);
+    SHELL_LOCK(shell);
+    shellRunCommand(shell, shell->exec.command);
+    if (shell->exec.isCancelled)
+    {
+        shellWriteString(shell, "^C");
+    }
+    shellWritePrompt(shell, 1);
+    shellFlush(shell);
+    shell->exec.command = NULL;
+    shell->exec.isBusy = 0;
+    SHELL_UNLOCK(shell);
+}
+
+
+/**
+ * @brief shell 取消正在执行的命令
+ *        仅设置取消标志，由命令通过`shellIsCancelled()`查询后自行退出
+ * 
+ * @param shell shell对象
+ * 
+ * @return int 0 已请求取消 -1 没有正在执行的命令
+ */
+int shellCancel(Shell *shell)
+{
+    SHELL_ASSERT(shell, return -1);
+    if (!shell->exec.isBusy)
+    {
+        return -1;
+    }
+    shell->exec.isCancelled = 1;
+    return 0;
+}
+
+
+/**
+ * @brief shell 是否有命令正在执行
+ * 
+ * @param shell shell对象
+ * 
+ * @return int 1 执行中 0 空闲
+ */
+int shellIsBusy(Shell *shell)
+{
+    return (shell && shell->exec.isBusy) ? 1 : 0;
+}
+
+
+/**
+ * @brief shell 当前命令是否已被取消
+ *        耗时命令应在循环中调用此函数，返回1时尽快结束
+ * 
+ * @param shell shell对象, 为NULL时使用当前活动shell
+ * 
+ * @return int 1 已取消 0 未取消
+ */
+int shellIsCancelled(Shell *shell)
+{
+    shell = shell ? shell : shellGetCurrent();
+    return (shell && shell->exec.isCancelled) ? 1 : 0;
+}
+#endif /** SHELL_ASYNC_EXEC == 1 */
+
+
+/**
+ * @brief shell运行输入缓冲中的命令
+ * 
+ * @param shell shell对象
+ * @param async 是否允许派发到工作任务执行
+ */
+static void shellExecLine(Shell *shell, unsigned char async)
+{
+    (void)async;
+
     if (shell->parser.length == 0)
     {
         return;
@@ -1469,20 +2076,41 @@ void shellExec(Shell *shell)
     #if SHELL_HISTORY_MAX_NUMBER > 0
         shellHistoryAdd(shell);
     #endif /** SHELL_HISTORY_MAX_NUMBER > 0 */
-        shellParserParam(shell);
+        ShellCommand *command = NULL;
+    #if SHELL_SUPPORT_BATCH == 1
+        if (shellBatchNext(shell->parser.buffer, shell->parser.length) < shell->parser.length)
+        {
+            /* 多命令行整行作为批处理执行，输入缓冲保持原样 */
+            shell->parser.paramCount = 0;
+            command = &shellBatchCommand;
+        }
+        else
+    #endif /** SHELL_SUPPORT_BATCH == 1 */
+        {
+            shellParserParam(shell);
+        }
         shell->parser.length = shell->parser.cursor = 0;
-        if (shell->parser.paramCount == 0)
+        if (shell->parser.paramCount == 0 && command == NULL)
         {
             return;
         }
         shellWriteString(shell, "\r\n");
 
-        ShellCommand *command = shellSeekCommand(shell,
-                                                 shell->parser.param[0],
-                                                 shell->commandList.base,
-                                                 0);
+        if (command == NULL)
+        {
+            command = shellSeekCommand(shell,
+                                       shell->parser.param[0],
+                                       shell->commandList.base,
+                                       0);
+        }
         if (command != NULL)
         {
+        #if SHELL_ASYNC_EXEC == 1
+            if (async && shellDispatch(shell, command) == 0)
+            {
+                return;
+            }
+        #endif /** SHELL_ASYNC_EXEC == 1 */
             shellRunCommand(shell, command);
         }
         else
@@ -1497,6 +2125,17 @@ void shellExec(Shell *shell)
 }
 
 
+/**
+ * @brief shell运行命令
+ * 
+ * @param shell shell对象
+ */
+void shellExec(Shell *shell)
+{
+    shellExecLine(shell, 1);
+}
+
+
 #if SHELL_HISTORY_MAX_NUMBER > 0
 /**
  * @brief shell上方向键输入
@@ -1577,8 +2216,31 @@ void shellTab(Shell *shell)
     {
         shell->parser.buffer[shell->parser.length] = 0;
         ShellCommand *base = (ShellCommand *)shell->commandList.base;
-        for (short i = 0; i < shell->commandList.count; i++)
+        unsigned short first = 0;
+        unsigned short end = shell->commandList.count;
+    #if SHELL_USING_CMD_INDEX == 1
+        /* 使用命令索引时，匹配前缀的命令在索引中连续排列，只遍历该区间 */
+        unsigned char indexed = (shellCmdIndex.base == shell->commandList.base);
+        if (indexed)
+        {
+            first = shellCommandIndexLowerBound(base, shell->parser.buffer);
+            end = shellCmdIndex.count;
+        }
+    #endif /** SHELL_USING_CMD_INDEX == 1 */
+        for (unsigned short k = first; k < end; k++)
         {
+            short i = k;
+        #if SHELL_USING_CMD_INDEX == 1
+            if (indexed)
+            {
+                i = shellCmdIndex.item[k];
+                if (strncmp(shellGetCommandName(&base[i]),
+                            shell->parser.buffer, shell->parser.length) != 0)
+                {
+                    break;
+                }
+            }
+        #endif /** SHELL_USING_CMD_INDEX == 1 */
             if (shellCheckPermission(shell, &base[i]) == 0
                 && shellStringCompare(shell->parser.buffer,
                                    (char *)shellGetCommandName(&base[i]))
@@ -1694,6 +2356,12 @@ SHELL_EXPORT_KEY(SHELL_CMD_PERMISSION(0)|SHELL_CMD_ENABLE_UNCHECKED,
 void shellEnter(Shell *shell)
 {
     shellExec(shell);
+#if SHELL_ASYNC_EXEC == 1
+    if (shell->exec.isBusy)
+    {
+        return;
+    }
+#endif /** SHELL_ASYNC_EXEC == 1 */
     shellWritePrompt(shell, 1);
 }
 #if SHELL_ENTER_LF == 1
@@ -1758,18 +2426,14 @@ SHELL_EXPORT_CMD(
 SHELL_CMD_PERMISSION(0)|SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN)|SHELL_CMD_DISABLE_RETURN,
 help, shellHelp, show command info\r\nhelp [cmd]);
 
+#if SHELL_LOCK_TIMEOUT > 0
 /**
- * @brief shell 输入处理
+ * @brief shell 检查锁定超时
  * 
  * @param shell shell对象
- * @param data 输入数据
  */
-void shellHandler(Shell *shell, char data)
+static void shellCheckLockTimeout(Shell *shell)
 {
-    SHELL_ASSERT(data, return);
-    SHELL_LOCK(shell);
-
-#if SHELL_LOCK_TIMEOUT > 0
     if (shell->info.user->data.user.password
         && strlen(shell->info.user->data.user.password) != 0
         && SHELL_GET_TICK())
@@ -1779,8 +2443,18 @@ void shellHandler(Shell *shell, char data)
             shell->status.isChecked = 0;
         }
     }
+}
 #endif
 
+
+/**
+ * @brief shell 单字节输入处理(不加锁)
+ * 
+ * @param shell shell对象
+ * @param data 输入数据
+ */
+static void shellHandlerByte(Shell *shell, char data)
+{
     /* 根据记录的按键键值计算当前字节在按键键值中的偏移 */
     char keyByteOffset = 24;
     int keyFilter = 0x00000000;
@@ -1835,6 +2509,26 @@ void shellHandler(Shell *shell, char data)
         shell->parser.keyValue = 0x00000000;
         shellNormalInput(shell, data);
     }
+}
+
+
+/**
+ * @brief shell 输入处理
+ * 
+ * @param shell shell对象
+ * @param data 输入数据
+ */
+void shellHandler(Shell *shell, char data)
+{
+    SHELL_ASSERT(data, return);
+    SHELL_LOCK(shell);
+
+#if SHELL_LOCK_TIMEOUT > 0
+    shellCheckLockTimeout(shell);
+#endif
+
+    shellHandlerByte(shell, data);
+    shellFlush(shell);
 
     if (SHELL_GET_TICK())
     {
@@ -1844,17 +2538,141 @@ void shellHandler(Shell *shell, char data)
 }
 
 
+/**
+ * @brief shell 批量输入处理
+ *        连续的可打印字符直接追加到输入缓冲并一次性回显，
+ *        控制字符、转义序列及光标不在行尾等情况退回逐字节处理
+ * 
+ * @param shell shell对象
+ * @param data 输入数据
+ * @param len 数据长度
+ * 
+ * @return unsigned short 已处理的数据长度
+ *         自行读取输入的命令通过`shellRead()`先读取本批数据中命令之后的部分，
+ *         被命令读取的数据计入已处理长度，不再作为shell输入处理
+ *         使用异步命令执行时，命令派发后停止处理，剩余数据需在命令结束后重新输入
+ */
+unsigned short shellHandlerBuffer(Shell *shell, const char *data, unsigned short len)
+{
+    unsigned short index = 0;
+
+    SHELL_ASSERT(data && len, return 0);
+    SHELL_LOCK(shell);
+
+#if SHELL_LOCK_TIMEOUT > 0
+    shellCheckLockTimeout(shell);
+#endif
+
+    while (index < len)
+    {
+        unsigned short start = index;
+        unsigned short remain = shell->parser.bufferSize - 1 - shell->parser.length;
+
+        /* 行尾插入可打印字符, 且不构成按键时走快速路径 */
+        if (shell->parser.keyValue == 0x00000000
+            && shell->status.isChecked
+            && shell->parser.cursor == shell->parser.length)
+        {
+            while (index < len
+                   && index - start < remain
+                   && data[index] >= 0x20 && data[index] <= 0x7E
+                   && !(shell->parser.keyHead[(unsigned char)data[index] >> 3]
+                        & (1 << (data[index] & 0x07))))
+            {
+                index++;
+            }
+        }
+
+        if (index > start)
+        {
+            memcpy(shell->parser.buffer + shell->parser.length, data + start, index - start);
+            shell->parser.length += index - start;
+            shell->parser.buffer[shell->parser.length] = 0;
+            shell->parser.cursor = shell->parser.length;
+            shell->status.tabFlag = 0;
+            shellWrite(shell, data + start, index - start);
+        }
+        else
+        {
+            /* 逐字节处理可能执行命令，命令自行读取输入时先读取本批剩余的数据 */
+            shell->parser.rest = data + index + 1;
+            shell->parser.restLength = len - index - 1;
+            if (data[index] != 0x00)
+            {
+                shellHandlerByte(shell, data[index]);
+            }
+            index = len - shell->parser.restLength;
+            shell->parser.rest = NULL;
+            shell->parser.restLength = 0;
+        #if SHELL_ASYNC_EXEC == 1
+            if (shell->exec.isBusy)
+            {
+                break;
+            }
+        #endif /** SHELL_ASYNC_EXEC == 1 */
+        }
+    }
+    shellFlush(shell);
+
+    if (SHELL_GET_TICK())
+    {
+        shell->info.activeTime = SHELL_GET_TICK();
+    }
+    SHELL_UNLOCK(shell);
+
+    return index;
+}
+
+
+/**
+ * @brief shell 读数据
+ *        自行读取输入的命令应使用此函数读取，
+ *        命令在批量输入中执行时，先返回同一批数据中命令之后尚未处理的数据，
+ *        读完后输出缓冲中的数据，再调用shell读函数
+ * 
+ * @param shell shell对象
+ * @param data 数据缓冲
+ * @param len 最大读取长度
+ * 
+ * @return signed short 读取到的数据长度
+ */
+signed short shellRead(Shell *shell, char *data, unsigned short len)
+{
+    SHELL_ASSERT(shell && data, return 0);
+    if (shell->parser.restLength > 0)
+    {
+        if (len > shell->parser.restLength)
+        {
+            len = shell->parser.restLength;
+        }
+        memcpy(data, shell->parser.rest, len);
+        shell->parser.rest += len;
+        shell->parser.restLength -= len;
+        return len;
+    }
+    /* 阻塞读取前输出缓冲中的数据，如提示符和命令已有的输出 */
+    shellFlush(shell);
+    return shell->read ? shell->read(data, len) : 0;
+}
+
+
 #if SHELL_SUPPORT_END_LINE == 1
 void shellWriteEndLine(Shell *shell, char *buffer, int len)
 {
+    unsigned char redraw;
+
     SHELL_LOCK(shell);
-    if (!shell->status.isActive)
+    redraw = !shell->status.isActive;
+#if SHELL_ASYNC_EXEC == 1
+    redraw = redraw && !shell->exec.isBusy;
+#endif /** SHELL_ASYNC_EXEC == 1 */
+    if (redraw)
     {
         shellWriteString(shell, shellText[SHELL_TEXT_CLEAR_LINE]);
     }
-    shell->write(buffer, len);
+    shellWrite(shell, buffer, len);
 
-    if (!shell->status.isActive)
+    if (redraw)
     {
         shellWritePrompt(shell, 0);
         if (shell->parser.length > 0)
@@ -1866,6 +2684,7 @@ void shellWriteEndLine(Shell *shell, char *buffer, int len)
             }
         }
     }
+    shellFlush(shell);
     SHELL_UNLOCK(shell);
 }
 #endif /** SHELL_SUPPORT_END_LINE == 1 */
@@ -1975,6 +2794,22 @@ SHELL_CMD_PERMISSION(0)|SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC)|SHELL_CMD_DISABLE_RE
 clear, shellClear, clear console);
 
 
+/**
+ * @brief shell 获取写函数调用次数(shell调用)
+ *        在命令前后分别执行，差值即为命令输出产生的写函数调用次数
+ * 
+ * @return int 写函数调用次数
+ */
+int shellWrites(void)
+{
+    Shell *shell = shellGetCurrent();
+    return shell ? (int)shell->info.writeCount : 0;
+}
+SHELL_EXPORT_CMD(
+SHELL_CMD_PERMISSION(0)|SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC),
+writes, shellWrites, show write count);
+
+
 /**
  * @brief shell执行命令
  * 
@@ -1994,7 +2829,8 @@ int shellRun(Shell *shell, const char *cmd)
     else
     {
         shell->parser.length = shellStringCopy(shell->parser.buffer, (char *)cmd);
-        shellExec(shell);
+        shellExecLine(shell, 0);
+        shellFlush(shell);
         shell->status.isActive = active;
         return 0;
     }
@@ -69,6 +69,12 @@
 #define     SHELL_CMD_READ_ONLY \
             (1 << 14)
 
+/**
+ * @brief 命令自行读取输入(不派发到工作任务执行)
+ */
+#define     SHELL_CMD_READ_INPUT \
+            (1 << 15)
+
 /**
  * @brief 命令参数数量
  */
@@ -409,6 +415,8 @@ typedef struct shell_def
     #if SHELL_KEEP_RETURN_VALUE == 1
         int retVal;                                             /**< 返回值 */
     #endif
+        unsigned int writeCount;                                /**< 写函数调用次数 */
+        void *thread;                                           /**< 执行命令的任务 */
     } info;
     struct
     {
@@ -419,6 +427,9 @@ typedef struct shell_def
         unsigned short bufferSize;                              /**< 输入缓冲大小 */
         unsigned short paramCount;                              /**< 参数数量 */
         int keyValue;                                           /**< 输入按键键值 */
+        unsigned char keyHead[32];                              /**< 按键首字节位图 */
+        const char *rest;                                       /**< 批量输入中当前字节之后的数据 */
+        unsigned short restLength;                              /**< 批量输入中当前字节之后的数据长度 */
     } parser;
 #if SHELL_HISTORY_MAX_NUMBER > 0
     struct
@@ -439,9 +450,30 @@ typedef struct shell_def
         unsigned char isChecked : 1;                            /**< 密码校验通过 */
         unsigned char isActive : 1;                             /**< 当前活动Shell */
         unsigned char tabFlag : 1;                              /**< tab标志 */
+        unsigned char isBatch : 1;                              /**< 批量执行中 */
     } status;
+#if SHELL_WRITE_BUFFER > 0
+    struct
+    {
+        char buffer[SHELL_WRITE_BUFFER];                        /**< 输出缓冲 */
+        unsigned short length;                                  /**< 输出缓冲数据长度 */
+        unsigned int tick;                                      /**< 缓冲中最早数据的写入时间 */
+    } output;
+#endif /** SHELL_WRITE_BUFFER > 0 */
+#if SHELL_ASYNC_EXEC == 1
+    struct
+    {
+        struct shell_command *command;                          /**< 待执行命令 */
+        volatile unsigned char isBusy;                          /**< 命令执行中 */
+        volatile unsigned char isCancelled;                     /**< 命令已取消 */
+    } exec;
+    int (*dispatch)(struct shell_def *, const struct shell_command *); /**< 命令派发函数 */
+#endif /** SHELL_ASYNC_EXEC == 1 */
     signed short (*read)(char *, unsigned short);               /**< shell读函数 */
     signed short (*write)(char *, unsigned short);              /**< shell写函数 */
+#if SHELL_USING_WATCH == 1
+    signed short (*writeSpace)(void);                           /**< shell可写空间获取函数, 可为NULL */
+#endif /** SHELL_USING_WATCH == 1 */
 #if SHELL_USING_LOCK == 1
     int (*lock)(struct shell_def *);                              /**< shell 加锁 */
     int (*unlock)(struct shell_def *);                            /**< shell 解锁 */
@@ -463,7 +495,7 @@ typedef struct shell_command
             unsigned char enableUnchecked : 1;                  /**< 在未校验密码的情况下可用 */
             unsigned char disableReturn : 1;                    /**< 禁用返回值输出 */
             unsigned char readOnly : 1;                         /**< 只读 */
-            unsigned char reserve : 1;                          /**< 保留 */
+            unsigned char readInput : 1;                        /**< 命令自行读取输入 */
             unsigned char paramNum : 4;                         /**< 参数数量 */
         } attrs;
         int value;
@@ -525,15 +557,28 @@ typedef struct
 #define shellDeInit(shell)              shellRemove(shell)
 
 void shellInit(Shell *shell, char *buffer, unsigned short size);
+void shellSetCommandList(Shell *shell, const ShellCommand *base, unsigned short count);
 void shellRemove(Shell *shell);
 unsigned short shellWriteString(Shell *shell, const char *string);
+void shellFlush(Shell *shell);
 void shellPrint(Shell *shell, const char *fmt, ...);
 void shellScan(Shell *shell, char *fmt, ...);
 Shell* shellGetCurrent(void);
 void shellHandler(Shell *shell, char data);
+unsigned short shellHandlerBuffer(Shell *shell, const char *data, unsigned short len);
+signed short shellRead(Shell *shell, char *data, unsigned short len);
 void shellWriteEndLine(Shell *shell, char *buffer, int len);
 void shellTask(void *param);
 int shellRun(Shell *shell, const char *cmd);
+#if SHELL_SUPPORT_BATCH == 1
+int shellRunBatch(Shell *shell, char *script, unsigned short length, unsigned char stopOnError);
+#endif /** SHELL_SUPPORT_BATCH == 1 */
+#if SHELL_ASYNC_EXEC == 1
+void shellExecAsync(Shell *shell);
+int shellCancel(Shell *shell);
+int shellIsBusy(Shell *shell);
+int shellIsCancelled(Shell *shell);
+#endif /** SHELL_ASYNC_EXEC == 1 */
 
 
 
@@ -157,7 +157,60 @@
  #define     SHELL_MAX_NUMBER            5
  #endif /** SHELL_MAX_NUMBER */
  
- #ifndef SHELL_PRINT_BUFFER
+ #ifndef SHELL_USING_CMD_INDEX
+/**
+ * @brief 是否使用命令索引
+ *        shell初始化时对命令表按名称建立有序索引，查找命令时使用二分查找
+ *        索引空间按命令表大小使用`SHELL_MALLOC`分配，分配失败时退回线性查找
+ */
+#define     SHELL_USING_CMD_INDEX       0
+#endif /** SHELL_USING_CMD_INDEX */
+
+#ifndef SHELL_SUPPORT_BATCH
+/**
+ * @brief 是否支持批量执行
+ *        使能后，一行中可以用`;`分隔多条命令，并添加`run`命令执行脚本，
+ *        批量执行时不输出提示符和返回值，每条命令输出一行执行状态，出错时停止
+ */
+#define     SHELL_SUPPORT_BATCH         0
+#endif /** SHELL_SUPPORT_BATCH */
+
+#ifndef SHELL_SCRIPT_BUFFER
+/**
+ * @brief `run`命令脚本缓冲大小
+ *        脚本缓冲使用`SHELL_MALLOC`分配
+ */
+#define     SHELL_SCRIPT_BUFFER         1024
+#endif /** SHELL_SCRIPT_BUFFER */
+
+#ifndef SHELL_USING_RPC
+/**
+ * @brief 是否使用二进制rpc模式
+ *        使能后命令表中添加`rpc`命令，需要将`extension/rpc/shell_rpc.c`加入编译
+ */
+#define     SHELL_USING_RPC             0
+#endif /** SHELL_USING_RPC */
+
+#ifndef SHELL_USING_WATCH
+/**
+ * @brief 是否使用watch命令
+ *        使能后命令表中添加`watch`命令，周期执行命令或读取变量，需要使能
+ *        `SHELL_ASYNC_EXEC`并将`extension/watch/shell_watch.c`加入编译
+ */
+#define     SHELL_USING_WATCH           0
+#endif /** SHELL_USING_WATCH */
+
+#ifndef SHELL_ASYNC_EXEC
+/**
+ * @brief 是否使用异步命令执行
+ *        使能后，若设置了shell派发函数`dispatch`，命令由派发函数交给工作任务执行，
+ *        工作任务调用`shellExecAsync()`运行命令，输入任务可继续读取输入并通过
+ *        `shellCancel()`取消正在执行的命令
+ */
+#define     SHELL_ASYNC_EXEC            0
+#endif /** SHELL_ASYNC_EXEC */
+
+#ifndef SHELL_PRINT_BUFFER
  /**
   * @brief shell格式化输出的缓冲大小
   *        为0时不使用shell格式化输出
@@ -165,7 +218,27 @@
  #define     SHELL_PRINT_BUFFER          128
  #endif /** SHELL_PRINT_BUFFER */
  
- #ifndef SHELL_SCAN_BUFFER
+ #ifndef SHELL_WRITE_BUFFER
+/**
+ * @brief shell输出缓冲大小
+ *        使能后shell的输出先写入缓冲，在输入处理完成(命令执行结束)、缓冲满
+ *        或调用`shellFlush()`时统一调用写函数输出，减少写函数调用次数
+ *        为0时不使用输出缓冲
+ */
+#define     SHELL_WRITE_BUFFER          0
+#endif /** SHELL_WRITE_BUFFER */
+
+#ifndef SHELL_WRITE_FLUSH_TIME
+/**
+ * @brief shell输出缓冲数据的最长保留时间(ms)
+ *        缓冲中的数据保留超过此时间后，下一次写入时立即输出，
+ *        使长时间运行的命令(run脚本，异步命令等)及时显示进度
+ *        需要定义`SHELL_GET_TICK()`，为0时不按时间输出
+ */
+#define     SHELL_WRITE_FLUSH_TIME      50
+#endif /** SHELL_WRITE_FLUSH_TIME */
+
+#ifndef SHELL_SCAN_BUFFER
  /**
   * @brief shell格式化输入的缓冲大小
   *        为0时不使用shell格式化输入
@@ -174,6 +247,16 @@
  #define     SHELL_SCAN_BUFFER          0
  #endif /** SHELL_SCAN_BUFFER */
  
+ #ifndef SHELL_GET_THREAD
+/**
+ * @brief 获取当前任务标识
+ *        多个shell在不同任务中同时执行命令时，`shellGetCurrent()`按执行命令的任务
+ *        区分当前shell，定义为如`xTaskGetCurrentTaskHandle()`
+ *        为0时返回第一个正在执行命令的shell
+ */
+#define     SHELL_GET_THREAD()          0
+#endif /** SHELL_GET_THREAD */
+
  #ifndef SHELL_GET_TICK
  /**
   * @brief 获取系统时间(ms)
@@ -10,6 +10,7 @@
  */
 
 #include "shell.h"
+#include "log.h"
 
 #if SHELL_USING_CMD_EXPORT != 1
 
@@ -28,9 +29,22 @@ extern void shellCmds(void);
 extern void shellVars(void);
 extern void shellKeys(void);
 extern void shellClear(void);
+extern int shellWrites(void);
 #if SHELL_EXEC_UNDEF_FUNC == 1
 extern int shellExecute(int argc, char *argv[]);
 #endif
+#if SHELL_SUPPORT_BATCH == 1
+extern int shellRunScript(int argc, char *argv[]);
+#endif
+#if SHELL_USING_RPC == 1
+extern int shellRpcCmd(int argc, char *argv[]);
+#endif
+#if SHELL_USING_WATCH == 1
+extern int shellWatchCmd(int argc, char *argv[]);
+#endif
+#if LOG_USING_LIMIT == 1
+extern unsigned int logGetDropped(void);
+#endif
 
 SHELL_AGENCY_FUNC(shellRun, shellGetCurrent(), (const char *)p1);
 
@@ -84,8 +98,26 @@ const ShellCommand shellCommandList[] =
                    keys, shellKeys, list all key),
     SHELL_CMD_ITEM(SHELL_CMD_PERMISSION(0)|SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC)|SHELL_CMD_DISABLE_RETURN,
                    clear, shellClear, clear console),
+    SHELL_CMD_ITEM(SHELL_CMD_PERMISSION(0)|SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC),
+                   writes, shellWrites, show write count),
     SHELL_CMD_ITEM(SHELL_CMD_PERMISSION(0)|SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC)|SHELL_CMD_DISABLE_RETURN,
                    sh, SHELL_AGENCY_FUNC_NAME(shellRun), run command directly),
+#if SHELL_SUPPORT_BATCH == 1
+    SHELL_CMD_ITEM(SHELL_CMD_PERMISSION(0)|SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN)|SHELL_CMD_READ_INPUT,
+                   run, shellRunScript, run script block ended by '.' line),
+#endif
+#if SHELL_USING_RPC == 1
+    SHELL_CMD_ITEM(SHELL_CMD_PERMISSION(0)|SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN)|SHELL_CMD_DISABLE_RETURN|SHELL_CMD_READ_INPUT,
+                   rpc, shellRpcCmd, enter binary rpc mode),
+#endif
+#if SHELL_USING_WATCH == 1
+    SHELL_CMD_ITEM(SHELL_CMD_PERMISSION(0)|SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN)|SHELL_CMD_DISABLE_RETURN,
+                   watch, shellWatchCmd, watch command or var periodically),
+#endif
+#if LOG_USING_LIMIT == 1
+    SHELL_CMD_ITEM(SHELL_CMD_PERMISSION(0)|SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC),
+                   logDropped, logGetDropped, get count of logs dropped by rate limit),
+#endif
 #if SHELL_EXEC_UNDEF_FUNC == 1
     SHELL_CMD_ITEM(SHELL_CMD_PERMISSION(0)|SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN)|SHELL_CMD_DISABLE_RETURN,
                    exec, shellExecute, execute function undefined),
@@ -636,52 +636,20 @@ int shellGetArrayParamSize(void *param)
 
 
 /**
- * @brief 执行命令
+ * @brief 使用已解析的参数调用命令函数
  * 
- * @param shell shell对象
  * @param command 命令
- * @param argc 参数个数
- * @param argv 参数
+ * @param paramNum 参数个数
+ * @param params 参数(数量不小于`SHELL_PARAMETER_MAX_NUMBER`，未使用的参数为0)
  * @return int 返回值
  */
-int shellExtRun(Shell *shell, ShellCommand *command, int argc, char *argv[])
+int shellExtCall(ShellCommand *command, int paramNum, size_t *params)
 {
     int ret = 0;
-    size_t params[SHELL_PARAMETER_MAX_NUMBER] = {0};
-    int paramNum = command->attr.attrs.paramNum > (argc - 1) ? 
-        command->attr.attrs.paramNum : (argc - 1);
-#if SHELL_USING_FUNC_SIGNATURE == 1
-    char type[16];
-    int index = 0;
-    
-    if (command->data.cmd.signature != NULL)
+
+    if (command->attr.attrs.paramNum > paramNum)
     {
-        int except = shellGetParamNumExcept(command->data.cmd.signature);
-        if (except != argc - 1)
-        {
-            shellWriteString(shell, "Parameters number incorrect\r\n");
-            return -1;
-        }
-    }
-#endif
-    for (int i = 0; i < argc - 1; i++)
-    {
-    #if SHELL_USING_FUNC_SIGNATURE == 1
-        if (command->data.cmd.signature != NULL) {
-            index = shellGetNextParamType(command->data.cmd.signature, index, type);
-            if (shellExtParsePara(shell, argv[i + 1], type, &params[i]) != 0)
-            {
-                return -1;
-            }
-        }
-        else
-    #endif /** SHELL_USING_FUNC_SIGNATURE == 1 */
-        {
-            if (shellExtParsePara(shell, argv[i + 1], NULL, &params[i]) != 0)
-            {
-                return -1;
-            }
-        }
+        paramNum = command->attr.attrs.paramNum;
     }
     switch (paramNum)
     {
@@ -831,6 +799,58 @@ int shellExtRun(Shell *shell, ShellCommand *command, int argc, char *argv[])
         ret = -1;
         break;
     }
+
+    return ret;
+}
+
+
+/**
+ * @brief 执行命令
+ * 
+ * @param shell shell对象
+ * @param command 命令
+ * @param argc 参数个数
+ * @param argv 参数
+ * @return int 返回值
+ */
+int shellExtRun(Shell *shell, ShellCommand *command, int argc, char *argv[])
+{
+    int ret = 0;
+    size_t params[SHELL_PARAMETER_MAX_NUMBER] = {0};
+#if SHELL_USING_FUNC_SIGNATURE == 1
+    char type[16];
+    int index = 0;
+    
+    if (command->data.cmd.signature != NULL)
+    {
+        int except = shellGetParamNumExcept(command->data.cmd.signature);
+        if (except != argc - 1)
+        {
+            shellWriteString(shell, "Parameters number incorrect\r\n");
+            return -1;
+        }
+    }
+#endif
+    for (int i = 0; i < argc - 1; i++)
+    {
+    #if SHELL_USING_FUNC_SIGNATURE == 1
+        if (command->data.cmd.signature != NULL) {
+            index = shellGetNextParamType(command->data.cmd.signature, index, type);
+            if (shellExtParsePara(shell, argv[i + 1], type, &params[i]) != 0)
+            {
+                return -1;
+            }
+        }
+        else
+    #endif /** SHELL_USING_FUNC_SIGNATURE == 1 */
+        {
+            if (shellExtParsePara(shell, argv[i + 1], NULL, &params[i]) != 0)
+            {
+                return -1;
+            }
+        }
+    }
+    ret = shellExtCall(command, argc - 1, params);
     
 #if SHELL_USING_FUNC_SIGNATURE == 1
     if (command->data.cmd.signature != NULL) {
@@ -42,6 +42,7 @@ int shellExtCleanerPara(Shell *shell, char *type, size_t param);
 #if SHELL_SUPPORT_ARRAY_PARAM == 1
 int shellGetArrayParamSize(void *param);
 #endif /** SHELL_SUPPORT_ARRAY_PARAM == 1 */
+int shellExtCall(ShellCommand *command, int paramNum, size_t *params);
 int shellExtRun(Shell *shell, ShellCommand *command, int argc, char *argv[]);
 
 #endif
@@ -0,0 +1,300 @@
+/*==============================================================================
+ * Host test of shell input handed to commands that read their own input
+ *
+ * Each case feeds one chunk through shellHandlerBuffer(), the way the shell
+ * thread passes a whole UART read, and checks that a command reading input
+ * (run, rpc) takes the rest of that chunk instead of reading the port again.
+ * The shell lock is counted, rpc must not hold it while blocked on the port.
+ *
+ * Build and run on host:
+ *   gcc -O2 -std=gnu11 -I. -I../src -I../extension/log -I../extension/rpc \
+ *       -DSHELL_CFG_USER='"shell_input_test_cfg.h"' \
+ *       ../src/shell.c ../src/shell_cmd_list.c ../src/shell_ext.c ../src/shell_companion.c \
+ *       ../extension/rpc/shell_rpc.c shell_input_test.c -o shell_input_test
+ *   ./shell_input_test
+ *============================================================================*/
+
+#define _GNU_SOURCE
+
+#include "shell.h"
+#include "shell_rpc.h"
+
+#include "float.h"
+#include "stdio.h"
+#include "string.h"
+
+
+/*==============================================================================
+ * Macro
+ *============================================================================*/
+
+#define D_SHELL_INPUT_TEST_PARSER_BUFFER_SIZE   (512)
+#define D_SHELL_INPUT_TEST_OUTPUT_SIZE          (4096)
+#define D_SHELL_INPUT_TEST_CHUNK_SIZE           (256)
+
+
+/*==============================================================================
+ * Global Variable
+ *============================================================================*/
+
+static Shell gs_test_shell;
+static char gs_test_parser_buf[D_SHELL_INPUT_TEST_PARSER_BUFFER_SIZE];
+static char gs_test_output[D_SHELL_INPUT_TEST_OUTPUT_SIZE];
+static unsigned short gs_test_output_len = 0;
+static unsigned int gs_test_port_read_count = 0;
+static unsigned short gs_test_output_len_at_read = 0;
+static int gs_test_lock_depth = 0;
+static int gs_test_lock_depth_at_read = 0;
+static char gs_test_port_data[D_SHELL_INPUT_TEST_CHUNK_SIZE];
+static unsigned short gs_test_port_data_len = 0;
+static unsigned int gs_test_failed = 0;
+
+
+/*==============================================================================
+ * Private Function Implementation
+ *============================================================================*/
+
+/* The log extension is not linked, the command table still names its counter */
+unsigned int logGetDropped(void)
+{
+    return 0;
+}
+
+static signed short _test_port_read(char* p_data, unsigned short len)
+{
+    /* Everything was in the chunk, a port read means input was lost: end the script */
+    gs_test_port_read_count++;
+    gs_test_output_len_at_read = gs_test_output_len;
+    gs_test_lock_depth_at_read = gs_test_lock_depth;
+    if (0 == len)
+    {
+        return 0;
+    }
+    /* A case may queue the next read, such as the rest of an rpc session */
+    if (0 != gs_test_port_data_len)
+    {
+        if (len > gs_test_port_data_len)
+        {
+            len = gs_test_port_data_len;
+        }
+        memcpy(p_data, gs_test_port_data, len);
+        memmove(gs_test_port_data, gs_test_port_data + len, gs_test_port_data_len - len);
+        gs_test_port_data_len -= len;
+        return len;
+    }
+    p_data[0] = 0x04;
+    return 1;
+}
+
+static signed short _test_port_write(char* p_data, unsigned short len)
+{
+    if (len > D_SHELL_INPUT_TEST_OUTPUT_SIZE - 1 - gs_test_output_len)
+    {
+        len = D_SHELL_INPUT_TEST_OUTPUT_SIZE - 1 - gs_test_output_len;
+    }
+    memcpy(gs_test_output + gs_test_output_len, p_data, len);
+    gs_test_output_len += len;
+    gs_test_output[gs_test_output_len] = 0;
+    return len;
+}
+
+static int _test_lock(Shell* p_shell)
+{
+    (void)p_shell;
+    gs_test_lock_depth++;
+    return 0;
+}
+
+static int _test_unlock(Shell* p_shell)
+{
+    (void)p_shell;
+    gs_test_lock_depth--;
+    return 0;
+}
+
+static void _test_reset(void)
+{
+    gs_test_output_len = 0;
+    gs_test_output[0] = 0;
+    gs_test_port_read_count = 0;
+    gs_test_output_len_at_read = 0;
+    gs_test_lock_depth_at_read = 0;
+}
+
+static void _test_expect(const char* p_case, int condition, const char* p_what)
+{
+    if (!condition)
+    {
+        printf("FAIL %s: %s\n", p_case, p_what);
+        gs_test_failed++;
+    }
+}
+
+static void _test_feed(const char* p_chunk, unsigned short len)
+{
+    _test_reset();
+    unsigned short used = shellHandlerBuffer(&gs_test_shell, p_chunk, len);
+    _test_expect("feed", used == len, "chunk not fully consumed");
+    _test_expect("feed", 0 == gs_test_lock_depth, "shell lock left held");
+}
+
+static unsigned short _test_crc16(unsigned short crc, const unsigned char* p_data, unsigned short len)
+{
+    for (unsigned short i = 0; i < len; i++)
+    {
+        crc ^= (unsigned short)p_data[i] << 8;
+        for (unsigned char bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x8000) ? (unsigned short)( (crc << 1) ^ 0x1021) : (unsigned short)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/* Request frame with encoded arguments (type, length, value each), an empty name is the exit request */
+static unsigned short _test_rpc_frame_build(char* p_frame, unsigned char seq, const char* p_name,
+                                            unsigned char argc, const void* p_args, unsigned char args_len)
+{
+    unsigned char name_len = (unsigned char)strlen(p_name);
+    unsigned short length = 3 + name_len + args_len;
+    unsigned char* p = (unsigned char*)p_frame;
+
+    p[0] = SHELL_RPC_SOF;
+    p[1] = length & 0xFF;
+    p[2] = (length >> 8) & 0xFF;
+    p[3] = seq;
+    p[4] = name_len;
+    memcpy(p + 5, p_name, name_len);
+    p[5 + name_len] = argc;
+    memcpy(p + 6 + name_len, p_args, args_len);
+
+    unsigned short crc = _test_crc16(0xFFFF, p + 1, length + 2);
+    p[3 + length] = crc & 0xFF;
+    p[4 + length] = (crc >> 8) & 0xFF;
+    return 5 + length;
+}
+
+/* Response frame with the given sequence and status somewhere in the output */
+static int _test_rpc_response_find(unsigned char seq, unsigned char status)
+{
+    for (unsigned short i = 0; i + 4 < gs_test_output_len; i++)
+    {
+        if (SHELL_RPC_SOF == (unsigned char)gs_test_output[i]
+            && seq == (unsigned char)gs_test_output[i + 3]
+            && status == (unsigned char)gs_test_output[i + 4])
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void _test_run_single_write(void)
+{
+    static const char chunk[] = "run\r\nwrites\r\nusers\r\n.\r\n";
+
+    _test_feed(chunk, sizeof(chunk) - 1);
+    _test_expect("run", 0 == gs_test_port_read_count, "script read from the port");
+    _test_expect("run", NULL != strstr(gs_test_output, "[1] writes"), "first script line not run");
+    _test_expect("run", NULL != strstr(gs_test_output, "[2] users"), "second script line not run");
+    /* Script input is not echoed, an echo means the line ran interactively */
+    _test_expect("run", NULL == strstr(gs_test_output, "writes\r\n"), "script line ran as shell input");
+}
+
+static void _test_run_then_command(void)
+{
+    static const char chunk[] = "run\r\nwrites\r\n.\r\nusers\r\n";
+
+    _test_feed(chunk, sizeof(chunk) - 1);
+    _test_expect("run+cmd", 0 == gs_test_port_read_count, "script read from the port");
+    _test_expect("run+cmd", NULL != strstr(gs_test_output, "[1] writes"), "script line not run");
+    _test_expect("run+cmd", NULL == strstr(gs_test_output, "[2] users"), "command after script ran in it");
+    /* The line after the script is shell input again and is echoed */
+    _test_expect("run+cmd", NULL != strstr(gs_test_output, "users\r\n"), "command after script lost");
+}
+
+static void _test_run_split_write(void)
+{
+    static const char chunk[] = "run\r\nwrites\r\n";
+
+    /* The script goes on in the next read, the port reader ends it with 0x04 */
+    _test_feed(chunk, sizeof(chunk) - 1);
+    _test_expect("run split", 1 == gs_test_port_read_count, "port not read after the chunk");
+    /* The echo of the run line is out before the shell blocks on the port */
+    _test_expect("run split", 5 <= gs_test_output_len_at_read, "output held back while blocked on read");
+    _test_expect("run split", NULL != strstr(gs_test_output, "[1] writes"), "script line not run");
+}
+
+
+static void _test_rpc_single_write(void)
+{
+    char chunk[D_SHELL_INPUT_TEST_CHUNK_SIZE];
+    unsigned short len = 0;
+
+    memcpy(chunk, "rpc\r\n", 5);
+    len += 5;
+    len += _test_rpc_frame_build(chunk + len, 1, "writes", 0, NULL, 0);
+    len += _test_rpc_frame_build(chunk + len, 2, "", 0, NULL, 0);
+    memcpy(chunk + len, "users\r\n", 7);
+    len += 7;
+
+    _test_feed(chunk, len);
+    _test_expect("rpc", 0 == gs_test_port_read_count, "request read from the port");
+    _test_expect("rpc", _test_rpc_response_find(1, SHELL_RPC_STATUS_OK), "request not answered");
+    _test_expect("rpc", _test_rpc_response_find(2, SHELL_RPC_STATUS_OK), "exit request not answered");
+    /* The line after the exit request is shell input again and is echoed */
+    _test_expect("rpc", NULL != memmem(gs_test_output, gs_test_output_len, "users\r\n", 7), "command after rpc lost");
+}
+
+static void _test_rpc_split_write(void)
+{
+    char chunk[D_SHELL_INPUT_TEST_CHUNK_SIZE];
+    unsigned short len = 0;
+    unsigned char args[2 + sizeof(float)] = {SHELL_RPC_TYPE_FLOAT, sizeof(float)};
+    float value = FLT_MAX;
+
+    /* The largest float prints 46 digits with %f, more than a number argument holds */
+    memcpy(args + 2, &value, sizeof(float));
+    memcpy(chunk, "rpc\r\n", 5);
+    len += 5;
+    len += _test_rpc_frame_build(chunk + len, 1, "help", 1, args, sizeof(args));
+
+    /* The exit request comes in the next read */
+    gs_test_port_data_len = _test_rpc_frame_build(gs_test_port_data, 2, "", 0, NULL, 0);
+
+    _test_feed(chunk, len);
+    _test_expect("rpc split", 1 == gs_test_port_read_count, "port not read after the chunk");
+    _test_expect("rpc split", 0 == gs_test_port_data_len, "exit request not read");
+    /* Log output may go out while the host is quiet, the lock is free while blocked on the port */
+    _test_expect("rpc split", 0 == gs_test_lock_depth_at_read, "shell lock held while blocked on read");
+    _test_expect("rpc split", _test_rpc_response_find(1, SHELL_RPC_STATUS_OK), "float request not answered");
+    _test_expect("rpc split", _test_rpc_response_find(2, SHELL_RPC_STATUS_OK), "exit request not answered");
+}
+
+
+/*==============================================================================
+ * Main
+ *============================================================================*/
+
+int main(void)
+{
+    gs_test_shell.read = _test_port_read;
+    gs_test_shell.write = _test_port_write;
+    gs_test_shell.lock = _test_lock;
+    gs_test_shell.unlock = _test_unlock;
+    shellInit(&gs_test_shell, gs_test_parser_buf, D_SHELL_INPUT_TEST_PARSER_BUFFER_SIZE);
+
+    _test_run_single_write();
+    _test_run_then_command();
+    _test_run_split_write();
+    _test_rpc_single_write();
+    _test_rpc_split_write();
+
+    if (0 != gs_test_failed)
+    {
+        printf("%u check(s) failed\n", gs_test_failed);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
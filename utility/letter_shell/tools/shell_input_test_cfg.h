@@ -0,0 +1,28 @@
+#ifndef __SHELL_INPUT_TEST_CFG_H
+#define __SHELL_INPUT_TEST_CFG_H
+
+
+#include "stdlib.h"
+
+
+/**
+ * @brief 主机测试配置
+ *        与`shell_cfg_user.h`相同的功能集，去掉依赖操作系统的异步执行和watch，锁由测试计数
+ */
+#define     SHELL_TASK_WHILE            0
+#define     SHELL_USING_CMD_EXPORT      0
+#define     SHELL_USING_COMPANION       1
+#define     SHELL_SUPPORT_END_LINE      1
+#define     SHELL_USING_CMD_INDEX       1
+#define     SHELL_WRITE_BUFFER          256
+#define     SHELL_SUPPORT_BATCH         1
+#define     SHELL_USING_RPC             1
+#define     SHELL_ASYNC_EXEC            0
+#define     SHELL_USING_WATCH           0
+#define     SHELL_USING_LOCK            1
+#define     SHELL_CLS_WHEN_LOGIN        0
+#define     SHELL_MALLOC(size)          malloc(size)
+#define     SHELL_FREE(obj)             free(obj)
+
+
+#endif
@@ -0,0 +1,232 @@
+/*==============================================================================
+ * Host benchmark of shellSeekCommand with and without the sorted command index
+ *
+ * Looks up every command of a table plus a few names that miss, once through
+ * the name-sorted index and once through the linear scan over a copy of the
+ * same table. Two tables are measured: the real one (shell_cmd_list.c with the
+ * port feature set) and a synthetic one of several hundred commands in random
+ * name order, the size the index is meant for.
+ *
+ * Build and run on host:
+ *   gcc -O2 -std=gnu11 -I. -I../src -I../extension/log -I../extension/rpc \
+ *       -DSHELL_CFG_USER='"shell_input_test_cfg.h"' \
+ *       ../src/shell.c ../src/shell_cmd_list.c ../src/shell_ext.c ../src/shell_companion.c \
+ *       ../extension/rpc/shell_rpc.c shell_seek_bench.c -o shell_seek_bench
+ *   ./shell_seek_bench [rounds] [synthetic command number]
+ *============================================================================*/
+
+#include "shell.h"
+
+#include "stdint.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time.h"
+
+
+/*==============================================================================
+ * Macro
+ *============================================================================*/
+
+#define D_SHELL_SEEK_BENCH_ROUNDS               (200000)
+#define D_SHELL_SEEK_BENCH_SYNTHETIC_NUM        (500)
+#define D_SHELL_SEEK_BENCH_NAME_SIZE            (12)
+#define D_SHELL_SEEK_BENCH_PARSER_BUFFER_SIZE   (128)
+
+
+/*==============================================================================
+ * Global Variable
+ *============================================================================*/
+
+extern ShellCommand* shellSeekCommand(Shell *shell,
+                                      const char *cmd,
+                                      ShellCommand *base,
+                                      unsigned short compareLength);
+
+static Shell gs_bench_index_shell;
+static Shell gs_bench_linear_shell;
+static char gs_bench_parser_buf[D_SHELL_SEEK_BENCH_PARSER_BUFFER_SIZE];
+static const char** gs_bench_names = NULL;
+static unsigned short gs_bench_name_num = 0;
+/* Typos and unknown commands, each one costs the linear scan the whole table */
+static const char* const gs_bench_miss_names[] = {"hepl", "ledstats", "reboot", "zz"};
+static volatile size_t gs_bench_sink = 0;
+
+
+/*==============================================================================
+ * Private Function Implementation
+ *============================================================================*/
+
+/* The log extension is not linked, the command table still names its counter */
+unsigned int logGetDropped(void)
+{
+    return 0;
+}
+
+static int _bench_command(void)
+{
+    return 0;
+}
+
+static signed short _bench_write(char* p_data, unsigned short len)
+{
+    (void)p_data;
+    return len;
+}
+
+static double _bench_seconds_get(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static const char* _bench_command_name_get(ShellCommand* p_command)
+{
+    if (SHELL_TYPE_USER == p_command->attr.attrs.type)
+    {
+        return p_command->data.user.name;
+    }
+    if (p_command->attr.attrs.type >= SHELL_TYPE_VAR_INT && p_command->attr.attrs.type <= SHELL_TYPE_VAR_NODE)
+    {
+        return p_command->data.var.name;
+    }
+    return p_command->data.cmd.name;
+}
+
+static double _bench_run(Shell* p_shell, uint32_t rounds)
+{
+    double start = _bench_seconds_get();
+
+    for (uint32_t round = 0; round < rounds; round++)
+    {
+        for (unsigned short i = 0; i < gs_bench_name_num; i++)
+        {
+            gs_bench_sink += (size_t)shellSeekCommand(p_shell, gs_bench_names[i], p_shell->commandList.base, 0);
+        }
+    }
+
+    return _bench_seconds_get() - start;
+}
+
+/* Default user first as in the real table, then commands "c<n>" in a fixed pseudo-random order */
+static ShellCommand* _bench_synthetic_table_create(unsigned short num, char** pp_name_pool)
+{
+    ShellCommand* p_table = calloc(num + 1, sizeof(ShellCommand));
+    char* p_pool = malloc( (size_t)num * D_SHELL_SEEK_BENCH_NAME_SIZE);
+    uint32_t seed = 12345;
+
+    p_table[0] = ( (ShellCommand*)gs_bench_index_shell.commandList.base)[0];
+    for (unsigned short i = 0; i < num; i++)
+    {
+        char* p_name = p_pool + (size_t)i * D_SHELL_SEEK_BENCH_NAME_SIZE;
+        snprintf(p_name, D_SHELL_SEEK_BENCH_NAME_SIZE, "c%u", (unsigned)i);
+        p_table[i + 1].attr.value = SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC);
+        p_table[i + 1].data.cmd.name = p_name;
+        p_table[i + 1].data.cmd.function = (int (*)())_bench_command;
+        p_table[i + 1].data.cmd.desc = "bench";
+    }
+    for (unsigned short i = num; i > 1; i--)
+    {
+        seed = seed * 1103515245u + 12345u;
+        unsigned short j = 1 + (unsigned short)( (seed >> 8) % i);
+        ShellCommand tmp = p_table[i];
+        p_table[i] = p_table[j];
+        p_table[j] = tmp;
+    }
+
+    *pp_name_pool = p_pool;
+    return p_table;
+}
+
+/* Index the table through the index shell, copy it for the linear one, then time both */
+static int _bench_table(const char* p_title, const ShellCommand* p_table, unsigned short count, uint32_t rounds)
+{
+    unsigned short key_num = 0;
+    unsigned short mismatch_num = 0;
+    unsigned short miss_num = sizeof(gs_bench_miss_names) / sizeof(gs_bench_miss_names[0]);
+
+    shellSetCommandList(&gs_bench_index_shell, p_table, count);
+
+    /* Same table at another address, lookups fall back to the linear scan */
+    size_t table_size = count * sizeof(ShellCommand);
+    gs_bench_linear_shell = gs_bench_index_shell;
+    gs_bench_linear_shell.commandList.base = malloc(table_size);
+    memcpy(gs_bench_linear_shell.commandList.base, p_table, table_size);
+
+    gs_bench_names = malloc( (count + miss_num) * sizeof(const char*) );
+    gs_bench_name_num = 0;
+    for (unsigned short i = 0; i < count; i++)
+    {
+        ShellCommand* p_command = (ShellCommand*)&p_table[i];
+        if (SHELL_TYPE_KEY == p_command->attr.attrs.type)
+        {
+            key_num++;
+            continue;
+        }
+        gs_bench_names[gs_bench_name_num++] = _bench_command_name_get(p_command);
+    }
+    for (unsigned short i = 0; i < miss_num; i++)
+    {
+        gs_bench_names[gs_bench_name_num++] = gs_bench_miss_names[i];
+    }
+
+    /* Both paths have to resolve every name to the same table entry */
+    for (unsigned short i = 0; i < gs_bench_name_num; i++)
+    {
+        ShellCommand* p_index = shellSeekCommand(&gs_bench_index_shell, gs_bench_names[i],
+                                                 gs_bench_index_shell.commandList.base, 0);
+        ShellCommand* p_linear = shellSeekCommand(&gs_bench_linear_shell, gs_bench_names[i],
+                                                  gs_bench_linear_shell.commandList.base, 0);
+        size_t index_offset = (NULL == p_index) ? 0 : (size_t)(p_index - (ShellCommand*)gs_bench_index_shell.commandList.base) + 1;
+        size_t linear_offset = (NULL == p_linear) ? 0 : (size_t)(p_linear - (ShellCommand*)gs_bench_linear_shell.commandList.base) + 1;
+        if (index_offset != linear_offset)
+        {
+            printf("MISMATCH: %s\n", gs_bench_names[i]);
+            mismatch_num++;
+        }
+    }
+
+    double linear_seconds = _bench_run(&gs_bench_linear_shell, rounds);
+    double index_seconds = _bench_run(&gs_bench_index_shell, rounds);
+    double lookups = (double)rounds * gs_bench_name_num;
+
+    printf("%s: %u table entries (%u keys), %u names (%u misses), %lu rounds\n",
+           p_title, count, key_num, gs_bench_name_num, miss_num, (unsigned long)rounds);
+    printf("  linear scan:  %8.3f s, %7.1f ns per lookup\n", linear_seconds, linear_seconds * 1e9 / lookups);
+    printf("  sorted index: %8.3f s, %7.1f ns per lookup\n", index_seconds, index_seconds * 1e9 / lookups);
+
+    free(gs_bench_names);
+    free(gs_bench_linear_shell.commandList.base);
+    return mismatch_num;
+}
+
+
+/*==============================================================================
+ * Main
+ *============================================================================*/
+
+int main(int argc, char* argv[])
+{
+    uint32_t rounds = (1 < argc) ? (uint32_t)strtoul(argv[1], NULL, 0) : D_SHELL_SEEK_BENCH_ROUNDS;
+    unsigned short synthetic_num = (2 < argc) ? (unsigned short)strtoul(argv[2], NULL, 0) : D_SHELL_SEEK_BENCH_SYNTHETIC_NUM;
+    int mismatch_num = 0;
+    char* p_name_pool = NULL;
+
+    /* The index is built for the table a shell is initialized with */
+    gs_bench_index_shell.write = _bench_write;
+    shellInit(&gs_bench_index_shell, gs_bench_parser_buf, D_SHELL_SEEK_BENCH_PARSER_BUFFER_SIZE);
+
+    mismatch_num += _bench_table("real table", gs_bench_index_shell.commandList.base,
+                                 gs_bench_index_shell.commandList.count, rounds);
+
+    /* Rounds scaled down so both tables take about as long */
+    ShellCommand* p_synthetic = _bench_synthetic_table_create(synthetic_num, &p_name_pool);
+    uint32_t synthetic_rounds = (uint32_t)( (uint64_t)rounds * gs_bench_index_shell.commandList.count / (synthetic_num + 1) );
+    mismatch_num += _bench_table("synthetic table", p_synthetic, synthetic_num + 1,
+                                 (0 == synthetic_rounds) ? 1 : synthetic_rounds);
+
+    free(p_synthetic);
+    free(p_name_pool);
+    return (0 == mismatch_num) ? 0 : 1;
+}
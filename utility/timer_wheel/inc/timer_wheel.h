@@ -0,0 +1,100 @@
+#ifndef __TIMER_WHEEL_H__
+#define __TIMER_WHEEL_H__
+
+
+/*==============================================================================
+ * Include
+ *============================================================================*/
+
+#include "stdbool.h"
+#include "stdint.h"
+
+
+/*==============================================================================
+ * Macro
+ *============================================================================*/
+
+/* Levels of the wheel and slots of each level, level n holds timeouts below SLOT_NUM^(n+1) ticks */
+#define D_TIMER_WHEEL_LEVEL_NUM                 (4)
+#define D_TIMER_WHEEL_SLOT_BITS                 (6)
+#define D_TIMER_WHEEL_SLOT_NUM                  (1UL << D_TIMER_WHEEL_SLOT_BITS)
+
+/* Longest timeout, 2^24 - 1 ticks (about 4.6 hours with 1 ms ticks) */
+#define D_TIMER_WHEEL_TIMEOUT_MAX               ( (1UL << (D_TIMER_WHEEL_LEVEL_NUM * D_TIMER_WHEEL_SLOT_BITS) ) - 1UL)
+
+
+/*==============================================================================
+ * Enumeration
+ *============================================================================*/
+
+typedef enum
+{
+    E_TIMER_WHEEL_RET_STATUS_OK = 0,
+    E_TIMER_WHEEL_RET_STATUS_INPUT_PARAM_ERROR,
+    E_TIMER_WHEEL_RET_STATUS_INIT_STATUS_ERROR,
+    E_TIMER_WHEEL_RET_STATUS_NO_TIMER,
+} E_TIMER_WHEEL_RET_STATUS_T;
+
+typedef enum
+{
+    E_TIMER_WHEEL_INIT_STATUS_NO = 0,
+    E_TIMER_WHEEL_INIT_STATUS_OK,
+} E_TIMER_WHEEL_INIT_STATUS_T;
+
+
+/*==============================================================================
+ * Type
+ *============================================================================*/
+
+typedef void (*PF_TIMER_WHEEL_CALLBACK_T)(void* const);
+
+
+/*==============================================================================
+ * Struct
+ *============================================================================*/
+
+/**
+ * @brief Link of a circular doubly linked list, a slot is the head of one
+ */
+typedef struct S_TIMER_WHEEL_NODE
+{
+    struct S_TIMER_WHEEL_NODE* p_prev;
+    struct S_TIMER_WHEEL_NODE* p_next;
+} S_TIMER_WHEEL_NODE_T;
+
+/**
+ * @brief Timer owned by the user, the wheel only links it, so arming and cancelling never allocate
+ */
+typedef struct
+{
+    S_TIMER_WHEEL_NODE_T        node;           /* Unlinked (NULL) when not armed */
+    uint32_t                    expire;         /* Tick it expires at */
+    PF_TIMER_WHEEL_CALLBACK_T   pf_callback;
+    void*                       p_arg;
+} S_TIMER_WHEEL_TIMER_T;
+
+/**
+ * @brief Wheel, not thread safe, the thread calling advance owns it
+ */
+typedef struct
+{
+    E_TIMER_WHEEL_INIT_STATUS_T is_inited;
+    uint32_t                    now;            /* Last processed tick */
+    uint32_t                    timer_num;      /* Armed timers */
+    S_TIMER_WHEEL_NODE_T        slot[D_TIMER_WHEEL_LEVEL_NUM][D_TIMER_WHEEL_SLOT_NUM];
+} S_TIMER_WHEEL_T;
+
+
+/*==============================================================================
+ * Public Function Declaration
+ *============================================================================*/
+
+extern E_TIMER_WHEEL_RET_STATUS_T timer_wheel_init(S_TIMER_WHEEL_T* const, const uint32_t);
+extern E_TIMER_WHEEL_RET_STATUS_T timer_wheel_timer_init(S_TIMER_WHEEL_TIMER_T* const, const PF_TIMER_WHEEL_CALLBACK_T, void* const);
+extern E_TIMER_WHEEL_RET_STATUS_T timer_wheel_timer_start(S_TIMER_WHEEL_T* const, S_TIMER_WHEEL_TIMER_T* const, const uint32_t);
+extern E_TIMER_WHEEL_RET_STATUS_T timer_wheel_timer_stop(S_TIMER_WHEEL_T* const, S_TIMER_WHEEL_TIMER_T* const);
+extern bool timer_wheel_timer_is_active(const S_TIMER_WHEEL_TIMER_T* const);
+extern E_TIMER_WHEEL_RET_STATUS_T timer_wheel_advance(S_TIMER_WHEEL_T* const, const uint32_t);
+extern E_TIMER_WHEEL_RET_STATUS_T timer_wheel_next_get(const S_TIMER_WHEEL_T* const, uint32_t* const);
+
+#endif /* __TIMER_WHEEL_H__ */
@@ -0,0 +1,360 @@
+/*==============================================================================
+ * Include
+ *============================================================================*/
+
+#include "timer_wheel.h"
+
+#include "stddef.h"
+
+
+/*==============================================================================
+ * Macro
+ *============================================================================*/
+
+#define D_TIMER_WHEEL_SLOT_MASK                 (D_TIMER_WHEEL_SLOT_NUM - 1UL)
+
+/* Slot of a tick in a level */
+#define D_TIMER_WHEEL_INDEX(tick, level)        ( ( (tick) >> ( (level) * D_TIMER_WHEEL_SLOT_BITS) ) & D_TIMER_WHEEL_SLOT_MASK)
+
+
+/*==============================================================================
+ * Private Function Declaration
+ *============================================================================*/
+
+static void _timer_wheel_list_init(S_TIMER_WHEEL_NODE_T* const);
+static void _timer_wheel_list_add_tail(S_TIMER_WHEEL_NODE_T* const, S_TIMER_WHEEL_NODE_T* const);
+static void _timer_wheel_list_del(S_TIMER_WHEEL_NODE_T* const);
+static void _timer_wheel_list_splice(S_TIMER_WHEEL_NODE_T* const, S_TIMER_WHEEL_NODE_T* const);
+static void _timer_wheel_insert(S_TIMER_WHEEL_T* const, S_TIMER_WHEEL_TIMER_T* const);
+static void _timer_wheel_cascade(S_TIMER_WHEEL_T* const, const uint32_t);
+static void _timer_wheel_tick_process(S_TIMER_WHEEL_T* const);
+
+
+/*==============================================================================
+ * Public Function Implementation
+ *============================================================================*/
+
+/**
+ * @brief   Initialize a wheel
+ * @param   p_wheel Wheel
+ * @param   now Current tick, timeouts count from it
+ * @return  E_TIMER_WHEEL_RET_STATUS_T
+ */
+extern E_TIMER_WHEEL_RET_STATUS_T timer_wheel_init(S_TIMER_WHEEL_T* const p_wheel, const uint32_t now)
+{
+    /* Check input parameter */
+    if (NULL == p_wheel)
+    {
+        return E_TIMER_WHEEL_RET_STATUS_INPUT_PARAM_ERROR;
+    }
+
+    for (uint32_t level = 0; level < D_TIMER_WHEEL_LEVEL_NUM; level++)
+    {
+        for (uint32_t index = 0; index < D_TIMER_WHEEL_SLOT_NUM; index++)
+        {
+            _timer_wheel_list_init(&p_wheel->slot[level][index]);
+        }
+    }
+
+    p_wheel->now = now;
+    p_wheel->timer_num = 0;
+    p_wheel->is_inited = E_TIMER_WHEEL_INIT_STATUS_OK;
+
+    return E_TIMER_WHEEL_RET_STATUS_OK;
+}
+
+/**
+ * @brief   Initialize a timer, it is not armed
+ * @param   p_timer Timer
+ * @param   pf_callback Called from timer_wheel_advance() when it expires, it may start or stop any timer
+ * @param   p_arg Argument of the callback
+ * @return  E_TIMER_WHEEL_RET_STATUS_T
+ */
+extern E_TIMER_WHEEL_RET_STATUS_T timer_wheel_timer_init(S_TIMER_WHEEL_TIMER_T* const p_timer, const PF_TIMER_WHEEL_CALLBACK_T pf_callback, void* const p_arg)
+{
+    /* Check input parameter */
+    if (NULL == p_timer || NULL == pf_callback)
+    {
+        return E_TIMER_WHEEL_RET_STATUS_INPUT_PARAM_ERROR;
+    }
+
+    p_timer->node.p_prev = NULL;
+    p_timer->node.p_next = NULL;
+    p_timer->expire = 0;
+    p_timer->pf_callback = pf_callback;
+    p_timer->p_arg = p_arg;
+
+    return E_TIMER_WHEEL_RET_STATUS_OK;
+}
+
+/**
+ * @brief   Arm a timer, an armed one is re-armed, O(1)
+ * @param   p_wheel Wheel
+ * @param   p_timer Timer
+ * @param   timeout Ticks from the last processed tick, 0 is taken as 1
+ * @return  E_TIMER_WHEEL_RET_STATUS_INPUT_PARAM_ERROR if timeout is above D_TIMER_WHEEL_TIMEOUT_MAX
+ */
+extern E_TIMER_WHEEL_RET_STATUS_T timer_wheel_timer_start(S_TIMER_WHEEL_T* const p_wheel, S_TIMER_WHEEL_TIMER_T* const p_timer, const uint32_t timeout)
+{
+    /* Check input parameter */
+    if (NULL == p_wheel || NULL == p_timer || D_TIMER_WHEEL_TIMEOUT_MAX < timeout)
+    {
+        return E_TIMER_WHEEL_RET_STATUS_INPUT_PARAM_ERROR;
+    }
+
+    if (E_TIMER_WHEEL_INIT_STATUS_OK != p_wheel->is_inited)
+    {
+        return E_TIMER_WHEEL_RET_STATUS_INIT_STATUS_ERROR;
+    }
+
+    if (true == timer_wheel_timer_is_active(p_timer) )
+    {
+        _timer_wheel_list_del(&p_timer->node);
+        p_wheel->timer_num--;
+    }
+
+    p_timer->expire = p_wheel->now + ( (0 == timeout) ? 1 : timeout);
+    _timer_wheel_insert(p_wheel, p_timer);
+    p_wheel->timer_num++;
+
+    return E_TIMER_WHEEL_RET_STATUS_OK;
+}
+
+/**
+ * @brief   Disarm a timer, O(1), stopping a timer that is not armed does nothing
+ * @param   p_wheel Wheel
+ * @param   p_timer Timer
+ * @return  E_TIMER_WHEEL_RET_STATUS_T
+ */
+extern E_TIMER_WHEEL_RET_STATUS_T timer_wheel_timer_stop(S_TIMER_WHEEL_T* const p_wheel, S_TIMER_WHEEL_TIMER_T* const p_timer)
+{
+    /* Check input parameter */
+    if (NULL == p_wheel || NULL == p_timer)
+    {
+        return E_TIMER_WHEEL_RET_STATUS_INPUT_PARAM_ERROR;
+    }
+
+    if (true == timer_wheel_timer_is_active(p_timer) )
+    {
+        _timer_wheel_list_del(&p_timer->node);
+        p_wheel->timer_num--;
+    }
+
+    return E_TIMER_WHEEL_RET_STATUS_OK;
+}
+
+/**
+ * @brief   Check whether a timer is armed
+ * @param   p_timer Timer
+ * @return  true if armed
+ */
+extern bool timer_wheel_timer_is_active(const S_TIMER_WHEEL_TIMER_T* const p_timer)
+{
+    return (NULL != p_timer && NULL != p_timer->node.p_next);
+}
+
+/**
+ * @brief   Process every tick up to now and call the callbacks of the expired timers
+ *          Each tick costs one slot plus a cascade every SLOT_NUM ticks, whatever the number of timers.
+ *          An idle wheel jumps straight to now.
+ * @param   p_wheel Wheel
+ * @param   now Current tick
+ * @return  E_TIMER_WHEEL_RET_STATUS_T
+ */
+extern E_TIMER_WHEEL_RET_STATUS_T timer_wheel_advance(S_TIMER_WHEEL_T* const p_wheel, const uint32_t now)
+{
+    /* Check input parameter */
+    if (NULL == p_wheel)
+    {
+        return E_TIMER_WHEEL_RET_STATUS_INPUT_PARAM_ERROR;
+    }
+
+    if (E_TIMER_WHEEL_INIT_STATUS_OK != p_wheel->is_inited)
+    {
+        return E_TIMER_WHEEL_RET_STATUS_INIT_STATUS_ERROR;
+    }
+
+    /* A tick older than the last processed one is ignored */
+    while (0 < (int32_t)(now - p_wheel->now) )
+    {
+        if (0 == p_wheel->timer_num)
+        {
+            p_wheel->now = now;
+            break;
+        }
+
+        p_wheel->now++;
+        _timer_wheel_tick_process(p_wheel);
+    }
+
+    return E_TIMER_WHEEL_RET_STATUS_OK;
+}
+
+/**
+ * @brief   Get how many ticks the owner may sleep before calling timer_wheel_advance() again
+ *          Timers in upper levels count at the tick they are cascaded, so it may be earlier than
+ *          the first expiry but never later
+ * @param   p_wheel Wheel
+ * @param   p_ticks [out] Ticks from the last processed tick
+ * @return  E_TIMER_WHEEL_RET_STATUS_NO_TIMER if no timer is armed
+ */
+extern E_TIMER_WHEEL_RET_STATUS_T timer_wheel_next_get(const S_TIMER_WHEEL_T* const p_wheel, uint32_t* const p_ticks)
+{
+    /* Check input parameter */
+    if (NULL == p_wheel || NULL == p_ticks)
+    {
+        return E_TIMER_WHEEL_RET_STATUS_INPUT_PARAM_ERROR;
+    }
+
+    if (E_TIMER_WHEEL_INIT_STATUS_OK != p_wheel->is_inited)
+    {
+        return E_TIMER_WHEEL_RET_STATUS_INIT_STATUS_ERROR;
+    }
+
+    if (0 == p_wheel->timer_num)
+    {
+        return E_TIMER_WHEEL_RET_STATUS_NO_TIMER;
+    }
+
+    uint32_t ticks = D_TIMER_WHEEL_TIMEOUT_MAX;
+
+    for (uint32_t level = 0; level < D_TIMER_WHEEL_LEVEL_NUM; level++)
+    {
+        /* Slots of this level are visited every span ticks, the first visit after now is at base */
+        const uint32_t span = 1UL << (level * D_TIMER_WHEEL_SLOT_BITS);
+        const uint32_t base = (0 == level) ? (p_wheel->now + 1) : ( (p_wheel->now | (span - 1) ) + 1);
+        const uint32_t base_index = D_TIMER_WHEEL_INDEX(base, level);
+
+        for (uint32_t i = 0; i < D_TIMER_WHEEL_SLOT_NUM; i++)
+        {
+            const S_TIMER_WHEEL_NODE_T* p_slot = &p_wheel->slot[level][(base_index + i) & D_TIMER_WHEEL_SLOT_MASK];
+            if (p_slot->p_next != p_slot)
+            {
+                uint32_t candidate = base + i * span - p_wheel->now;
+                if (candidate < ticks)
+                {
+                    ticks = candidate;
+                }
+                break;
+            }
+        }
+    }
+
+    *p_ticks = ticks;
+
+    return E_TIMER_WHEEL_RET_STATUS_OK;
+}
+
+
+/*==============================================================================
+ * Private Function Implementation
+ *============================================================================*/
+
+static void _timer_wheel_list_init(S_TIMER_WHEEL_NODE_T* const p_head)
+{
+    p_head->p_prev = p_head;
+    p_head->p_next = p_head;
+}
+
+static void _timer_wheel_list_add_tail(S_TIMER_WHEEL_NODE_T* const p_head, S_TIMER_WHEEL_NODE_T* const p_node)
+{
+    p_node->p_prev = p_head->p_prev;
+    p_node->p_next = p_head;
+    p_head->p_prev->p_next = p_node;
+    p_head->p_prev = p_node;
+}
+
+static void _timer_wheel_list_del(S_TIMER_WHEEL_NODE_T* const p_node)
+{
+    p_node->p_prev->p_next = p_node->p_next;
+    p_node->p_next->p_prev = p_node->p_prev;
+    p_node->p_prev = NULL;
+    p_node->p_next = NULL;
+}
+
+/**
+ * @brief   Move all nodes of a list to an empty one, the source is left empty
+ */
+static void _timer_wheel_list_splice(S_TIMER_WHEEL_NODE_T* const p_from, S_TIMER_WHEEL_NODE_T* const p_to)
+{
+    if (p_from->p_next == p_from)
+    {
+        _timer_wheel_list_init(p_to);
+        return;
+    }
+
+    p_to->p_next = p_from->p_next;
+    p_to->p_prev = p_from->p_prev;
+    p_to->p_next->p_prev = p_to;
+    p_to->p_prev->p_next = p_to;
+    _timer_wheel_list_init(p_from);
+}
+
+/**
+ * @brief   Put a timer in the slot of its expiry, in the lowest level whose range covers it
+ *          A timer already due goes to the slot being processed
+ */
+static void _timer_wheel_insert(S_TIMER_WHEEL_T* const p_wheel, S_TIMER_WHEEL_TIMER_T* const p_timer)
+{
+    uint32_t delta = p_timer->expire - p_wheel->now;
+    uint32_t expire = p_timer->expire;
+    uint32_t level = 0;
+
+    if (0 != (delta & 0x80000000UL) )
+    {
+        expire = p_wheel->now;
+        delta = 0;
+    }
+
+    while (level < (D_TIMER_WHEEL_LEVEL_NUM - 1) && (1UL << ( (level + 1) * D_TIMER_WHEEL_SLOT_BITS) ) <= delta)
+    {
+        level++;
+    }
+
+    _timer_wheel_list_add_tail(&p_wheel->slot[level][D_TIMER_WHEEL_INDEX(expire, level)], &p_timer->node);
+}
+
+/**
+ * @brief   Move the timers of the current slot of a level down to lower levels
+ */
+static void _timer_wheel_cascade(S_TIMER_WHEEL_T* const p_wheel, const uint32_t level)
+{
+    S_TIMER_WHEEL_NODE_T list;
+
+    _timer_wheel_list_splice(&p_wheel->slot[level][D_TIMER_WHEEL_INDEX(p_wheel->now, level)], &list);
+
+    while (list.p_next != &list)
+    {
+        S_TIMER_WHEEL_TIMER_T* p_timer = (S_TIMER_WHEEL_TIMER_T*)list.p_next;
+        _timer_wheel_list_del(&p_timer->node);
+        _timer_wheel_insert(p_wheel, p_timer);
+    }
+}
+
+/**
+ * @brief   Process the tick p_wheel->now: cascade upper levels on their boundaries, then expire level 0
+ */
+static void _timer_wheel_tick_process(S_TIMER_WHEEL_T* const p_wheel)
+{
+    for (uint32_t level = 1; level < D_TIMER_WHEEL_LEVEL_NUM; level++)
+    {
+        if (0 != D_TIMER_WHEEL_INDEX(p_wheel->now, level - 1) )
+        {
+            break;
+        }
+
+        _timer_wheel_cascade(p_wheel, level);
+    }
+
+    /* Callbacks may start or stop any timer, including the ones left in this list */
+    S_TIMER_WHEEL_NODE_T list;
+    _timer_wheel_list_splice(&p_wheel->slot[0][D_TIMER_WHEEL_INDEX(p_wheel->now, 0)], &list);
+
+    while (list.p_next != &list)
+    {
+        S_TIMER_WHEEL_TIMER_T* p_timer = (S_TIMER_WHEEL_TIMER_T*)list.p_next;
+        _timer_wheel_list_del(&p_timer->node);
+        p_wheel->timer_num--;
+        p_timer->pf_callback(p_timer->p_arg);
+    }
+}
@@ -0,0 +1,196 @@
+/*==============================================================================
+ * Host benchmark of the timer wheel against a sorted list
+ *
+ * Both keep N periodic timers armed with random timeouts, each expiry re-arms
+ * its timer, and every expiry is checked against the tick it was due at.
+ *
+ * Build and run on host:
+ *   gcc -O2 -std=gnu11 -I../inc ../src/timer_wheel.c timer_wheel_bench.c -o timer_wheel_bench
+ *   ./timer_wheel_bench [timer number] [ticks]
+ *============================================================================*/
+
+#include "timer_wheel.h"
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "time.h"
+
+
+/*==============================================================================
+ * Macro
+ *============================================================================*/
+
+#define D_TIMER_WHEEL_BENCH_TIMER_NUM           (10000)
+#define D_TIMER_WHEEL_BENCH_TICKS               (200000)
+/* Timeouts of 1 ms up to 60 s with 1 ms ticks, like retransmits, LED steps and watchdogs */
+#define D_TIMER_WHEEL_BENCH_TIMEOUT_MAX         (60000)
+
+
+/*==============================================================================
+ * Struct
+ *============================================================================*/
+
+typedef struct S_TIMER_WHEEL_BENCH_LIST_TIMER
+{
+    struct S_TIMER_WHEEL_BENCH_LIST_TIMER* p_next;
+    uint32_t expire;
+} S_TIMER_WHEEL_BENCH_LIST_TIMER_T;
+
+typedef struct
+{
+    S_TIMER_WHEEL_TIMER_T   timer;
+    uint32_t                expire;
+} S_TIMER_WHEEL_BENCH_WHEEL_TIMER_T;
+
+
+/*==============================================================================
+ * Global Variable
+ *============================================================================*/
+
+static S_TIMER_WHEEL_T gs_bench_wheel;
+static uint32_t gs_bench_now = 0;
+static uint32_t gs_bench_seed = 1;
+static uint64_t gs_bench_fired = 0;
+static uint64_t gs_bench_late = 0;
+
+
+/*==============================================================================
+ * Private Function Implementation
+ *============================================================================*/
+
+static uint32_t _bench_timeout_get(void)
+{
+    /* xorshift32, the same sequence for both runs */
+    gs_bench_seed ^= gs_bench_seed << 13;
+    gs_bench_seed ^= gs_bench_seed >> 17;
+    gs_bench_seed ^= gs_bench_seed << 5;
+    return 1 + gs_bench_seed % D_TIMER_WHEEL_BENCH_TIMEOUT_MAX;
+}
+
+static double _bench_seconds_get(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void _bench_wheel_callback(void* const p_arg)
+{
+    S_TIMER_WHEEL_BENCH_WHEEL_TIMER_T* p_timer = (S_TIMER_WHEEL_BENCH_WHEEL_TIMER_T*)p_arg;
+
+    gs_bench_fired++;
+    if (p_timer->expire != gs_bench_now)
+    {
+        gs_bench_late++;
+    }
+
+    uint32_t timeout = _bench_timeout_get();
+    p_timer->expire = gs_bench_now + timeout;
+    timer_wheel_timer_start(&gs_bench_wheel, &p_timer->timer, timeout);
+}
+
+static void _bench_list_insert(S_TIMER_WHEEL_BENCH_LIST_TIMER_T** pp_head, S_TIMER_WHEEL_BENCH_LIST_TIMER_T* p_timer)
+{
+    while (NULL != *pp_head && (int32_t)( (*pp_head)->expire - p_timer->expire) <= 0)
+    {
+        pp_head = &(*pp_head)->p_next;
+    }
+
+    p_timer->p_next = *pp_head;
+    *pp_head = p_timer;
+}
+
+static double _bench_list_run(uint32_t timer_num, uint32_t ticks)
+{
+    S_TIMER_WHEEL_BENCH_LIST_TIMER_T* p_timers = calloc(timer_num, sizeof(S_TIMER_WHEEL_BENCH_LIST_TIMER_T) );
+    S_TIMER_WHEEL_BENCH_LIST_TIMER_T* p_head = NULL;
+
+    gs_bench_seed = 1;
+    gs_bench_now = 0;
+    gs_bench_fired = 0;
+    gs_bench_late = 0;
+
+    double start = _bench_seconds_get();
+
+    for (uint32_t i = 0; i < timer_num; i++)
+    {
+        p_timers[i].expire = _bench_timeout_get();
+        _bench_list_insert(&p_head, &p_timers[i]);
+    }
+
+    for (gs_bench_now = 1; gs_bench_now <= ticks; gs_bench_now++)
+    {
+        while (NULL != p_head && p_head->expire == gs_bench_now)
+        {
+            S_TIMER_WHEEL_BENCH_LIST_TIMER_T* p_timer = p_head;
+            p_head = p_timer->p_next;
+            gs_bench_fired++;
+            p_timer->expire = gs_bench_now + _bench_timeout_get();
+            _bench_list_insert(&p_head, p_timer);
+        }
+    }
+
+    double seconds = _bench_seconds_get() - start;
+    free(p_timers);
+    return seconds;
+}
+
+static double _bench_wheel_run(uint32_t timer_num, uint32_t ticks)
+{
+    S_TIMER_WHEEL_BENCH_WHEEL_TIMER_T* p_timers = calloc(timer_num, sizeof(S_TIMER_WHEEL_BENCH_WHEEL_TIMER_T) );
+
+    gs_bench_seed = 1;
+    gs_bench_now = 0;
+    gs_bench_fired = 0;
+    gs_bench_late = 0;
+
+    double start = _bench_seconds_get();
+
+    timer_wheel_init(&gs_bench_wheel, 0);
+    for (uint32_t i = 0; i < timer_num; i++)
+    {
+        uint32_t timeout = _bench_timeout_get();
+        p_timers[i].expire = timeout;
+        timer_wheel_timer_init(&p_timers[i].timer, _bench_wheel_callback, &p_timers[i]);
+        timer_wheel_timer_start(&gs_bench_wheel, &p_timers[i].timer, timeout);
+    }
+
+    for (gs_bench_now = 1; gs_bench_now <= ticks; gs_bench_now++)
+    {
+        timer_wheel_advance(&gs_bench_wheel, gs_bench_now);
+    }
+
+    double seconds = _bench_seconds_get() - start;
+    free(p_timers);
+    return seconds;
+}
+
+
+/*==============================================================================
+ * Main
+ *============================================================================*/
+
+int main(int argc, char* argv[])
+{
+    uint32_t timer_num = (1 < argc) ? (uint32_t)strtoul(argv[1], NULL, 0) : D_TIMER_WHEEL_BENCH_TIMER_NUM;
+    uint32_t ticks = (2 < argc) ? (uint32_t)strtoul(argv[2], NULL, 0) : D_TIMER_WHEEL_BENCH_TICKS;
+
+    double list_seconds = _bench_list_run(timer_num, ticks);
+    uint64_t list_fired = gs_bench_fired;
+
+    double wheel_seconds = _bench_wheel_run(timer_num, ticks);
+    uint64_t wheel_fired = gs_bench_fired;
+
+    printf("%lu timers, %lu ticks, %llu expiries\n", (unsigned long)timer_num, (unsigned long)ticks, (unsigned long long)wheel_fired);
+    printf("sorted list: %8.3f s, %7.1f ns per tick\n", list_seconds, list_seconds * 1e9 / ticks);
+    printf("timer wheel: %8.3f s, %7.1f ns per tick\n", wheel_seconds, wheel_seconds * 1e9 / ticks);
+
+    if (list_fired != wheel_fired || 0 != gs_bench_late)
+    {
+        printf("MISMATCH: list %llu expiries, wheel %llu expiries, %llu not on their tick\n",
+               (unsigned long long)list_fired, (unsigned long long)wheel_fired, (unsigned long long)gs_bench_late);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+#ifndef __TRACER_H__
+#define __TRACER_H__
+
+
+/*==============================================================================
+ * Include
+ *============================================================================*/
+
+#include "stdbool.h"
+#include "stdint.h"
+
+
+/*==============================================================================
+ * Macro
+ *============================================================================*/
+
+/* Events kept in the RAM ring, 8 bytes each, the oldest are overwritten */
+#ifndef D_TRACER_EVENT_NUM
+#define D_TRACER_EVENT_NUM                      (512)
+#endif
+
+/* Tasks whose names are kept for the dump, indexed by FreeRTOS task number */
+#define D_TRACER_TASK_MAX_NUM                   (16)
+#define D_TRACER_TASK_NAME_SIZE                 (16)
+
+
+/*==============================================================================
+ * Enumeration
+ *============================================================================*/
+
+typedef enum
+{
+    E_TRACER_RET_STATUS_OK = 0,
+    E_TRACER_RET_STATUS_INPUT_PARAM_ERROR,
+    E_TRACER_RET_STATUS_INIT_STATUS_ERROR,
+} E_TRACER_RET_STATUS_T;
+
+typedef enum
+{
+    E_TRACER_INIT_STATUS_NO = 0,
+    E_TRACER_INIT_STATUS_OK,
+} E_TRACER_INIT_STATUS_T;
+
+/* Instrumented interrupt handlers, names are in tracer.c, mapped from mcu_core ISR IDs in tracer_port.c */
+typedef enum
+{
+    E_TRACER_ISR_ID_USART1 = 0,
+    E_TRACER_ISR_ID_UART_TX_DMA,
+    E_TRACER_ISR_ID_UART_RX_DMA,
+    E_TRACER_ISR_ID_NUM_MAX,
+} E_TRACER_ISR_ID_T;
+
+/* Instrumented code spans, names are in tracer.c */
+typedef enum
+{
+    E_TRACER_SPAN_ID_LED_DISP_PTN_PROCESS = 0,
+    E_TRACER_SPAN_ID_NUM_MAX,
+} E_TRACER_SPAN_ID_T;
+
+
+/*==============================================================================
+ * Type
+ *============================================================================*/
+
+typedef void (*PF_TRACER_OUTPUT_T)(const char* const, const uint32_t);
+
+
+/*==============================================================================
+ * Public Function Declaration
+ *============================================================================*/
+
+extern E_TRACER_RET_STATUS_T tracer_init(void);
+extern void tracer_enable_set(const bool);
+extern bool tracer_enable_get(void);
+extern void tracer_task_create(const uint32_t, const char* const);
+extern void tracer_task_switched_in(const uint32_t);
+extern void tracer_isr_enter(const E_TRACER_ISR_ID_T);
+extern void tracer_isr_exit(const E_TRACER_ISR_ID_T);
+extern void tracer_span_begin(const E_TRACER_SPAN_ID_T);
+extern void tracer_span_end(const E_TRACER_SPAN_ID_T);
+extern E_TRACER_RET_STATUS_T tracer_dump(const PF_TRACER_OUTPUT_T);
+
+#endif /* __TRACER_H__ */
@@ -0,0 +1,12 @@
+#ifndef __TRACER_PORT_H__
+#define __TRACER_PORT_H__
+
+
+#include "stdint.h"
+
+
+extern void tracer_port_init(void);
+extern uint32_t tracer_port_cycles_get(void);
+extern uint32_t tracer_port_cycles_freq_get(void);
+
+#endif /* __TRACER_PORT_H__ */
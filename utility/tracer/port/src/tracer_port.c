@@ -0,0 +1,91 @@
+#include "tracer_port.h"
+#include "tracer.h"
+
+#include "mcu_core.h"
+#include "mcu_time.h"
+
+
+/*==============================================================================
+ * Private Variable
+ *============================================================================*/
+
+/* Tracer ISR ID of each mcu_core ISR ID */
+static const E_TRACER_ISR_ID_T gs_tracer_port_isr_id[E_MCU_CORE_ISR_ID_NUM_MAX] = {
+    [E_MCU_CORE_ISR_ID_USART1]       = E_TRACER_ISR_ID_USART1,
+    [E_MCU_CORE_ISR_ID_UART_TX_DMA]  = E_TRACER_ISR_ID_UART_TX_DMA,
+    [E_MCU_CORE_ISR_ID_UART_RX_DMA]  = E_TRACER_ISR_ID_UART_RX_DMA,
+};
+
+
+/*==============================================================================
+ * Public Function Implementation
+ *============================================================================*/
+
+/**
+ * @brief   Start the cycle counter, mcu_time already runs it
+ */
+extern void tracer_port_init(void)
+{
+}
+
+/**
+ * @brief   Get the cycle counter, it wraps around
+ * @return  Cycles
+ */
+extern uint32_t tracer_port_cycles_get(void)
+{
+    return mcu_time_cycles_get();
+}
+
+/**
+ * @brief   Get the cycle counter frequency
+ * @return  Hz
+ */
+extern uint32_t tracer_port_cycles_freq_get(void)
+{
+    return mcu_time_cycles_freq_get();
+}
+
+/**
+ * @brief   Override of the weak mcu_core trace hook, ISR entry
+ *          Linked in with tracer.c, which calls the port functions above
+ * @param   isr_id mcu_core ISR ID
+ */
+extern void mcu_core_trace_isr_enter(const E_MCU_CORE_ISR_ID_T isr_id)
+{
+    if (E_MCU_CORE_ISR_ID_NUM_MAX > isr_id)
+    {
+        tracer_isr_enter(gs_tracer_port_isr_id[isr_id]);
+    }
+}
+
+/**
+ * @brief   Override of the weak mcu_core trace hook, ISR exit
+ * @param   isr_id mcu_core ISR ID
+ */
+extern void mcu_core_trace_isr_exit(const E_MCU_CORE_ISR_ID_T isr_id)
+{
+    if (E_MCU_CORE_ISR_ID_NUM_MAX > isr_id)
+    {
+        tracer_isr_exit(gs_tracer_port_isr_id[isr_id]);
+    }
+}
+
+/**
+ * @brief   Override of the weak mcu_core trace hook, FreeRTOS task creation
+ * @param   task_num FreeRTOS task number
+ * @param   p_name Task name
+ */
+extern void mcu_core_trace_task_create(const uint32_t task_num, const char* const p_name)
+{
+    tracer_task_create(task_num, p_name);
+}
+
+/**
+ * @brief   Override of the weak mcu_core trace hook, FreeRTOS task switch
+ * @param   task_num FreeRTOS task number
+ */
+extern void mcu_core_trace_task_switched_in(const uint32_t task_num)
+{
+    tracer_task_switched_in(task_num);
+}
@@ -0,0 +1,308 @@
+/*==============================================================================
+ * Include
+ *============================================================================*/
+
+#include "tracer.h"
+#include "tracer_port.h"
+
+#include "stddef.h"
+#include "stdio.h"
+#include "string.h"
+
+
+/*==============================================================================
+ * Macro
+ *============================================================================*/
+
+#define D_TRACER_EVENT_MASK                     (D_TRACER_EVENT_NUM - 1)
+
+/* Event info word: sequence (low 16 bits of the event index) | type << 16 | id << 20 */
+#define D_TRACER_INFO_SEQ_MASK                  (0xFFFFUL)
+#define D_TRACER_INFO_TYPE_SHIFT                (16)
+#define D_TRACER_INFO_ID_SHIFT                  (20)
+#define D_TRACER_INFO_ID_MAX                    (0xFFFUL)
+/* Flipping the top sequence bit marks a slot being written */
+#define D_TRACER_INFO_SEQ_BUSY                  (0x8000UL)
+
+#define D_TRACER_DUMP_LINE_SIZE                 (48)
+
+
+/*==============================================================================
+ * Enumeration
+ *============================================================================*/
+
+/* Values are part of the dump format, see tools/tracer_to_chrome.py */
+typedef enum
+{
+    E_TRACER_EVENT_TYPE_TASK_SWITCHED_IN = 0,
+    E_TRACER_EVENT_TYPE_ISR_ENTER,
+    E_TRACER_EVENT_TYPE_ISR_EXIT,
+    E_TRACER_EVENT_TYPE_SPAN_BEGIN,
+    E_TRACER_EVENT_TYPE_SPAN_END,
+} E_TRACER_EVENT_TYPE_T;
+
+
+/*==============================================================================
+ * Struct
+ *============================================================================*/
+
+typedef struct
+{
+    uint32_t cycles;
+    uint32_t info;
+} S_TRACER_EVENT_T;
+
+typedef struct
+{
+    E_TRACER_INIT_STATUS_T  is_inited;
+    volatile bool           is_enabled;
+    uint32_t                head;           /* Events recorded, ring index is head & D_TRACER_EVENT_MASK */
+    uint32_t                cur_task;
+    S_TRACER_EVENT_T        events[D_TRACER_EVENT_NUM];
+    char                    task_name[D_TRACER_TASK_MAX_NUM][D_TRACER_TASK_NAME_SIZE];
+} S_TRACER_T;
+
+_Static_assert(0 == (D_TRACER_EVENT_NUM & D_TRACER_EVENT_MASK), "D_TRACER_EVENT_NUM must be a power of two");
+_Static_assert(D_TRACER_EVENT_NUM <= D_TRACER_INFO_SEQ_BUSY, "D_TRACER_EVENT_NUM is too large for the sequence check");
+
+
+/*==============================================================================
+ * Global Variable
+ *============================================================================*/
+
+static S_TRACER_T gs_tracer = {0};
+
+static const char* const gs_tracer_isr_name[E_TRACER_ISR_ID_NUM_MAX] = {
+    [E_TRACER_ISR_ID_USART1]                = "USART1",
+    [E_TRACER_ISR_ID_UART_TX_DMA]           = "UART TX DMA",
+    [E_TRACER_ISR_ID_UART_RX_DMA]           = "UART RX DMA",
+};
+
+static const char* const gs_tracer_span_name[E_TRACER_SPAN_ID_NUM_MAX] = {
+    [E_TRACER_SPAN_ID_LED_DISP_PTN_PROCESS] = "led_disp_ptn_process",
+};
+
+
+/*==============================================================================
+ * Private Function Declaration
+ *============================================================================*/
+
+static void _tracer_event_record(const E_TRACER_EVENT_TYPE_T, const uint32_t);
+
+
+/*==============================================================================
+ * Public Function Implementation
+ *============================================================================*/
+
+/**
+ * @brief   Start the cycle counter and recording
+ *          Task names are kept from the start, so call it any time before the tasks of interest run
+ * @return  E_TRACER_RET_STATUS_T
+ */
+extern E_TRACER_RET_STATUS_T tracer_init(void)
+{
+    tracer_port_init();
+
+    gs_tracer.is_inited = E_TRACER_INIT_STATUS_OK;
+    gs_tracer.is_enabled = true;
+
+    return E_TRACER_RET_STATUS_OK;
+}
+
+/**
+ * @brief   Pause or resume recording, the ring keeps its content
+ * @param   is_enabled Recording enabled
+ */
+extern void tracer_enable_set(const bool is_enabled)
+{
+    if (E_TRACER_INIT_STATUS_OK != gs_tracer.is_inited)
+    {
+        return;
+    }
+
+    gs_tracer.is_enabled = is_enabled;
+}
+
+/**
+ * @brief   Get whether recording is enabled
+ * @return  true if recording
+ */
+extern bool tracer_enable_get(void)
+{
+    return (E_TRACER_INIT_STATUS_OK == gs_tracer.is_inited) && gs_tracer.is_enabled;
+}
+
+/**
+ * @brief   Keep the name of a created task, called by the mcu_core hook of traceTASK_CREATE
+ * @param   task_num FreeRTOS task number
+ * @param   p_name Task name
+ */
+extern void tracer_task_create(const uint32_t task_num, const char* const p_name)
+{
+    if (D_TRACER_TASK_MAX_NUM <= task_num || NULL == p_name)
+    {
+        return;
+    }
+
+    strncpy(gs_tracer.task_name[task_num], p_name, D_TRACER_TASK_NAME_SIZE - 1);
+}
+
+/**
+ * @brief   Record a task switch, called by the mcu_core hook of traceTASK_SWITCHED_IN with the scheduler locked
+ *          The scheduler also calls it when it keeps the same task, that is not recorded
+ * @param   task_num FreeRTOS task number
+ */
+extern void tracer_task_switched_in(const uint32_t task_num)
+{
+    if (task_num == gs_tracer.cur_task)
+    {
+        return;
+    }
+
+    gs_tracer.cur_task = task_num;
+    _tracer_event_record(E_TRACER_EVENT_TYPE_TASK_SWITCHED_IN, task_num);
+}
+
+/**
+ * @brief   Record the entry of an interrupt handler
+ * @param   isr_id ISR ID
+ */
+extern void tracer_isr_enter(const E_TRACER_ISR_ID_T isr_id)
+{
+    _tracer_event_record(E_TRACER_EVENT_TYPE_ISR_ENTER, isr_id);
+}
+
+/**
+ * @brief   Record the exit of an interrupt handler
+ * @param   isr_id ISR ID
+ */
+extern void tracer_isr_exit(const E_TRACER_ISR_ID_T isr_id)
+{
+    _tracer_event_record(E_TRACER_EVENT_TYPE_ISR_EXIT, isr_id);
+}
+
+/**
+ * @brief   Record the beginning of a span, it belongs to the task or ISR running it
+ * @param   span_id Span ID
+ */
+extern void tracer_span_begin(const E_TRACER_SPAN_ID_T span_id)
+{
+    _tracer_event_record(E_TRACER_EVENT_TYPE_SPAN_BEGIN, span_id);
+}
+
+/**
+ * @brief   Record the end of a span
+ * @param   span_id Span ID
+ */
+extern void tracer_span_end(const E_TRACER_SPAN_ID_T span_id)
+{
+    _tracer_event_record(E_TRACER_EVENT_TYPE_SPAN_END, span_id);
+}
+
+/**
+ * @brief   Output the ring as text lines, oldest first, tools/tracer_to_chrome.py converts it
+ *          Recording goes on meanwhile, events overwritten before being read are counted as lost
+ * @param   pf_output Output callback, may block
+ * @return  E_TRACER_RET_STATUS_T
+ */
+extern E_TRACER_RET_STATUS_T tracer_dump(const PF_TRACER_OUTPUT_T pf_output)
+{
+    /* Check input parameter */
+    if (NULL == pf_output)
+    {
+        return E_TRACER_RET_STATUS_INPUT_PARAM_ERROR;
+    }
+
+    if (E_TRACER_INIT_STATUS_OK != gs_tracer.is_inited)
+    {
+        return E_TRACER_RET_STATUS_INIT_STATUS_ERROR;
+    }
+
+    char line[D_TRACER_DUMP_LINE_SIZE];
+    int len = 0;
+    const uint32_t end = __atomic_load_n(&gs_tracer.head, __ATOMIC_ACQUIRE);
+    const uint32_t start = (D_TRACER_EVENT_NUM < end) ? (end - D_TRACER_EVENT_NUM) : 0;
+    uint32_t lost = 0;
+
+    /* Header: clock and names of the IDs used by events */
+    len = snprintf(line, sizeof(line), "#trace hz=%lu events=%lu\n",
+                   (unsigned long)tracer_port_cycles_freq_get(), (unsigned long)(end - start) );
+    pf_output(line, (uint32_t)len);
+
+    for (uint32_t i = 0; i < D_TRACER_TASK_MAX_NUM; i++)
+    {
+        if ('\0' != gs_tracer.task_name[i][0])
+        {
+            len = snprintf(line, sizeof(line), "#task %lu %s\n", (unsigned long)i, gs_tracer.task_name[i]);
+            pf_output(line, (uint32_t)len);
+        }
+    }
+
+    for (uint32_t i = 0; i < E_TRACER_ISR_ID_NUM_MAX; i++)
+    {
+        len = snprintf(line, sizeof(line), "#isr %lu %s\n", (unsigned long)i, gs_tracer_isr_name[i]);
+        pf_output(line, (uint32_t)len);
+    }
+
+    for (uint32_t i = 0; i < E_TRACER_SPAN_ID_NUM_MAX; i++)
+    {
+        len = snprintf(line, sizeof(line), "#span %lu %s\n", (unsigned long)i, gs_tracer_span_name[i]);
+        pf_output(line, (uint32_t)len);
+    }
+
+    /* Events: @<cycles><info> in hex */
+    for (uint32_t index = start; index != end; index++)
+    {
+        const S_TRACER_EVENT_T* p_event = &gs_tracer.events[index & D_TRACER_EVENT_MASK];
+        uint32_t info = __atomic_load_n(&p_event->info, __ATOMIC_ACQUIRE);
+        uint32_t cycles = __atomic_load_n(&p_event->cycles, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        /* Overwritten by a later lap, or being written right now */
+        if ( (index & D_TRACER_INFO_SEQ_MASK) != (info & D_TRACER_INFO_SEQ_MASK) ||
+             info != __atomic_load_n(&p_event->info, __ATOMIC_RELAXED) )
+        {
+            lost++;
+            continue;
+        }
+
+        len = snprintf(line, sizeof(line), "@%08lx%08lx\n", (unsigned long)cycles, (unsigned long)info);
+        pf_output(line, (uint32_t)len);
+    }
+
+    len = snprintf(line, sizeof(line), "#end lost=%lu\n", (unsigned long)lost);
+    pf_output(line, (uint32_t)len);
+
+    return E_TRACER_RET_STATUS_OK;
+}
+
+
+/*==============================================================================
+ * Private Function Implementation
+ *============================================================================*/
+
+/**
+ * @brief   Put an event in the ring, lock-free so tasks and interrupts of any priority can record
+ *          A slot is claimed by an atomic increment of head, its info word is written last
+ * @param   type Event type
+ * @param   id Task number, ISR ID or span ID
+ */
+static void _tracer_event_record(const E_TRACER_EVENT_TYPE_T type, const uint32_t id)
+{
+    if (false == gs_tracer.is_enabled)
+    {
+        return;
+    }
+
+    uint32_t cycles = tracer_port_cycles_get();
+    uint32_t index = __atomic_fetch_add(&gs_tracer.head, 1, __ATOMIC_RELAXED);
+    S_TRACER_EVENT_T* p_event = &gs_tracer.events[index & D_TRACER_EVENT_MASK];
+    uint32_t info = (index & D_TRACER_INFO_SEQ_MASK) |
+                    ( (uint32_t)type << D_TRACER_INFO_TYPE_SHIFT) |
+                    ( (id & D_TRACER_INFO_ID_MAX) << D_TRACER_INFO_ID_SHIFT);
+
+    __atomic_store_n(&p_event->info, info ^ D_TRACER_INFO_SEQ_BUSY, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&p_event->cycles, cycles, __ATOMIC_RELAXED);
+    __atomic_store_n(&p_event->info, info, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+"""
+Tracer dump to Chrome trace converter.
+
+Takes the output of the shell command trace (see tracer_dump() in
+tracer.c) from a serial capture, other text around it is ignored, and
+writes Chrome trace JSON for chrome://tracing or https://ui.perfetto.dev:
+
+  - one track per task with its running slices
+  - one track per ISR with its handler slices
+  - spans nested on the track of the task or ISR that ran them
+
+Usage:
+    tracer_to_chrome.py capture.txt trace.json
+"""
+
+import argparse
+import json
+import re
+import sys
+
+# Event types, same values as E_TRACER_EVENT_TYPE_T
+TASK_SWITCHED_IN = 0
+ISR_ENTER = 1
+ISR_EXIT = 2
+SPAN_BEGIN = 3
+SPAN_END = 4
+
+PID = 1
+# ISR tracks are kept apart from task numbers
+ISR_TID_BASE = 1000
+
+EVENT = re.compile(r"@([0-9a-fA-F]{8})([0-9a-fA-F]{8})")
+HEADER = re.compile(r"#trace hz=(\d+)")
+NAME = re.compile(r"#(task|isr|span) (\d+) (.*?)\s*$")
+
+
+def parse(lines):
+    """Return (hz, names, events) of the last dump in the capture, events as (cycles, type, id)."""
+    hz, names, events = None, None, None
+    for line in lines:
+        m = HEADER.search(line)
+        if m:
+            hz = int(m.group(1))
+            names = {"task": {}, "isr": {}, "span": {}}
+            events = []
+            continue
+        if events is None:
+            continue
+        m = NAME.search(line)
+        if m:
+            names[m.group(1)][int(m.group(2))] = m.group(3)
+            continue
+        m = EVENT.search(line)
+        if m:
+            info = int(m.group(2), 16)
+            events.append((int(m.group(1), 16), (info >> 16) & 0xF, info >> 20))
+    if events is None:
+        raise ValueError("no tracer dump found")
+    return hz, names, events
+
+
+def unwrap(events):
+    """Extend the 32 bit cycle counter, events recorded out of order by preemption stay close."""
+    out = []
+    total = None
+    prev = None
+    for cycles, type_, id_ in events:
+        if total is None:
+            total = 0
+        else:
+            delta = (cycles - prev) & 0xFFFFFFFF
+            total += delta - (1 << 32) if delta & 0x80000000 else delta
+        prev = cycles
+        out.append((total, type_, id_))
+    out.sort(key=lambda e: e[0])
+    return out
+
+
+def convert(hz, names, events):
+    us = 1e6 / hz
+    trace = []
+    task_names = names["task"]
+    isr_names = names["isr"]
+    span_names = names["span"]
+
+    def meta(tid, name, order):
+        trace.append({"ph": "M", "pid": PID, "tid": tid, "name": "thread_name", "args": {"name": name}})
+        trace.append({"ph": "M", "pid": PID, "tid": tid, "name": "thread_sort_index", "args": {"sort_index": order}})
+
+    trace.append({"ph": "M", "pid": PID, "name": "process_name", "args": {"name": "MCU"}})
+    seen = set()
+    running = None      # (task number, start)
+    isr_stack = []      # ISR IDs, nested handlers
+    for ts, type_, id_ in events:
+        t = ts * us
+        if type_ == TASK_SWITCHED_IN:
+            if running is not None:
+                task, start = running
+                trace.append({"ph": "X", "pid": PID, "tid": task, "ts": start, "dur": t - start,
+                              "name": task_names.get(task, "task %u" % task)})
+            running = (id_, t)
+            if id_ not in seen:
+                seen.add(id_)
+                meta(id_, task_names.get(id_, "task %u" % id_), id_)
+        elif type_ == ISR_ENTER:
+            tid = ISR_TID_BASE + id_
+            isr_stack.append(id_)
+            if tid not in seen:
+                seen.add(tid)
+                meta(tid, "ISR " + isr_names.get(id_, str(id_)), tid)
+            trace.append({"ph": "B", "pid": PID, "tid": tid, "ts": t, "name": isr_names.get(id_, "isr %u" % id_)})
+        elif type_ == ISR_EXIT:
+            if id_ in isr_stack:
+                isr_stack.remove(id_)
+                trace.append({"ph": "E", "pid": PID, "tid": ISR_TID_BASE + id_, "ts": t})
+        elif type_ in (SPAN_BEGIN, SPAN_END):
+            # A span belongs to the innermost running ISR, or else the running task
+            if isr_stack:
+                tid = ISR_TID_BASE + isr_stack[-1]
+            elif running is not None:
+                tid = running[0]
+            else:
+                continue
+            event = {"ph": "B" if type_ == SPAN_BEGIN else "E", "pid": PID, "tid": tid, "ts": t}
+            if type_ == SPAN_BEGIN:
+                event["name"] = span_names.get(id_, "span %u" % id_)
+            trace.append(event)
+    if running is not None and events:
+        task, start = running
+        trace.append({"ph": "X", "pid": PID, "tid": task, "ts": start, "dur": events[-1][0] * us - start,
+                      "name": task_names.get(task, "task %u" % task)})
+    return {"traceEvents": trace, "displayTimeUnit": "ns"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a tracer dump to Chrome trace JSON")
+    parser.add_argument("input", nargs="?", default="-", help="capture with the output of trace, default stdin")
+    parser.add_argument("output", nargs="?", default="-", help="JSON file, default stdout")
+    args = parser.parse_args()
+
+    with (sys.stdin if args.input == "-" else open(args.input, errors="replace")) as f:
+        hz, names, events = parse(f)
+    result = convert(hz, names, unwrap(events))
+    with (sys.stdout if args.output == "-" else open(args.output, "w")) as f:
+        json.dump(result, f)
+    sys.stderr.write("%u events\n" % len(events))
+
+
+if __name__ == "__main__":
+    main()